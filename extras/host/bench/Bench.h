@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+// Stops the benchmark with the failure exit code when the result is not expected.
+#define HOST_CHECK(cond)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+            exit(1);                                                            \
+        }                                                                       \
+    } while (0)
+
+// The wall clock time of the benchmark step.
+class BenchTimer
+{
+public:
+    BenchTimer() { start(); }
+
+    void start() { t0 = std::chrono::steady_clock::now(); }
+
+    double elapsedMs() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count(); }
+
+private:
+    std::chrono::steady_clock::time_point t0;
+};
+
+// The scale of the benchmark iterations, the quick run (used by ctest) is selected by the --quick argument.
+inline int benchScale(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+            return 1;
+    }
+    return 10;
+}
+
+inline void benchReport(const char *name, double ms, double count, const char *unit)
+{
+    printf("%-44s %10.2f ms %12.1f %s/s\n", name, ms, ms > 0 ? count * 1000.0 / ms : 0, unit);
+}
+
+// The HTTP response with the payload.
+inline String httpResponse(const String &payload, const char *type = "application/json", const char *extra = "")
+{
+    String res = "HTTP/1.1 200 OK\r\nContent-Type: ";
+    res += type;
+    res += "\r\nContent-Length: ";
+    res += String((unsigned int)payload.length());
+    res += "\r\nConnection: keep-alive\r\n";
+    res += extra;
+    res += "\r\n";
+    res += payload;
+    return res;
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The throughput of the streaming Base64 encoder and decoder compared with the per-character codec,
+// and the encoded and decoded output checked against the per-character codec.
+
+#include <FirebaseClient.h>
+#include <vector>
+#include "Bench.h"
+
+static const char ref_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// The per-character encoder which is the reference of the output.
+static std::string refEncode(const uint8_t *in, size_t len)
+{
+    std::string out;
+    uint32_t bits = 0;
+    int n = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        bits = bits << 8 | in[i];
+        n += 8;
+        while (n >= 6)
+        {
+            n -= 6;
+            out += ref_table[(bits >> n) & 0x3f];
+        }
+    }
+    if (n > 0)
+        out += ref_table[(bits << (6 - n)) & 0x3f];
+    while (out.size() % 4)
+        out += '=';
+    return out;
+}
+
+static std::string refDecode(const char *in, size_t len)
+{
+    std::string out;
+    uint32_t bits = 0;
+    int n = 0;
+    for (size_t i = 0; i < len && in[i] != '='; i++)
+    {
+        const char *p = strchr(ref_table, in[i]);
+        if (!p || !in[i])
+            continue;
+        bits = bits << 6 | (p - ref_table);
+        n += 6;
+        if (n >= 8)
+        {
+            n -= 8;
+            out += (char)((bits >> n) & 0xff);
+        }
+    }
+    return out;
+}
+
+static std::string encode(const uint8_t *in, size_t len, size_t chunk)
+{
+    base64_encoder enc;
+    enc.begin();
+    std::string out(base64_encoder::outputLength(len) + chunk, '\0');
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += chunk)
+        n += enc.update(in + i, len - i < chunk ? len - i : chunk, &out[n]);
+    n += enc.finish(&out[n]);
+    out.resize(n);
+    return out;
+}
+
+static std::string decode(const std::string &in, size_t chunk)
+{
+    base64_decoder dec;
+    dec.begin();
+    std::string out(base64_decoder::outputLength(in.size()) + chunk, '\0');
+    size_t n = 0;
+    for (size_t i = 0; i < in.size(); i += chunk)
+        n += dec.update(in.c_str() + i, in.size() - i < chunk ? in.size() - i : chunk, reinterpret_cast<uint8_t *>(&out[n]));
+    n += dec.finish(reinterpret_cast<uint8_t *>(&out[n]));
+    out.resize(n);
+    return out;
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    std::vector<uint8_t> data(1024 * 1024);
+    uint32_t seed = 1;
+    for (auto &b : data)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = seed >> 16;
+    }
+
+    // The output of all input lengths and chunk sizes matches the reference.
+    for (size_t len = 0; len <= 300; len++)
+    {
+        std::string ref = refEncode(data.data(), len);
+        for (size_t chunk : {1, 2, 3, 7, 64, 300})
+        {
+            HOST_CHECK(encode(data.data(), len, chunk) == ref);
+            std::string dec = decode(ref, chunk);
+            HOST_CHECK(dec.size() == len && memcmp(dec.data(), data.data(), len) == 0);
+        }
+    }
+
+    // The quotes and line breaks are skipped.
+    HOST_CHECK(decode("\"aGVs\r\nbG8=\"", 5) == "hello");
+
+    int n = 5 * scale;
+    double mb = (double)data.size() * n / (1024 * 1024);
+    std::string encoded = refEncode(data.data(), data.size());
+
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+        HOST_CHECK(encode(data.data(), data.size(), 4096).size() == encoded.size());
+    double encMs = t.elapsedMs();
+
+    t.start();
+    for (int i = 0; i < n; i++)
+        HOST_CHECK(refEncode(data.data(), data.size()).size() == encoded.size());
+    double refEncMs = t.elapsedMs();
+
+    t.start();
+    for (int i = 0; i < n; i++)
+        HOST_CHECK(decode(encoded, 4096).size() == data.size());
+    double decMs = t.elapsedMs();
+
+    t.start();
+    for (int i = 0; i < n; i++)
+        HOST_CHECK(refDecode(encoded.c_str(), encoded.size()).size() == data.size());
+    double refDecMs = t.elapsedMs();
+
+    printf("%d x 1 MB\n", n);
+    benchReport("  encode (streaming)", encMs, mb, "MB");
+    benchReport("  encode (per char)", refEncMs, mb, "MB");
+    benchReport("  decode (streaming)", decMs, mb, "MB");
+    benchReport("  decode (per char)", refDecMs, mb, "MB");
+    return 0;
+}
@@ -0,0 +1,313 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The delta OTA update of the firmware image in the fake flash partition.
+// The patch of the modified image is downloaded from RTDB (Base64) and Storage (raw bytes) as it is and gzip compressed,
+// the patched image is checked and the downloaded bytes are compared with the full image.
+// The failed flash write and the unsupported patch formats should abort the update.
+
+#define ENABLE_DATABASE
+#define ENABLE_STORAGE
+#define ENABLE_OTA
+#define ENABLE_DELTA_OTA
+#define ENABLE_GZIP
+
+#include "../mock/MockUpdater.h"
+
+MockUpdater Update;
+#define FIREBASE_OTA_UPDATER Update
+
+#include <FirebaseClient.h>
+#include <zlib.h>
+#include <unordered_map>
+#include <vector>
+#include "../mock/MockClient.h"
+#include "Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+Storage storage;
+NoAuth no_auth;
+
+static std::string running_image;
+
+static bool readImage(uint32_t offset, uint8_t *buf, size_t len)
+{
+    if (offset + len > running_image.size())
+        return false;
+    memcpy(buf, running_image.data() + offset, len);
+    return true;
+}
+
+static void offtout(int64_t x, std::string &out)
+{
+    uint64_t y = x < 0 ? -x : x;
+    for (int i = 0; i < 8; i++)
+    {
+        uint8_t b = y >> (i * 8);
+        if (i == 7 && x < 0)
+            b |= 0x80;
+        out += (char)b;
+    }
+}
+
+// The bsdiff patch (ENDSLEY/BSDIFF43 header and the uncompressed control, diff and extra data).
+// The matches are found from the index of 8-byte keys of the old image and extended while the bytes mostly match,
+// the result is a valid but less optimal patch than the bsdiff tool creates.
+static std::string makePatch(const std::string &old, const std::string &neu)
+{
+    struct segment_t
+    {
+        size_t pos, len, old_pos;
+    };
+
+    auto key = [](const char *p)
+    {
+        uint64_t k;
+        memcpy(&k, p, 8);
+        return k;
+    };
+
+    std::unordered_map<uint64_t, std::vector<uint32_t>> index;
+    for (size_t i = 0; i + 8 <= old.size(); i++)
+    {
+        auto &v = index[key(old.data() + i)];
+        if (v.size() < 4)
+            v.push_back(i);
+    }
+
+    std::vector<segment_t> segs;
+    size_t pos = 0, n = neu.size();
+    while (pos + 8 <= n)
+    {
+        size_t best = 0, best_old = 0;
+        auto it = index.find(key(neu.data() + pos));
+        if (it != index.end())
+        {
+            for (uint32_t o : it->second)
+            {
+                size_t l = 0;
+                while (pos + l < n && o + l < old.size() && neu[pos + l] == old[o + l])
+                    l++;
+                if (l > best)
+                {
+                    best = l;
+                    best_old = o;
+                }
+            }
+        }
+
+        if (best < 16)
+        {
+            pos++;
+            continue;
+        }
+
+        // The small changes e.g. the addresses are included in the diff data.
+        size_t end = pos + best, mismatch = 0;
+        for (size_t k = end; k < n && best_old + k - pos < old.size() && mismatch < 8; k++)
+        {
+            if (neu[k] == old[best_old + k - pos])
+            {
+                mismatch = 0;
+                end = k + 1;
+            }
+            else
+                mismatch++;
+        }
+        segs.push_back({pos, end - pos, best_old});
+        pos = end;
+    }
+
+    std::string patch = "ENDSLEY/BSDIFF43";
+    offtout(n, patch);
+
+    auto ctrl = [&](size_t diff_pos, size_t diff_len, size_t old_pos, size_t extra_end, int64_t seek)
+    {
+        size_t extra_pos = diff_pos + diff_len;
+        offtout(diff_len, patch);
+        offtout(extra_end - extra_pos, patch);
+        offtout(seek, patch);
+        for (size_t i = 0; i < diff_len; i++)
+            patch += (char)(neu[diff_pos + i] - old[old_pos + i]);
+        patch.append(neu, extra_pos, extra_end - extra_pos);
+    };
+
+    if (segs.empty() || segs[0].pos > 0)
+        ctrl(0, 0, 0, segs.empty() ? n : segs[0].pos, segs.empty() ? 0 : segs[0].old_pos);
+
+    for (size_t i = 0; i < segs.size(); i++)
+    {
+        bool last = i + 1 == segs.size();
+        size_t extra_end = last ? n : segs[i + 1].pos;
+        int64_t seek = last ? 0 : (int64_t)segs[i + 1].old_pos - (int64_t)(segs[i].old_pos + segs[i].len);
+        ctrl(segs[i].pos, segs[i].len, segs[i].old_pos, extra_end, seek);
+    }
+    return patch;
+}
+
+static std::string gzipCompress(const std::string &data)
+{
+    z_stream zs = {};
+    HOST_CHECK(deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16 /* gzip */, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::string out(deflateBound(&zs, data.size()), '\0');
+    zs.next_in = (Bytef *)data.data();
+    zs.avail_in = data.size();
+    zs.next_out = (Bytef *)&out[0];
+    zs.avail_out = out.size();
+    HOST_CHECK(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+// The firmware-like image, the code words with the repeated instruction patterns and the data tables.
+static std::string makeImage(size_t size)
+{
+    std::string img;
+    uint32_t seed = 7;
+    while (img.size() < size)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32_t r = seed >> 8;
+        if (r % 4 == 0)
+            img.append("\x2d\xe9\xf0\x41\x80\x46\x0e\x46", 8);
+        else
+            img.append(reinterpret_cast<const char *>(&r), 3);
+    }
+    img.resize(size);
+    return img;
+}
+
+// The new image: the addresses are shifted in the first half, the new code was inserted,
+// the part of code was removed and the data was appended.
+static std::string modifyImage(const std::string &old)
+{
+    std::string img = old;
+    for (size_t i = 64; i < img.size() / 2; i += 997)
+        img[i] = img[i] + 4;
+    std::string inserted = makeImage(2048);
+    for (auto &c : inserted)
+        c ^= 0x5a;
+    img.insert(img.size() * 2 / 5, inserted);
+    img.erase(img.size() * 7 / 10, 1024);
+    img += "firmware version 2.0.1";
+    return img;
+}
+
+// The RTDB response of the firmware that is stored as Base64 string.
+static String base64Response(const std::string &data)
+{
+    String json = "\"";
+    std::string enc(base64_encoder::outputLength(data.size()), '\0');
+    base64_encoder encoder;
+    encoder.begin();
+    size_t len = encoder.update(reinterpret_cast<const uint8_t *>(data.data()), data.size(), &enc[0]);
+    len += encoder.finish(&enc[len]);
+    json.concat(enc.data(), len);
+    json += "\"";
+    return httpResponse(json);
+}
+
+static String rawResponse(const std::string &data)
+{
+    String payload;
+    payload.concat(data.data(), data.size());
+    return httpResponse(payload, "application/octet-stream");
+}
+
+// The RTDB download of the firmware is the async task.
+static bool rtdbOTA(const std::string &data)
+{
+    Update.reset();
+    mock.addResponse(base64Response(data));
+    AsyncResult result;
+    Database.ota(aClient, "/firmware/bin", result);
+    while (aClient.taskCount())
+        app.loop();
+    return result.error().code() == 0;
+}
+
+static bool storageOTA(const std::string &data)
+{
+    Update.reset();
+    mock.addResponse(rawResponse(data));
+    return storage.ota(aClient, FirebaseStorage::Parent("host-bench.appspot.com", "firmware.bin"));
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    app.getApp<Storage>(storage);
+    Database.url("https://host-bench-default-rtdb.firebaseio.com");
+    while (!app.ready())
+        app.loop();
+
+    running_image = makeImage(scale > 1 ? 1024 * 1024 : 128 * 1024);
+    std::string image = modifyImage(running_image);
+    getDeltaOTA().setSourceReader(readImage, running_image.size());
+
+    BenchTimer t;
+    std::string patch = makePatch(running_image, image);
+    double diffMs = t.elapsedMs();
+    std::string gzPatch = gzipCompress(patch);
+
+    // The full image, the patch and the compressed patch.
+    const std::string *inputs[] = {&image, &patch, &gzPatch};
+    const char *names[] = {"  full image", "  patch", "  gzip patch"};
+    printf("running image %zu B, new image %zu B, patch created in %.1f ms\n", running_image.size(), image.size(), diffMs);
+    for (int i = 0; i < 3; i++)
+    {
+        t.start();
+        HOST_CHECK(rtdbOTA(*inputs[i]));
+        double ms = t.elapsedMs();
+        // The full image from Base64 string is padded with zeros to the decoded size.
+        HOST_CHECK(Update.applied && Update.flash.compare(0, image.size(), image) == 0);
+        HOST_CHECK(Update.flash.size() - image.size() < 3);
+        HOST_CHECK(!getDeltaOTA().isActive());
+
+        HOST_CHECK(storageOTA(*inputs[i]));
+        HOST_CHECK(Update.applied && Update.flash == image);
+
+        printf("%-16s %8zu B downloaded, %5.1f%% of the full image, %.1f ms\n", names[i], inputs[i]->size(),
+               100.0 * inputs[i]->size() / image.size(), ms);
+    }
+
+    // The flash write failure aborts the update and releases the delta OTA buffers.
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t aborts = Update.abortCount;
+        Update.reset();
+        Update.failAt = image.size() / 2;
+        mock.addResponse(rawResponse(*inputs[i]));
+        HOST_CHECK(!storage.ota(aClient, FirebaseStorage::Parent("host-bench.appspot.com", "firmware.bin")));
+        HOST_CHECK(aClient.lastError().code() == FIREBASE_ERROR_FW_UPDATE_WRITE_FAILED);
+        HOST_CHECK(!Update.running && !Update.applied && Update.abortCount == aborts + 1);
+        HOST_CHECK(!getDeltaOTA().isActive());
+    }
+
+    // The bsdiff tool output (bzip2 stream) and the BSDIFF40 patch are rejected without writing the flash.
+    std::string bz = patch.substr(0, 24) + "BZh91AY&SY" + std::string(64, '\x11');
+    std::string bsdiff40 = "BSDIFF40" + std::string(64, '\0');
+    for (const std::string *p : {&bz, &bsdiff40})
+    {
+        HOST_CHECK(!storageOTA(*p));
+        HOST_CHECK(aClient.lastError().code() == FIREBASE_ERROR_FW_UPDATE_UNSUPPORTED_PATCH);
+        HOST_CHECK(!Update.running && !Update.applied && Update.flash.empty());
+        HOST_CHECK(!rtdbOTA(*p));
+        HOST_CHECK(!getDeltaOTA().isActive());
+    }
+
+    // The update works again after the failures.
+    HOST_CHECK(rtdbOTA(gzPatch) && Update.applied && Update.flash == image);
+    HOST_CHECK(storageOTA(patch) && Update.applied && Update.flash == image);
+    return 0;
+}
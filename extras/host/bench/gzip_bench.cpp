@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The bytes on wire and the decoding time of the gzip compressed responses, the decoded data with the null
+// character and the response that fails the trailer CRC32 check.
+
+#define ENABLE_DATABASE
+#define ENABLE_GZIP
+
+#include <FirebaseClient.h>
+#include <zlib.h>
+#include "../mock/MockClient.h"
+#include "Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+NoAuth no_auth;
+
+static String gzipCompress(const String &data)
+{
+    z_stream zs = {};
+    HOST_CHECK(deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16 /* gzip */, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::string out(deflateBound(&zs, data.length()), '\0');
+    zs.next_in = (Bytef *)data.c_str();
+    zs.avail_in = data.length();
+    zs.next_out = (Bytef *)&out[0];
+    zs.avail_out = out.size();
+    HOST_CHECK(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return String(out);
+}
+
+// The JSON object of n records which is the typical RTDB or Firestore list response.
+static String makeJSON(int n)
+{
+    String json = "{";
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0)
+            json += ',';
+        json += "\"device_";
+        json += String(i);
+        json += "\":{\"temperature\":";
+        json += String(20 + i % 15);
+        json += ".5,\"humidity\":";
+        json += String(40 + i % 30);
+        json += ",\"status\":\"online\",\"updated\":\"2026-01-01T00:00:";
+        json += String(i % 60);
+        json += "Z\"}";
+    }
+    json += "}";
+    return json;
+}
+
+static double run(int n, const String &response, size_t expectedLen, uint64_t &wire)
+{
+    for (int i = 0; i < n; i++)
+        mock.addResponse(response);
+
+    uint64_t bytes = mock.bytesRead;
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+    {
+        String v = Database.get<String>(aClient, "/bench/devices");
+        HOST_CHECK(aClient.lastError().code() == 0);
+        HOST_CHECK(v.length() == expectedLen);
+    }
+    wire = (mock.bytesRead - bytes) / n;
+    return t.elapsedMs();
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    Database.url("https://host-bench-default-rtdb.firebaseio.com");
+    while (!app.ready())
+        app.loop();
+
+    for (int records : {10, 1000})
+    {
+        String json = makeJSON(records);
+        String gz = gzipCompress(json);
+        int n = (records > 100 ? 5 : 100) * scale;
+        uint64_t plainWire = 0, gzipWire = 0;
+
+        double plainMs = run(n, httpResponse(json), json.length(), plainWire);
+        double gzipMs = run(n, httpResponse(gz, "application/json", "Content-Encoding: gzip\r\n"), json.length(), gzipWire);
+
+        printf("%d records: payload %u B, on wire %llu B (plain) vs %llu B (gzip), %.1f%% saved\n", records, json.length(),
+               (unsigned long long)plainWire, (unsigned long long)gzipWire, 100.0 * (1.0 - (double)gzipWire / plainWire));
+        benchReport("  plain", plainMs, n, "req");
+        benchReport("  gzip", gzipMs, n, "req");
+        printf("  decode cost %.1f us per response\n", (gzipMs - plainMs) * 1000.0 / n);
+    }
+
+    // The decoded data that contains the null character is kept.
+    String nul("ab");
+    nul.concat("\0cd", 3);
+    mock.addResponse(httpResponse(gzipCompress(nul), "application/octet-stream", "Content-Encoding: gzip\r\n"));
+    AsyncResult result;
+    Database.get(aClient, "/bench/nul", result);
+    for (int i = 0; i < 100 && !result.available(); i++)
+        app.loop();
+    HOST_CHECK(result.payload().length() == 5);
+
+    // The data that does not match the CRC32 of the gzip trailer fails the task.
+    String bad = gzipCompress(makeJSON(10));
+    bad[bad.length() - 8] ^= 0x01;
+    mock.addResponse(httpResponse(bad, "application/json", "Content-Encoding: gzip\r\n"));
+    AsyncResult badResult;
+    Database.get(aClient, "/bench/crc", badResult);
+    for (int i = 0; i < 100 && aClient.taskCount(); i++)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == 0 && aClient.lastError().code() == FIREBASE_ERROR_GZIP_DECODING);
+
+    return 0;
+}
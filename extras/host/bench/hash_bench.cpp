@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The incremental MD5, SHA-256 and CRC32C digests of the download verification checked against
+// the digests from Python's hashlib (CRC32C from the bitwise reference), and their throughput.
+
+#include <FirebaseClient.h>
+#include <vector>
+#include "Bench.h"
+
+struct hash_vector_t
+{
+    size_t len;
+    const char *md5, *sha256, *crc32c;
+};
+
+// The digests of the first len bytes of the test data.
+static const hash_vector_t vectors[] = {
+    {0, "d41d8cd98f00b204e9800998ecf8427e", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "00000000"},
+    {1, "f664908b48b07e34c3472a6243f37cbf", "49994461d6b46390f014c8c5275a8591ef8764760afe2739cee23f6fbe285778", "b751927d"},
+    {3, "a531c2566f9b40f90e7f177fe0cbdd92", "97efedb40915efe5baf532f71b212340ce8b4459cd833ecdbe6d9bd4b779cc29", "c6885c81"},
+    {55, "33245e2f818db2997d0ff399206d2857", "48cab344faa43822576f85e6fcd6fb28568b116a195a0c2325d380a274ac550a", "ef97623b"},
+    {56, "dbfba04989de707c5d10eaabc09ed6c2", "351adbeea5fe581b009b5325e79324c388cce5db1e5c778b14fcc3daa481068a", "acc1955c"},
+    {63, "70130768387afda30b9d21007647374b", "da65329f4cc1b9deaba09a8a3c09957b5ab1ff5c692ad557921b362430ef4d4a", "7295638d"},
+    {64, "95b8013433c46680b8120921167ec17a", "a17eb65f63398a17ca56f962a00ebc8306dc2c7fc0bb07c39840fd71b6f8e72e", "79931fc0"},
+    {65, "73532b7ccf1cfc69947cbe61cd2bd54d", "a542d59d459e46ed567503aa8cc301d96ed922af7a49349c01f0f7e22fecd318", "dec1f1b7"},
+    {119, "8dc3c0d9f816a4838ff6307b7084aa08", "2dd0a848fc8c333d337b200d7e35bd8add0da86cb3792ef7eace11ba55cc0caf", "0afacf4c"},
+    {120, "aa2e7ed33e59340f7686f3099069d381", "45d05ea895c7b755c79084dba8f0f5ceb04cc7506c14446e415161808e244cab", "9cc7b140"},
+    {1000, "47c510acfd16944187e9c3ff94da4edf", "86feb6339f5ec6939cc9e488bad525b04f8f5d09ad32db431327077432051a09", "da5a8304"},
+    {4097, "8f2d1ecf31d854968684b015c1ad86bb", "71d1b776aad81c3e3f56dd23641e021d8c5247699ca29d8ec6d9c2ce16c98375", "f76c2aac"}};
+
+static uint32_t seed = 1;
+
+static uint32_t rnd()
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+// Feed the data in the random chunk sizes as the network reads.
+static bool check(firebase_hash_type type, const String &digest, const uint8_t *data, size_t len)
+{
+    hash_verifier h;
+    HOST_CHECK(h.begin(type, digest));
+    size_t i = 0;
+    while (i < len)
+    {
+        size_t n = rnd() % 200 + 1;
+        if (n > len - i)
+            n = len - i;
+        h.update(data + i, n);
+        i += n;
+    }
+    return h.verify();
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    std::vector<uint8_t> data(1024 * 1024);
+    for (auto &b : data)
+        b = rnd();
+    seed = 12345;
+
+    for (const hash_vector_t &v : vectors)
+    {
+        HOST_CHECK(check(hash_md5, v.md5, data.data(), v.len));
+        HOST_CHECK(check(hash_sha256, v.sha256, data.data(), v.len));
+        HOST_CHECK(check(hash_crc32c, v.crc32c, data.data(), v.len));
+    }
+
+    // The CRC32C check value, the Base64 digests of object metadata and the mismatch.
+    HOST_CHECK(check(hash_crc32c, "e3069283", reinterpret_cast<const uint8_t *>("123456789"), 9));
+    HOST_CHECK(check(hash_md5, "R8UQrP0WlEGH6cP/lNpO3w==", data.data(), 1000));
+    HOST_CHECK(check(hash_crc32c, "2lqDBA==", data.data(), 1000));
+    HOST_CHECK(!check(hash_md5, "R8UQrP0WlEGH6cP/lNpO3w==", data.data(), 999));
+    hash_verifier h;
+    HOST_CHECK(!h.begin(hash_sha256, "R8UQrP0WlEGH6cP/lNpO3w=="));
+
+    int n = 5 * scale;
+    double mb = (double)data.size() * n / (1024 * 1024);
+    for (firebase_hash_type type : {hash_md5, hash_sha256, hash_crc32c})
+    {
+        const char *name = type == hash_md5 ? "  md5" : type == hash_sha256 ? "  sha256" : "  crc32c";
+        BenchTimer t;
+        for (int i = 0; i < n; i++)
+        {
+            h.begin(type, type == hash_md5 ? vectors[0].md5 : type == hash_sha256 ? vectors[0].sha256 : vectors[0].crc32c);
+            for (size_t p = 0; p < data.size(); p += 1460)
+                h.update(data.data() + p, data.size() - p < 1460 ? data.size() - p : 1460);
+            HOST_CHECK(!h.verify());
+        }
+        benchReport(name, t.elapsedMs(), mb, "MB");
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The time of building the large Firestore document and array value with the JSON builders
+// compared with the previous ObjectWriter::addMember that copied the whole buffer on every member.
+
+#define ENABLE_FIRESTORE
+
+#include <FirebaseClient.h>
+#include "Bench.h"
+
+// The previous implementation, the buffer is copied through substring and the temporary.
+static void copyAddMember(String &buf, const String &v, bool isString, const String &token = "}}")
+{
+    int p = buf.lastIndexOf(token);
+    String str = buf.substring(0, p < 0 ? buf.length() : p);
+    str += ',';
+    if (token[0] == '}')
+        str += v.substring(1, v.length() - 1);
+    else
+    {
+        if (isString)
+            str += '"';
+        str += v;
+        if (isString)
+            str += '"';
+    }
+    str += token;
+    buf = str;
+}
+
+static String fieldName(int i)
+{
+    String key = "field_";
+    key += String(i);
+    return key;
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+    int n = 300 * scale;
+
+    // The member is appended when the closing token was not found.
+    ObjectWriter owriter;
+    String buf = "{\"a\":1}";
+    owriter.addMember(buf, "{\"b\":2}", false);
+    HOST_CHECK(buf == "{\"a\":1},\"b\":2}}");
+
+    BenchTimer t;
+    Document<Values::Value> doc("field_0", Values::Value(Values::IntegerValue(0)));
+    for (int i = 1; i < n; i++)
+        doc.add(fieldName(i), Values::Value(Values::IntegerValue(i)));
+    String docJson = doc.c_str();
+    double docMs = t.elapsedMs();
+
+    t.start();
+    Values::ArrayValue arr(Values::IntegerValue(0));
+    for (int i = 1; i < n; i++)
+        arr.add(Values::IntegerValue(i));
+    String arrJson = arr.c_str();
+    double arrMs = t.elapsedMs();
+
+    // The same document and array with the previous member appending.
+    t.start();
+    String prevDoc;
+    owriter.setPair(prevDoc, "fields", Values::MAP("field_0", Values::Value(Values::IntegerValue(0)), true).c_str());
+    for (int i = 1; i < n; i++)
+        copyAddMember(prevDoc, Values::MAP(fieldName(i), Values::Value(Values::IntegerValue(i)), true).c_str(), false);
+    double prevDocMs = t.elapsedMs();
+
+    t.start();
+    Values::ArrayValue first(Values::IntegerValue(0));
+    String prevArr = first.c_str();
+    for (int i = 1; i < n; i++)
+    {
+        Values::IntegerValue v(i);
+        copyAddMember(prevArr, v.val(), false, "]}");
+    }
+    double prevArrMs = t.elapsedMs();
+
+    HOST_CHECK(docJson == prevDoc);
+    HOST_CHECK(arrJson == prevArr);
+
+    printf("%d fields, document %u B, array %u B\n", n, docJson.length(), arrJson.length());
+    benchReport("  document (in place)", docMs, n, "field");
+    benchReport("  document (copy per member)", prevDocMs, n, "field");
+    benchReport("  array (in place)", arrMs, n, "elem");
+    benchReport("  array (copy per member)", prevArrMs, n, "elem");
+    return 0;
+}
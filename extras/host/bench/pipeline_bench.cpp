@@ -0,0 +1,399 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The request/response pipeline of AsyncClientClass and RealtimeDatabase over the in-memory Client.
+
+#define ENABLE_DATABASE
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+NoAuth no_auth;
+
+static uint32_t events = 0, put_events = 0;
+
+static void streamCallback(AsyncResult &aResult)
+{
+    if (aResult.available())
+    {
+        events++;
+        if (aResult.to<RealtimeDatabaseResult>().event() == "put")
+            put_events++;
+    }
+}
+
+static size_t sink_bytes = 0, sink_max_chunk = 0;
+static int sink_finals = 0;
+
+static void payloadSink(AsyncResult &aResult, const uint8_t *data, size_t len, bool final)
+{
+    sink_bytes += len;
+    if (len > sink_max_chunk)
+        sink_max_chunk = len;
+    if (final)
+        sink_finals++;
+}
+
+// The response payload that is passed to the payload sink of the async result.
+static void benchSink(int n, size_t payloadSize)
+{
+    String value;
+    while (value.length() < payloadSize)
+        value += "0123456789abcdef";
+
+    mock.setSegmentSize(1460);
+    for (int i = 0; i < n; i++)
+        mock.addResponse(httpResponse(value, "application/octet-stream"));
+
+    AsyncResult result;
+    result.setPayloadSink(payloadSink);
+    sink_bytes = 0;
+    sink_finals = 0;
+
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+    {
+        Database.get(aClient, "/bench/sink", result);
+        for (int j = 0; j < 10000 && sink_finals == i; j++)
+            app.loop();
+    }
+    double ms = t.elapsedMs();
+
+    HOST_CHECK(sink_finals == n);
+    HOST_CHECK(sink_bytes == (size_t)n * value.length());
+    HOST_CHECK(result.payload().length() == 0);
+    benchReport("async get to payload sink (100 KB)", ms, n, "req");
+    printf("  largest sink chunk %u B\n", (unsigned)sink_max_chunk);
+
+    // The HTTP error response is kept in the async result and the sink gets the final call with no data.
+    mock.addResponse("HTTP/1.1 404 Not Found\r\nContent-Type: application/json\r\nContent-Length: 21\r\n\r\n{\"error\":\"not found\"}");
+    sink_bytes = 0;
+    sink_finals = 0;
+    Database.get(aClient, "/bench/missing", result);
+    for (int j = 0; j < 10000 && sink_finals == 0; j++)
+        app.loop();
+    HOST_CHECK(sink_finals == 1 && sink_bytes == 0);
+    HOST_CHECK(result.isError() && result.error().code() == 404);
+}
+
+// The byte by byte read of readResponse() before the block read (one source->read() and available() call per byte),
+// kept as the baseline of benchRead().
+static int byteRead(Client *source, res_handler::ResponseContext &respCtx)
+{
+    char *buffer = (char *)respCtx.buf;
+    const char endToken = respCtx.stage == res_handler::response_stage_payload ? 0 : respCtx.endToken;
+    size_t pos = 0;
+    int c;
+
+    unsigned long ms_start = millis();
+    unsigned long timeout = 5000;
+
+    if (!respCtx.isChunked)
+    {
+        respCtx.stateChunkSizeRead = false;
+        respCtx.tempSize = 0;
+    }
+
+    if (!source->connected() && source->available() == 0 && respCtx.totalRead == 0)
+        return -1;
+
+    while ((source->connected() || source->available()) && (millis() - ms_start < timeout))
+    {
+        if (!respCtx.isChunked && respCtx.bytesRemState == 0)
+        {
+            buffer[pos] = '\0';
+            return (int)pos;
+        }
+
+        if (!source->available())
+            continue;
+
+        c = source->read();
+        if (c == -1)
+            continue;
+
+        if (respCtx.stage == res_handler::response_stage_payload)
+        {
+            if (respCtx.isChunked)
+            {
+                if (respCtx.bytesRemState == 0)
+                {
+                    if (c == '\r')
+                        continue;
+
+                    if (c == '\n')
+                    {
+                        if (!respCtx.stateChunkSizeRead)
+                            continue;
+
+                        if (respCtx.tempSize == 0)
+                        {
+                            respCtx.chunkedEnd = true;
+                            while (source->available() && (source->peek() == '\r' || source->peek() == '\n'))
+                                source->read();
+                            return (int)pos;
+                        }
+
+                        respCtx.bytesRemState = respCtx.tempSize;
+                        respCtx.tempSize = 0;
+                        respCtx.stateChunkSizeRead = false;
+                    }
+                    else
+                    {
+                        int val = -1;
+                        if (c >= '0' && c <= '9')
+                            val = c - '0';
+                        else if (c >= 'a' && c <= 'f')
+                            val = c - 'a' + 10;
+                        else if (c >= 'A' && c <= 'F')
+                            val = c - 'A' + 10;
+
+                        if (val >= 0)
+                        {
+                            respCtx.tempSize = (respCtx.tempSize * 16) + val;
+                            respCtx.stateChunkSizeRead = true;
+                        }
+                    }
+                    ms_start = millis();
+                    continue;
+                }
+                respCtx.bytesRemState--;
+            }
+            else if (respCtx.bytesRemState > 0)
+                respCtx.bytesRemState--;
+        }
+
+        buffer[pos++] = (char)c;
+        respCtx.totalRead++;
+
+        if ((endToken != 0 && c == endToken) || pos >= respCtx.bufSize - 1 ||
+            (respCtx.stage == res_handler::response_stage_payload && ((source->available() == 0) || (!respCtx.isChunked && respCtx.bytesRemState == 0))))
+        {
+            buffer[pos] = '\0';
+            return (int)pos;
+        }
+
+        ms_start = millis();
+    }
+
+    return millis() - ms_start < timeout ? 0 : -2;
+}
+
+// Read the header lines and the payload of the response with the read function, returns the payload size.
+template <typename TSRC, typename TREAD>
+static size_t readAll(TSRC *source, bool chunked, size_t contentLength, TREAD read)
+{
+    res_handler::ResponseContext ctx;
+    ctx.begin();
+    ctx.stage = res_handler::response_stage_header;
+
+    int len;
+    while ((len = read(source, ctx)) >= 0)
+    {
+        if (len == 2 && ctx.buf[0] == '\r')
+            break;
+    }
+
+    ctx.stage = res_handler::response_stage_payload;
+    ctx.isChunked = chunked;
+    ctx.bytesRemState = chunked ? 0 : (long)contentLength;
+
+    size_t payload = 0;
+    while (!ctx.chunkedEnd && (chunked || payload < contentLength) && (len = read(source, ctx)) >= 0)
+        payload += len;
+    return payload;
+}
+
+// The payload read of the byte by byte loop and the block read over the same response.
+static void benchRead(int n, size_t payloadSize, bool chunked, const char *name)
+{
+    String data;
+    while (data.length() < payloadSize)
+        data += "0123456789abcdef";
+
+    String response = "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n";
+    if (chunked)
+    {
+        response += "Transfer-Encoding: chunked\r\n\r\n";
+        for (size_t i = 0; i < data.length(); i += 1024)
+        {
+            String chunk = data.substring(i, i + 1024);
+            char size[12];
+            snprintf(size, sizeof(size), "%x\r\n", (unsigned int)chunk.length());
+            response += size;
+            response += chunk;
+            response += "\r\n";
+        }
+        response += "0\r\n\r\n";
+    }
+    else
+        response = httpResponse(data, "application/octet-stream");
+
+    MockClient raw;
+    raw.setSegmentSize(1460);
+    raw.connect("host", 443);
+    tcp_reader reader;
+    reader.setClient(&raw);
+
+    double mb = (double)n * data.length() / (1024.0 * 1024.0);
+    String label;
+
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+    {
+        raw.push(response);
+        HOST_CHECK(readAll(&raw, chunked, data.length(), byteRead) == data.length());
+    }
+    label = name;
+    label += ", byte read";
+    benchReport(label.c_str(), t.elapsedMs(), mb, "MB");
+
+    t.start();
+    for (int i = 0; i < n; i++)
+    {
+        raw.push(response);
+        HOST_CHECK(readAll(&reader, chunked, data.length(), [](tcp_reader *source, res_handler::ResponseContext &ctx)
+                           { return res_handler::readResponse<tcp_reader, Client>(source, nullptr, ctx); }) == data.length());
+    }
+    label = name;
+    label += ", block read";
+    benchReport(label.c_str(), t.elapsedMs(), mb, "MB");
+}
+
+static void benchGet(int n, size_t payloadSize, size_t segment, const char *name)
+{
+    String value = "\"";
+    while (value.length() < payloadSize)
+        value += "0123456789abcdef";
+    value += "\"";
+
+    mock.setSegmentSize(segment);
+    for (int i = 0; i < n; i++)
+        mock.addResponse(httpResponse(value));
+
+    uint64_t bytes = mock.bytesRead;
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+    {
+        String v = Database.get<String>(aClient, "/bench/value");
+        HOST_CHECK(aClient.lastError().code() == 0);
+        HOST_CHECK(v.length() == value.length() - 2);
+    }
+    double ms = t.elapsedMs();
+    benchReport(name, ms, n, "req");
+    benchReport("  response bytes", ms, (double)(mock.bytesRead - bytes), "B");
+}
+
+static void benchStream(int n, size_t segment)
+{
+    String stream = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\n";
+    stream += "event: put\ndata: {\"path\":\"/\",\"data\":{\"a\":1}}\n\n";
+    for (int i = 0; i < n; i++)
+    {
+        stream += i % 2 ? "event: put\ndata: {\"path\":\"/a\",\"data\":" : "event: patch\ndata: {\"path\":\"/\",\"data\":{\"b\":";
+        stream += String(i);
+        stream += i % 2 ? "}\n\n" : "}}\n\n";
+    }
+
+    mock.setSegmentSize(segment);
+    mock.addResponse(stream);
+    events = 0;
+    put_events = 0;
+
+    BenchTimer t;
+    Database.get(aClient, "/bench/stream", streamCallback, true /* SSE mode */);
+    for (int i = 0; i < n * 4 && events < (uint32_t)n + 1; i++)
+        app.loop();
+    double ms = t.elapsedMs();
+
+    HOST_CHECK(events == (uint32_t)n + 1);
+    HOST_CHECK(put_events == (uint32_t)(n / 2) + 1);
+    benchReport("stream events", ms, events, "event");
+
+    aClient.stopAsync(true);
+    mock.stop();
+}
+
+static StreamMultiplexer *mux = nullptr;
+static uint32_t mux_a = 0, mux_b = 0, mux_c = 0;
+
+// The listener that removes itself.
+static void listenerB(AsyncResult &aResult)
+{
+    mux_b++;
+    mux->removeListener("/bench/mux/b");
+}
+
+static void listenerC(AsyncResult &aResult) { mux_c++; }
+
+// The listener that destroys the multiplexer.
+static void listenerA(AsyncResult &aResult)
+{
+    mux_a++;
+    delete mux;
+}
+
+// The listeners of the multiplexer that are removed and destroyed by their callbacks.
+static void testMux()
+{
+    String stream = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\n";
+    stream += "event: put\ndata: {\"path\":\"/\",\"data\":{\"a\":1,\"b\":2,\"c\":3}}\n\n";
+    stream += "event: patch\ndata: {\"path\":\"/\",\"data\":{\"c\":4}}\n\n";
+    stream += "event: put\ndata: {\"path\":\"/a\",\"data\":5}\n\n";
+    stream += "event: put\ndata: {\"path\":\"/c\",\"data\":6}\n\n";
+
+    // The Stream task that was stopped is removed in the loop.
+    for (int i = 0; i < 10 && aClient.taskCount(); i++)
+        app.loop();
+    mux = new StreamMultiplexer();
+    mux->addListener("/bench/mux/b", listenerB);
+    mux->addListener("/bench/mux/c", listenerC);
+    mux->addListener("/bench/mux/a", listenerA, "put"); // The first put event is the get event.
+
+    mock.addResponse(stream);
+    Database.get(aClient, *mux, streamCallback);
+    for (int i = 0; i < 100; i++)
+        app.loop();
+
+    // The listener after the removed listener receives the event, the events after the multiplexer
+    // was destroyed are not dispatched.
+    HOST_CHECK(mux_b == 1 && mux_c == 2 && mux_a == 1);
+
+    aClient.stopAsync(true);
+    mock.stop();
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    Database.url("https://host-bench-default-rtdb.firebaseio.com");
+
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    benchGet(200 * scale, 64, 1460, "sync get (64 B)");
+    benchGet(10 * scale, 100 * 1024, 1460, "sync get (100 KB)");
+    benchGet(10 * scale, 100 * 1024, 16384, "sync get (100 KB, 16 KB segments)");
+    HOST_CHECK(mock.connectCount == 1);
+
+    benchRead(10 * scale, 100 * 1024, false, "response read (100 KB)");
+    benchRead(10 * scale, 100 * 1024, true, "response read (100 KB, chunked)");
+
+    benchSink(10 * scale, 100 * 1024);
+
+    benchStream(1000 * scale, 1460);
+    testMux();
+    return 0;
+}
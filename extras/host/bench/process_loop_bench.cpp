@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The process loop of the async client with 20 queued tasks over the in-memory Client.
+
+#define ENABLE_DATABASE
+#define FIREBASE_ASYNC_QUEUE_LIMIT 20 // The queue limit of ESP32.
+
+#include <FirebaseClient.h>
+#include <vector>
+#include "../mock/MockClient.h"
+#include "Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database1, Database2, Database3;
+NoAuth no_auth;
+
+static const int tasks = 20;
+AsyncResult results[tasks];
+
+// The lookup of the result address in the address list of the previous SlotManager (List::existed()).
+static bool addressExisted(const std::vector<uint32_t> &vec, uint32_t addr)
+{
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        if (vec[i] == addr)
+            return true;
+    }
+    return false;
+}
+
+// The per tick cost of the shared loop pass and the previous loop pass that processed the async client once for
+// each service that used it.
+static void benchTick(int n)
+{
+    // The loop stats of the shared loop pass.
+    for (int i = 0; i < 10; i++)
+        app.loop();
+    HOST_CHECK(app.loopStats().clients == 1);
+
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+        app.loop();
+    double ms = t.elapsedMs();
+    benchReport("loop tick, shared pass", ms, n, "tick");
+    printf("  %.3f us/tick\n", ms * 1000.0 / n);
+
+    // The service loops start their own pass, the shared client is processed by each of them as before.
+    t.start();
+    for (int i = 0; i < n; i++)
+    {
+        Database1.loop();
+        Database2.loop();
+        Database3.loop();
+    }
+    ms = t.elapsedMs();
+    benchReport("loop tick, pass per service", ms, n, "tick");
+    printf("  %.3f us/tick\n", ms * 1000.0 / n);
+
+    HOST_CHECK(aClient.taskCount() == tasks);
+}
+
+// The result lookup that is done for every slot in the process loop.
+static void benchLookup(int n)
+{
+    std::vector<uint32_t> addrs;
+    std::vector<firebase_handle_t> handles;
+    ObjectHandle owners[tasks];
+    for (int i = 0; i < tasks; i++)
+    {
+        addrs.push_back((uint32_t)reinterpret_cast<uintptr_t>(&results[i]));
+        handles.push_back(owners[i].get(&results[i], handle_type_result));
+    }
+
+    size_t found = 0;
+    BenchTimer t;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < tasks; j++)
+            found += addressExisted(addrs, (uint32_t)reinterpret_cast<uintptr_t>(&results[tasks - 1 - j]));
+    }
+    benchReport("result lookup, address list scan", t.elapsedMs(), (double)n * tasks, "lookup");
+    HOST_CHECK(found == (size_t)n * tasks);
+
+    found = 0;
+    t.start();
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < tasks; j++)
+            found += handleRegistry().get<AsyncResult>(handles[tasks - 1 - j], handle_type_result) != nullptr;
+    }
+    benchReport("result lookup, handle registry", t.elapsedMs(), (double)n * tasks, "lookup");
+    HOST_CHECK(found == (size_t)n * tasks);
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database1);
+    app.getApp<RealtimeDatabase>(Database2);
+    app.getApp<RealtimeDatabase>(Database3);
+    Database1.url("https://host-bench-default-rtdb.firebaseio.com");
+    Database2.url("https://host-bench-default-rtdb.firebaseio.com");
+    Database3.url("https://host-bench-default-rtdb.firebaseio.com");
+
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    // The async client is used by all services, the first request is waiting for the response
+    // that never comes and the other tasks are queued.
+    RealtimeDatabase *services[] = {&Database1, &Database2, &Database3};
+    for (int i = 0; i < tasks; i++)
+        services[i % 3]->get(aClient, "/bench/loop/" + String(i), results[i]);
+    HOST_CHECK(aClient.taskCount() == tasks);
+
+    benchTick(10000 * scale);
+    benchLookup(100000 * scale);
+
+    aClient.stopAsync(true);
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The RealtimeDatabase local cache that is kept in sync by the replayed Stream events of the devices data.
+// The cached values are checked against the data that the events were applied to, the get calls served from
+// the cache are compared with the get requests to the server, and the eviction and the destroyed database
+// while its Stream is running are checked.
+
+#define ENABLE_DATABASE
+
+#include <FirebaseClient.h>
+#include <map>
+#include <string>
+#include "../mock/MockClient.h"
+#include "Bench.h"
+
+MockClient mock, mock2, mock3;
+AsyncClientClass aClient(mock), aClient2(mock2), aClient3(mock3);
+FirebaseApp app;
+RealtimeDatabase Database, Database2;
+NoAuth no_auth;
+
+static const int devices = 50;
+static uint32_t events = 0, events3 = 0;
+
+// The device data that the events were applied to, the JSON text of the temp, hum and name values.
+struct device_t
+{
+    std::string temp, hum, name;
+};
+static device_t data[devices];
+
+static uint32_t seed = 1;
+
+static uint32_t rnd()
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+static void streamCallback(AsyncResult &aResult)
+{
+    if (aResult.available())
+        events++;
+}
+
+static void streamCallback3(AsyncResult &aResult)
+{
+    if (aResult.available())
+        events3++;
+}
+
+static std::string deviceJSON(const device_t &d)
+{
+    std::string s = "{\"temp\":" + d.temp + ",\"hum\":" + d.hum;
+    if (d.name.size())
+        s += ",\"name\":" + d.name;
+    return s + "}";
+}
+
+static std::string devicesJSON()
+{
+    std::string s = "{";
+    for (int i = 0; i < devices; i++)
+        s += (i ? ",\"d" : "\"d") + std::to_string(i) + "\":" + deviceJSON(data[i]);
+    return s + "}";
+}
+
+static String event(const char *type, const std::string &path, const std::string &value)
+{
+    String e = "event: ";
+    e += type;
+    e += "\ndata: {\"path\":\"";
+    e += path.c_str();
+    e += "\",\"data\":";
+    e += value.c_str();
+    e += "}\n\n";
+    return e;
+}
+
+static String streamResponse()
+{
+    for (int i = 0; i < devices; i++)
+        data[i] = {std::to_string(20 + i % 10), std::to_string(40 + i % 20), "\"dev-" + std::to_string(i) + "\""};
+    String stream = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\n";
+    return stream + event("put", "/", devicesJSON());
+}
+
+// The next event of the devices and its result in the device data.
+static String nextEvent()
+{
+    int i = rnd() % devices, kind = rnd() % 10;
+    std::string dev = "/d" + std::to_string(i), v = std::to_string(rnd() % 100);
+    device_t &d = data[i];
+    if (kind < 5)
+    {
+        d.temp = v;
+        return event("put", dev + "/temp", v);
+    }
+    if (kind < 8)
+    {
+        d.hum = v;
+        d.name = "\"n-" + v + "\"";
+        return event("patch", dev, "{\"hum\":" + d.hum + ",\"name\":" + d.name + "}");
+    }
+    if (kind < 9)
+    {
+        d.name.clear();
+        return event("put", dev + "/name", "null");
+    }
+    d = {v, v, "\"r-" + v + "\""};
+    return event("put", dev, deviceJSON(d));
+}
+
+// The get call, the server responds with the value when it was not served from the cache.
+static String cacheGet(RealtimeDatabase &db, AsyncClientClass &client, const std::string &path, MockClient *server = nullptr, const std::string &value = "")
+{
+    AsyncResult result;
+    uint32_t misses = db.cacheStats().misses;
+    db.get(client, path.c_str(), result);
+    if (server && db.cacheStats().misses != misses)
+    {
+        server->addResponse(httpResponse(value.c_str()));
+        for (int i = 0; i < 10000 && client.taskCount(); i++)
+            app.loop();
+    }
+    return result.c_str();
+}
+
+static void loopUntil(uint32_t &count, uint32_t n)
+{
+    for (int i = 0; i < 100000 && count < n; i++)
+        app.loop();
+    HOST_CHECK(count == n);
+}
+
+int main(int argc, char **argv)
+{
+    int scale = benchScale(argc, argv);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    app.getApp<RealtimeDatabase>(Database2);
+    Database.url("https://host-bench-default-rtdb.firebaseio.com");
+    Database2.url("https://host-bench-default-rtdb.firebaseio.com");
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    // The Stream events are applied to the cache.
+    Database.setLocalCache(true, 64 * 1024);
+    mock.addResponse(streamResponse());
+    Database.get(aClient, "/devices", streamCallback, true /* SSE mode */);
+    loopUntil(events, 1);
+
+    int n = 2000 * scale;
+    String replay;
+    for (int i = 0; i < n; i++)
+        replay += nextEvent();
+    mock.push(replay);
+
+    BenchTimer t;
+    loopUntil(events, n + 1);
+    double replayMs = t.elapsedMs();
+
+    // The cached values are the data that the events were applied to.
+    for (int i = 0; i < devices; i++)
+    {
+        std::string dev = "/devices/d" + std::to_string(i);
+        HOST_CHECK(cacheGet(Database, aClient, dev + "/temp") == data[i].temp.c_str());
+        HOST_CHECK(cacheGet(Database, aClient, dev + "/name") == (data[i].name.size() ? data[i].name.c_str() : "null"));
+        HOST_CHECK(cacheGet(Database, aClient, dev) == deviceJSON(data[i]).c_str());
+    }
+    HOST_CHECK(cacheGet(Database, aClient, "/devices") == devicesJSON().c_str());
+    HOST_CHECK(cacheGet(Database, aClient, "/devices/d0/missing") == "null");
+    HOST_CHECK(Database.cacheStats().misses == 0);
+
+    // The get calls served from the cache and the same get requests to the server.
+    int gets = 1000 * scale;
+    uint32_t hits = Database.cacheStats().hits;
+    t.start();
+    for (int i = 0; i < gets; i++)
+        HOST_CHECK(cacheGet(Database, aClient, "/devices/d" + std::to_string(i % devices)).length() > 0);
+    double cacheMs = t.elapsedMs();
+    HOST_CHECK(Database.cacheStats().hits == hits + gets);
+
+    for (int i = 0; i < gets; i++)
+        mock2.addResponse(httpResponse(deviceJSON(data[i % devices]).c_str()));
+    t.start();
+    for (int i = 0; i < gets; i++)
+        HOST_CHECK(Database2.get<String>(aClient2, ("/devices/d" + std::to_string(i % devices)).c_str()).length() > 0);
+    double serverMs = t.elapsedMs();
+
+    rtdb_cache_stats_t stats = Database.cacheStats();
+    printf("%d devices, %d events, cache %u B in %u nodes\n", devices, n, (unsigned)stats.size, (unsigned)stats.nodes);
+    benchReport("  replay events", replayMs, n, "event");
+    benchReport("  get (cache)", cacheMs, gets, "req");
+    benchReport("  get (server)", serverMs, gets, "req");
+
+    // The least recently used data is evicted to keep the cache size, its get call is sent to the server.
+    // The first half of the devices were read before the large value was received.
+    const size_t limit = 24 * 1024;
+    RealtimeDatabase *db = new RealtimeDatabase();
+    app.getApp<RealtimeDatabase>(*db);
+    db->url("https://host-bench-default-rtdb.firebaseio.com");
+    db->setLocalCache(true, limit);
+    // The client is also used by the Database to keep its Stream task running after this database was destroyed.
+    HOST_CHECK(cacheGet(Database, aClient3, "/other", &mock3, "1") == "1");
+    mock3.addResponse(streamResponse());
+    db->get(aClient3, "/devices", streamCallback3, true);
+    loopUntil(events3, 1);
+    HOST_CHECK(db->cacheStats().evictions == 0);
+    for (int i = 0; i < devices / 2; i++)
+        HOST_CHECK(cacheGet(*db, aClient3, "/devices/d" + std::to_string(i)) == deviceJSON(data[i]).c_str());
+
+    mock3.push(event("put", "/log", "\"" + std::string(4096, 'x') + "\""));
+    loopUntil(events3, 2);
+    HOST_CHECK(db->cacheStats().evictions > 0 && db->cacheStats().size <= limit);
+
+    uint32_t misses = 0;
+    for (int i = 0; i < devices; i++)
+    {
+        uint32_t m = db->cacheStats().misses;
+        HOST_CHECK(cacheGet(*db, aClient2, "/devices/d" + std::to_string(i), &mock2, deviceJSON(data[i])) == deviceJSON(data[i]).c_str());
+        misses += db->cacheStats().misses - m;
+        // The devices that were read are kept.
+        HOST_CHECK(i >= devices / 2 || db->cacheStats().misses == m);
+    }
+    printf("  %u KB cache: %u evictions, %u of %d device gets sent to the server\n", (unsigned)(limit / 1024), (unsigned)db->cacheStats().evictions, misses, devices);
+    HOST_CHECK(misses > 0 && misses < (uint32_t)devices);
+
+    // The database is destroyed while its Stream is running, the next events are not applied to the cache.
+    // The client is still processed by the Database loop.
+    delete db;
+    mock3.push(event("put", "/d1/temp", "99") + event("patch", "/d2", "{\"hum\":1}"));
+    loopUntil(events3, 4);
+
+    aClient.stopAsync(true);
+    aClient3.stopAsync(true);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HOST_MOCK_CLIENT_H
+#define HOST_MOCK_CLIENT_H
+
+#include <Client.h>
+#include <deque>
+#include <string>
+
+// The in-memory Client that replays the canned HTTP responses.
+// The queued response is released when the request line of the next request was written, or when it was added
+// after the request was written, and it is read in segments of the set size to mimic the network packets.
+class MockClient : public Client
+{
+public:
+    struct response_t
+    {
+        std::string data;
+        bool close = false; // The server closes the connection after this response.
+    };
+
+    MockClient() {}
+
+    /**
+     * Add the response of the next request.
+     *
+     * @param data The raw HTTP response (status line, headers and payload) or the SSE stream.
+     * @param close The connection is closed by the server after the response was read.
+     */
+    void addResponse(const String &data, bool close = false) { addResponse(data.c_str(), data.length(), close); }
+
+    void addResponse(const char *data, size_t len, bool close = false)
+    {
+        response_t res;
+        res.data.assign(data, len);
+        res.close = close;
+        responses.push_back(res);
+        if (unanswered)
+        {
+            unanswered--;
+            answer();
+        }
+    }
+
+    // Append the data to the response that is being read e.g. the next events of the SSE stream.
+    void push(const String &data) { input.append(data.c_str(), data.length()); }
+
+    // The maximum number of bytes that are available to read at a time.
+    void setSegmentSize(size_t size) { segment = size ? size : 1; }
+
+    // Refuse the next connections.
+    void setOffline(bool offline) { this->offline = offline; }
+
+    const std::string &written() const { return out; }
+
+    void clearWritten()
+    {
+        out.clear();
+        scan = 0;
+    }
+
+    size_t pending() const { return responses.size(); }
+
+    uint32_t connectCount = 0, stopCount = 0, requestCount = 0;
+    uint64_t bytesRead = 0, bytesWritten = 0;
+
+    int connect(IPAddress, uint16_t) override { return open(); }
+
+    int connect(const char *host, uint16_t port) override
+    {
+        this->host = host ? host : "";
+        this->port = port;
+        return open();
+    }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    size_t write(const uint8_t *buf, size_t size) override
+    {
+        if (!is_connected)
+            return 0;
+        out.append(reinterpret_cast<const char *>(buf), size);
+        bytesWritten += size;
+        release();
+        return size;
+    }
+
+    int available() override
+    {
+        if (!is_connected)
+            return 0;
+        size_t n = input.size() - rpos;
+        return n > segment ? segment : n;
+    }
+
+    int read() override
+    {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+
+    int read(uint8_t *buf, size_t size) override
+    {
+        size_t n = available();
+        if (n > size)
+            n = size;
+        memcpy(buf, input.data() + rpos, n);
+        rpos += n;
+        bytesRead += n;
+        if (rpos == input.size())
+        {
+            input.clear();
+            rpos = 0;
+            if (closing)
+                is_connected = false;
+        }
+        return n;
+    }
+
+    int peek() override { return available() ? (uint8_t)input[rpos] : -1; }
+
+    void flush() override {}
+
+    void stop() override
+    {
+        if (is_connected)
+            stopCount++;
+        is_connected = false;
+        input.clear();
+        rpos = 0;
+        closing = false;
+        // The requests of the closed connection are not answered.
+        unanswered = 0;
+    }
+
+    uint8_t connected() override { return is_connected; }
+
+    operator bool() override { return is_connected; }
+
+    using Print::write;
+
+private:
+    std::deque<response_t> responses;
+    std::string input, out, host;
+    size_t rpos = 0, scan = 0, segment = 1460, unanswered = 0;
+    uint16_t port = 0;
+    bool is_connected = false, closing = false, offline = false;
+
+    int open()
+    {
+        if (offline)
+            return 0;
+        input.clear();
+        rpos = 0;
+        closing = false;
+        is_connected = true;
+        connectCount++;
+        return 1;
+    }
+
+    // Release the response for each request line that was written.
+    void release()
+    {
+        size_t p;
+        while ((p = out.find(" HTTP/1.1\r\n", scan)) != std::string::npos)
+        {
+            scan = p + 11;
+            requestCount++;
+            if (responses.size())
+                answer();
+            else
+                unanswered++;
+        }
+    }
+
+    void answer()
+    {
+        input += responses.front().data;
+        closing = responses.front().close;
+        responses.pop_front();
+    }
+};
+
+#endif
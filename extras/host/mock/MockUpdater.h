@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef HOST_MOCK_UPDATER_H
+#define HOST_MOCK_UPDATER_H
+
+#include <Arduino.h>
+#include <string>
+
+// The OTA updater that writes the firmware to the in-memory flash partition.
+// Define FIREBASE_OTA_UPDATER as the MockUpdater object before including the library to use it.
+class MockUpdater
+{
+public:
+    std::string flash;   // The written image.
+    size_t size = 0;     // The image size of begin.
+    size_t failAt = 0;   // The write fails when the written image reaches this size, 0 for no failure.
+    bool running = false, applied = false;
+    uint32_t beginCount = 0, abortCount = 0;
+
+    void reset()
+    {
+        flash.clear();
+        size = 0;
+        failAt = 0;
+        running = false;
+        applied = false;
+    }
+
+    bool begin(size_t size, int command = 0)
+    {
+        (void)command;
+        if (running)
+            return false;
+        flash.clear();
+        this->size = size;
+        running = true;
+        applied = false;
+        beginCount++;
+        return true;
+    }
+
+    size_t write(uint8_t *data, size_t len)
+    {
+        if (!running || flash.size() + len > size || (failAt && flash.size() + len >= failAt))
+            return 0;
+        flash.append(reinterpret_cast<const char *>(data), len);
+        return len;
+    }
+
+    // The image is applied only when it was completely written as the device updaters do, otherwise the update is aborted.
+    bool end()
+    {
+        if (!running)
+            return false;
+        running = false;
+        applied = flash.size() == size;
+        if (!applied)
+            abortCount++;
+        return applied;
+    }
+
+    void abort()
+    {
+        if (running)
+            abortCount++;
+        running = false;
+    }
+};
+
+#endif
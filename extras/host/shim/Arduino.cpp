@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "Arduino.h"
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+
+static unsigned long host_offset_us = 0;
+
+static unsigned long long hostMicros()
+{
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<microseconds>(steady_clock::now() - start).count() + host_offset_us;
+}
+
+unsigned long millis() { return hostMicros() / 1000; }
+
+unsigned long micros() { return hostMicros(); }
+
+void delay(unsigned long ms)
+{
+    if (ms)
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void hostAdvanceTime(unsigned long ms) { host_offset_us += ms * 1000UL; }
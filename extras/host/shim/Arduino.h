@@ -0,0 +1,395 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The minimal Arduino core for building the library on the Linux host.
+// Only the parts of String, Print, Stream and timing functions that are used by the library are provided.
+
+#ifndef HOST_SHIM_ARDUINO_H
+#define HOST_SHIM_ARDUINO_H
+
+// The library is built on the host, the platform libraries e.g. the crypto library of the device are not available.
+#define FIREBASE_HOST_BUILD
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+inline void yield() {}
+
+// The time source of millis and micros can be advanced manually to test the timeouts without waiting.
+void hostAdvanceTime(unsigned long ms);
+
+#define PROGMEM
+#define PGM_P const char *
+#define F(s) (s)
+#define FPSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+
+class __FlashStringHelper;
+
+class String
+{
+public:
+    String() {}
+    String(const char *c)
+    {
+        if (c)
+            s = c;
+    }
+    String(const String &x) = default;
+    String(String &&x) = default;
+    explicit String(const std::string &x) : s(x) {}
+    explicit String(char c) : s(1, c) {}
+    explicit String(int v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(unsigned int v, unsigned char base = 10) { fromUInt(v, base); }
+    explicit String(long v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { fromUInt(v, base); }
+    explicit String(long long v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(unsigned long long v, unsigned char base = 10) { fromUInt(v, base); }
+    explicit String(float v, unsigned int digits = 2) { fromDouble(v, digits); }
+    explicit String(double v, unsigned int digits = 2) { fromDouble(v, digits); }
+
+    String &operator=(const String &x) = default;
+    String &operator=(String &&x) = default;
+    String &operator=(const char *c)
+    {
+        s = c ? c : "";
+        return *this;
+    }
+
+    unsigned int length() const { return s.size(); }
+    const char *c_str() const { return s.c_str(); }
+    bool reserve(unsigned int n)
+    {
+        s.reserve(n);
+        return true;
+    }
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char &operator[](unsigned int i) { return s[i]; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+    void setCharAt(unsigned int i, char c)
+    {
+        if (i < s.size())
+            s[i] = c;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+    int indexOf(const String &x, unsigned int from = 0) const { return pos(s.find(x.s, from)); }
+    int indexOf(const char *x, unsigned int from = 0) const { return pos(s.find(x, from)); }
+    int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+    int lastIndexOf(char c, unsigned int from) const { return pos(s.rfind(c, from)); }
+    int lastIndexOf(const String &x) const { return pos(s.rfind(x.s)); }
+    int lastIndexOf(const String &x, unsigned int from) const { return pos(s.rfind(x.s, from)); }
+
+    String substring(unsigned int a) const { return a > s.size() ? String() : String(s.substr(a)); }
+    String substring(unsigned int a, unsigned int b) const
+    {
+        if (a > b)
+            std::swap(a, b);
+        if (a > s.size())
+            return String();
+        return String(s.substr(a, b - a));
+    }
+
+    void remove(unsigned int i)
+    {
+        if (i < s.size())
+            s.erase(i);
+    }
+    void remove(unsigned int i, unsigned int n)
+    {
+        if (i < s.size())
+            s.erase(i, n);
+    }
+    void replace(const String &a, const String &b)
+    {
+        if (a.s.empty())
+            return;
+        size_t p = 0;
+        while ((p = s.find(a.s, p)) != std::string::npos)
+        {
+            s.replace(p, a.s.size(), b.s);
+            p += b.s.size();
+        }
+    }
+    void replace(char a, char b) { std::replace(s.begin(), s.end(), a, b); }
+    void trim()
+    {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        if (a == std::string::npos)
+        {
+            s.clear();
+            return;
+        }
+        size_t b = s.find_last_not_of(" \t\r\n");
+        s = s.substr(a, b - a + 1);
+    }
+    void toLowerCase()
+    {
+        for (auto &c : s)
+            c = tolower(c);
+    }
+    void toUpperCase()
+    {
+        for (auto &c : s)
+            c = toupper(c);
+    }
+
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+
+    bool startsWith(const String &x) const { return s.compare(0, x.s.size(), x.s) == 0; }
+    bool startsWith(const String &x, unsigned int offset) const { return offset <= s.size() && s.compare(offset, x.s.size(), x.s) == 0; }
+    bool endsWith(const String &x) const { return s.size() >= x.s.size() && s.compare(s.size() - x.s.size(), x.s.size(), x.s) == 0; }
+    bool equals(const String &x) const { return s == x.s; }
+    bool equalsIgnoreCase(const String &x) const { return strcasecmp(s.c_str(), x.s.c_str()) == 0; }
+    int compareTo(const String &x) const { return s.compare(x.s); }
+
+    bool concat(const char *c, unsigned int n)
+    {
+        s.append(c, n);
+        return true;
+    }
+    bool concat(const String &x)
+    {
+        s += x.s;
+        return true;
+    }
+    bool concat(const char *c)
+    {
+        if (c)
+            s += c;
+        return true;
+    }
+    bool concat(char c)
+    {
+        s += c;
+        return true;
+    }
+
+    String &operator+=(const String &x)
+    {
+        s += x.s;
+        return *this;
+    }
+    String &operator+=(const char *x)
+    {
+        if (x)
+            s += x;
+        return *this;
+    }
+    String &operator+=(char x)
+    {
+        s += x;
+        return *this;
+    }
+    String &operator+=(unsigned char x) { return *this += String((unsigned int)x); }
+    String &operator+=(int x) { return *this += String(x); }
+    String &operator+=(unsigned int x) { return *this += String(x); }
+    String &operator+=(long x) { return *this += String(x); }
+    String &operator+=(unsigned long x) { return *this += String(x); }
+    String &operator+=(long long x) { return *this += String(x); }
+    String &operator+=(unsigned long long x) { return *this += String(x); }
+    String &operator+=(float x) { return *this += String(x); }
+    String &operator+=(double x) { return *this += String(x); }
+
+    bool operator==(const String &x) const { return s == x.s; }
+    bool operator==(const char *x) const { return s == (x ? x : ""); }
+    bool operator!=(const String &x) const { return s != x.s; }
+    bool operator!=(const char *x) const { return s != (x ? x : ""); }
+    bool operator<(const String &x) const { return s < x.s; }
+
+    void toCharArray(char *b, unsigned int n, unsigned int index = 0) const
+    {
+        if (!n)
+            return;
+        size_t len = index < s.size() ? std::min<size_t>(n - 1, s.size() - index) : 0;
+        memcpy(b, s.c_str() + index, len);
+        b[len] = 0;
+    }
+    void getBytes(unsigned char *b, unsigned int n, unsigned int index = 0) const { toCharArray(reinterpret_cast<char *>(b), n, index); }
+
+    explicit operator bool() const { return true; }
+
+private:
+    std::string s;
+
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+
+    void fromUInt(unsigned long long v, unsigned char base)
+    {
+        char buf[66];
+        int i = 65;
+        buf[i] = 0;
+        do
+        {
+            int d = v % base;
+            buf[--i] = d < 10 ? '0' + d : 'a' + d - 10;
+            v /= base;
+        } while (v);
+        s = buf + i;
+    }
+
+    void fromInt(long long v, unsigned char base)
+    {
+        if (v < 0 && base == 10)
+        {
+            fromUInt(-(unsigned long long)v, base);
+            s.insert(s.begin(), '-');
+        }
+        else
+            fromUInt((unsigned long long)v, base);
+    }
+
+    void fromDouble(double v, unsigned int digits)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", digits, v);
+        s = buf;
+    }
+};
+
+inline String operator+(const String &a, const String &b)
+{
+    String r(a);
+    r += b;
+    return r;
+}
+inline String operator+(const String &a, const char *b)
+{
+    String r(a);
+    r += b;
+    return r;
+}
+inline String operator+(const char *a, const String &b)
+{
+    String r(a);
+    r += b;
+    return r;
+}
+inline String operator+(const String &a, char b)
+{
+    String r(a);
+    r += b;
+    return r;
+}
+
+class Print;
+
+class Printable
+{
+public:
+    virtual size_t printTo(Print &p) const = 0;
+    virtual ~Printable() {}
+};
+
+class Print
+{
+public:
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *b, size_t n)
+    {
+        size_t i = 0;
+        for (; i < n; i++)
+            write(b[i]);
+        return i;
+    }
+    size_t write(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); }
+    size_t write(const char *s, size_t n) { return write(reinterpret_cast<const uint8_t *>(s), n); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(const Printable &p) { return p.printTo(*this); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return print(String(v)); }
+    size_t print(unsigned int v) { return print(String(v)); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(unsigned long v) { return print(String(v)); }
+    size_t print(double v, int digits = 2) { return print(String(v, digits)); }
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(const T &v) { return print(v) + println(); }
+    size_t printf(const char *format, ...)
+    {
+        char buf[512];
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        return n > 0 ? write(reinterpret_cast<const uint8_t *>(buf), std::min<size_t>(n, sizeof(buf) - 1)) : 0;
+    }
+    virtual void flush() {}
+    virtual int availableForWrite() { return 0; }
+    virtual ~Print() {}
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual int read(uint8_t *b, size_t n)
+    {
+        size_t i = 0;
+        for (; i < n; i++)
+        {
+            int c = read();
+            if (c < 0)
+                break;
+            b[i] = c;
+        }
+        return i;
+    }
+    size_t readBytes(uint8_t *b, size_t n) { return read(b, n); }
+    size_t readBytes(char *b, size_t n) { return read(reinterpret_cast<uint8_t *>(b), n); }
+    String readStringUntil(char terminator)
+    {
+        String s;
+        int c;
+        while ((c = read()) > -1 && c != terminator)
+            s += (char)c;
+        return s;
+    }
+    void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    size_t write(uint8_t c)
+    {
+        fputc(c, stdout);
+        return 1;
+    }
+    size_t write(const uint8_t *b, size_t n) { return fwrite(b, 1, n, stdout); }
+    using Print::write;
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    void begin(unsigned long) {}
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The server connections of the async client that are pooled per host.
+// The connection that is selected for the host, the reused connections, the Stream connection that is never taken over
+// and the connection of the stopped Stream that is not counted as the Stream connection (the task was refused with
+// FIREBASE_ERROR_NO_FREE_CONNECTION) are checked.
+
+#define ENABLE_DATABASE
+#define FIREBASE_CONNECTION_POOL_SIZE 2
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock1, mock2, mock3;
+AsyncClientClass aClient(mock1);
+FirebaseApp app;
+RealtimeDatabase Database1, Database2;
+NoAuth no_auth;
+
+static void loopTasks(size_t count = 0)
+{
+    BenchTimer t;
+    while (aClient.taskCount() > count && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == count);
+}
+
+static void loopFor(int count)
+{
+    for (int i = 0; i < count; i++)
+        app.loop();
+}
+
+static uint32_t stream_events = 0;
+
+static void streamCallback(AsyncResult &aResult)
+{
+    if (aResult.available())
+        stream_events++;
+}
+
+static String stream()
+{
+    return "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n\r\nevent: put\ndata: {\"path\":\"/\",\"data\":1}\n\n";
+}
+
+int main()
+{
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database1);
+    app.getApp<RealtimeDatabase>(Database2);
+    Database1.url("https://host-a-default-rtdb.firebaseio.com");
+    Database2.url("https://host-b-default-rtdb.firebaseio.com");
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    HOST_CHECK(aClient.addClient(mock2));
+    HOST_CHECK(!aClient.addClient(mock3));
+
+    // The task uses the open connection to its host or the idle connection.
+    AsyncResult r1, r2, r3, r4;
+    mock1.addResponse(httpResponse("1"));
+    Database1.get(aClient, "/a", r1);
+    loopTasks();
+    hostAdvanceTime(10);
+
+    mock2.addResponse(httpResponse("2"));
+    Database2.get(aClient, "/b", r2);
+    loopTasks();
+    hostAdvanceTime(10);
+
+    mock1.addResponse(httpResponse("3"));
+    Database1.get(aClient, "/a", r3);
+    loopTasks();
+    hostAdvanceTime(10);
+
+    mock2.addResponse(httpResponse("4"));
+    Database2.get(aClient, "/b", r4);
+    loopTasks();
+    hostAdvanceTime(10);
+
+    HOST_CHECK(strcmp(r1.c_str(), "1") == 0 && strcmp(r2.c_str(), "2") == 0 && strcmp(r3.c_str(), "3") == 0 && strcmp(r4.c_str(), "4") == 0);
+    HOST_CHECK(mock1.connectCount == 1 && mock2.connectCount == 1);
+    HOST_CHECK(mock1.written().find("Host: host-a-default-rtdb.firebaseio.com\r\n") != std::string::npos);
+    HOST_CHECK(mock2.written().find("Host: host-b-default-rtdb.firebaseio.com\r\n") != std::string::npos);
+    HOST_CHECK(mock1.written().find("host-b-default-rtdb") == std::string::npos);
+    conn_pool_stats_t stats = aClient.connectionStats();
+    HOST_CHECK(stats.connects == 2 && stats.reconnects == 0 && stats.reused == 2);
+
+    // The Stream takes the least recently used connection.
+    mock1.addResponse(stream());
+    Database1.get(aClient, "/stream", streamCallback, true);
+    loopFor(20);
+    HOST_CHECK(stream_events == 1 && mock1.connectCount == 2);
+    hostAdvanceTime(10);
+
+    // The connection of the stopped Stream is kept open, the new Stream takes the least recently used connection.
+    aClient.stopAsync(true);
+    loopTasks();
+    HOST_CHECK(mock1.connected());
+    mock2.addResponse(stream());
+    Database2.get(aClient, "/stream", streamCallback, true);
+    loopFor(20);
+    HOST_CHECK(stream_events == 2 && mock2.connectCount == 2);
+    hostAdvanceTime(10);
+
+    // The connection of the stopped Stream is not carrying the Stream, the task takes it instead of being refused
+    // with FIREBASE_ERROR_NO_FREE_CONNECTION, and the Stream connection is never taken over.
+    AsyncResult r5;
+    mock1.addResponse(httpResponse("5"));
+    Database1.get(aClient, "/a", r5);
+    loopTasks(1);
+    HOST_CHECK(r5.error().code() != FIREBASE_ERROR_NO_FREE_CONNECTION && !r5.isError());
+    HOST_CHECK(strcmp(r5.c_str(), "5") == 0 && mock1.connectCount == 3);
+
+    uint32_t stops = mock2.stopCount;
+    mock2.push("event: put\ndata: {\"path\":\"/\",\"data\":2}\n\n");
+    loopFor(20);
+    HOST_CHECK(stream_events == 3 && mock2.stopCount == stops && mock2.connectCount == 2);
+
+    aClient.stopAsync(true);
+    loopTasks();
+
+    printf("pooled server connections passed\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The Firestore documents of the runQuery and list responses that are passed to the document callback.
+// The documents of each page, the pageToken of the next page requests, the last page, the documents count and
+// the runQuery results without the document and the HTTP error response are checked.
+
+#define ENABLE_FIRESTORE
+#define ENABLE_FIRESTORE_QUERY
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+Firestore::Documents Docs;
+NoAuth no_auth;
+
+static std::vector<firestore_document_t> docs;
+
+static void documentCallback(firestore_document_t &document) { docs.push_back(document); }
+
+static void loopTasks()
+{
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == 0);
+}
+
+static String doc(const String &id, const String &fields)
+{
+    return "{\"name\":\"projects/host-test/databases/(default)/documents/col/" + id + "\",\"fields\":" + fields +
+           ",\"createTime\":\"c" + id + "\",\"updateTime\":\"u" + id + "\"}";
+}
+
+static size_t count(const std::string &s, const char *sub)
+{
+    size_t n = 0;
+    for (size_t p = s.find(sub); p != std::string::npos; p = s.find(sub, p + 1))
+        n++;
+    return n;
+}
+
+static void testList()
+{
+    docs.clear();
+    mock.clearWritten();
+    uint32_t requests = mock.requestCount;
+
+    // The next page token is before the documents, the string values have the brackets and the escaped quote.
+    mock.addResponse(httpResponse("{\"nextPageToken\":\"tok/1+=\",\"documents\":[" + doc("d1", "{\"s\":{\"stringValue\":\"}]\\\"[{\"}}") + ",\n  " +
+                                  doc("d2", "{\"n\":{\"integerValue\":\"2\"}}") + "]}"));
+    mock.addResponse(httpResponse("{\"documents\":[" + doc("d3", "{}") + "],\"nextPageToken\":\"tok2\"}"));
+    // The last page has no documents and no next page token.
+    mock.addResponse(httpResponse("{}"));
+
+    AsyncResult result;
+    ListDocumentsOptions options;
+    options.pageSize(2).pageToken("start").orderBy("name");
+    Docs.list(aClient, Firestore::Parent("host-test"), "col", options, documentCallback, result);
+    loopTasks();
+
+    HOST_CHECK(!result.isError() && strcmp(result.c_str(), "{\"documentCount\":3,\"pageCount\":3}") == 0);
+    HOST_CHECK(mock.requestCount == requests + 3);
+    HOST_CHECK(docs.size() == 3);
+    HOST_CHECK(docs[0].name == "projects/host-test/databases/(default)/documents/col/d1" && docs[0].index == 0);
+    HOST_CHECK(docs[0].fields == "{\"s\":{\"stringValue\":\"}]\\\"[{\"}}");
+    HOST_CHECK(docs[0].createTime == "cd1" && docs[0].updateTime == "ud1" && docs[0].uid == result.uid());
+    HOST_CHECK(docs[1].fields == "{\"n\":{\"integerValue\":\"2\"}}" && docs[1].index == 1);
+    HOST_CHECK(docs[2].name.endsWith("/col/d3") && docs[2].index == 2 && docs[2].fields == "{}");
+
+    // The page token of the previous page request is replaced, the other query parameters are kept.
+    const std::string &req = mock.written();
+    HOST_CHECK(req.find("GET /v1/projects/host-test/databases/(default)/documents/col?pageSize=2&pageToken=start&orderBy=name HTTP/1.1\r\n") != std::string::npos);
+    HOST_CHECK(req.find("GET /v1/projects/host-test/databases/(default)/documents/col?pageSize=2&orderBy=name&pageToken=tok%2F1%2B%3D HTTP/1.1\r\n") != std::string::npos);
+    HOST_CHECK(req.find("GET /v1/projects/host-test/databases/(default)/documents/col?pageSize=2&orderBy=name&pageToken=tok2 HTTP/1.1\r\n") != std::string::npos);
+    HOST_CHECK(count(req, "pageToken=") == 3);
+}
+
+static void testRunQuery()
+{
+    docs.clear();
+    mock.clearWritten();
+
+    // The results without the document e.g. the read time of the skipped results.
+    mock.addResponse(httpResponse("[{\"readTime\":\"r0\",\"skippedResults\":1},{\"document\":" + doc("q1", "{\"b\":{\"booleanValue\":true}}") +
+                                  ",\"readTime\":\"r1\"},{\"document\":" + doc("q2", "{}") + ",\"readTime\":\"r2\"}]"));
+
+    AsyncResult result;
+    StructuredQuery query;
+    query.from(CollectionSelector("col", false));
+    QueryOptions options;
+    options.structuredQuery(query);
+    Docs.runQuery(aClient, Firestore::Parent("host-test"), "/", options, documentCallback, result);
+    loopTasks();
+
+    HOST_CHECK(!result.isError() && strcmp(result.c_str(), "{\"documentCount\":2}") == 0);
+    HOST_CHECK(docs.size() == 2);
+    HOST_CHECK(docs[0].name.endsWith("/col/q1") && docs[0].fields == "{\"b\":{\"booleanValue\":true}}" && docs[0].readTime == "r1" && docs[0].index == 0);
+    HOST_CHECK(docs[1].name.endsWith("/col/q2") && docs[1].readTime == "r2" && docs[1].index == 1);
+    HOST_CHECK(mock.written().find(":runQuery HTTP/1.1\r\n") != std::string::npos);
+}
+
+static void testError()
+{
+    docs.clear();
+    String payload = "{\"error\":{\"code\":400,\"message\":\"Invalid page token\",\"status\":\"INVALID_ARGUMENT\"}}";
+    String res = httpResponse(payload);
+    res.replace("200 OK", "400 Bad Request");
+    mock.addResponse(res);
+
+    AsyncResult result;
+    ListDocumentsOptions options;
+    options.pageToken("bad");
+    Docs.list(aClient, Firestore::Parent("host-test"), "col", options, documentCallback, result);
+    loopTasks();
+
+    HOST_CHECK(result.isError() && result.error().code() == 400 && docs.size() == 0);
+}
+
+int main()
+{
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<Firestore::Documents>(Docs);
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    testList();
+    testRunQuery();
+    testError();
+
+    printf("streamed documents passed\n");
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The Firestore document writes that are sent with the batch write request.
+// The patch options are created from the temporary objects as in the UpdateDocument example, the update mask and
+// the precondition of the write are checked in the batch write payload after the temporaries were destroyed.
+
+#define ENABLE_FIRESTORE
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+Firestore::Documents Docs;
+NoAuth no_auth;
+
+static PatchDocumentOptions patchOptions(bool exists)
+{
+    Precondition precondition;
+    if (exists)
+        precondition.exists(true);
+    return PatchDocumentOptions(DocumentMask("count,status"), DocumentMask(), precondition);
+}
+
+int main()
+{
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<Firestore::Documents>(Docs);
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    // The writes are held to be sent with one batch write request.
+    Docs.setAutoBatch(true, 50);
+
+    Document<Values::Value> doc("count", Values::Value(Values::IntegerValue(1)));
+    doc.add("status", Values::Value(Values::StringValue("on")));
+
+    AsyncResult r1, r2;
+    Docs.patch(aClient, Firestore::Parent("host-test"), "devices/d1", PatchDocumentOptions(DocumentMask("count,status"), DocumentMask(), Precondition()), doc, r1);
+
+    // The options that are copied from the options of the destroyed temporaries.
+    PatchDocumentOptions options = patchOptions(true);
+    Docs.patch(aClient, Firestore::Parent("host-test"), "devices/d2", options, doc, r2);
+
+    mock.addResponse(httpResponse("{\"writeResults\":[{\"updateTime\":\"t1\"},{\"updateTime\":\"t2\"}],\"status\":[{},{}]}"));
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == 0);
+
+    const std::string &req = mock.written();
+    HOST_CHECK(mock.requestCount == 1);
+    HOST_CHECK(req.find("POST /v1/projects/host-test/databases/(default)/documents:batchWrite") != std::string::npos);
+    HOST_CHECK(req.find("\"updateMask\":{\"fieldPaths\":[\"count\",\"status\"]}") != std::string::npos);
+    HOST_CHECK(req.find("\"currentDocument\":{\"exists\":true}") != std::string::npos);
+    HOST_CHECK(req.find("\"name\":\"projects/host-test/databases/(default)/documents/devices/d2\"") != std::string::npos);
+
+    HOST_CHECK(!r1.isError() && String(r1.c_str()).indexOf("\"t1\"") > 0);
+    HOST_CHECK(!r2.isError() && String(r2.c_str()).indexOf("\"t2\"") > 0);
+    printf("batch write of the patch options from temporaries passed\n");
+    return 0;
+}
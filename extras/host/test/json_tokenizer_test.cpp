@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The members that are pulled by the streaming JSON tokenizer.
+// The member depth, the order and whitespace, the string escapes, the container values, the input in chunks,
+// the invalid input and the push response of RealtimeDatabase are checked.
+
+#define ENABLE_DATABASE
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+NoAuth no_auth;
+
+// Feed the input in chunks of the size, the whole input is fed at once when the size is 0.
+static bool tokenize(const String &input, json_field_t *fields, size_t count, size_t chunk = 0)
+{
+    JSONTokenizer jt;
+    jt.begin(fields, count);
+    bool ok = true;
+    size_t size = chunk ? chunk : input.length();
+    for (size_t i = 0; i < input.length() && ok; i += size)
+        ok = jt.feed(input.c_str() + i, input.length() - i < size ? input.length() - i : size);
+    return ok && !jt.error();
+}
+
+static void testMembers(size_t chunk)
+{
+    // The member of the nested object is not the top-level member, the order and whitespace do not matter.
+    String input = "{ \"user\" : {\"idToken\":\"nested\"},\n\t\"expiresIn\" : \"3600\" , \"idToken\":\"abc\",\"n\":-1.5e3 }";
+    String token, nested, expire, n;
+    json_field_t fields[] = {json_field_t("idToken", 1, &token), json_field_t("idToken", 2, &nested),
+                             json_field_t("expiresIn", 1, &expire), json_field_t("n", 1, &n)};
+    HOST_CHECK(tokenize(input, fields, 4, chunk));
+    HOST_CHECK(token == "abc" && nested == "nested" && expire == "3600" && n == "-1.5e3");
+    HOST_CHECK(fields[0].found && fields[1].found && fields[2].found && fields[3].found);
+
+    // The value positions exclude the quotes of the string value.
+    HOST_CHECK(input.substring(fields[0].p1, fields[0].p2) == "abc");
+    HOST_CHECK(input.substring(fields[3].p1, fields[3].p2) == "-1.5e3");
+
+    // The member at any depth is the first member of that name.
+    String any;
+    json_field_t field("idToken", 0, &any);
+    HOST_CHECK(tokenize(input, &field, 1, chunk) && any == "nested");
+}
+
+static void testEscapes(size_t chunk)
+{
+    // The escaped quote, backslash, solidus, control, the 2 and 3 bytes UTF-8 and the surrogate pair characters.
+    String input = "{\"msg\":\"a\\\"b\\\\c\\/d\\n\\u00e9\\u20ac\\ud83d\\ude00\",\"k\\u0065y\":1}";
+    String msg, key;
+    json_field_t fields[] = {json_field_t("msg", 1, &msg), json_field_t("key", 1, &key)};
+    HOST_CHECK(tokenize(input, fields, 2, chunk));
+    HOST_CHECK(msg == "a\"b\\c/d\n\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    HOST_CHECK(key == "1");
+}
+
+static void testContainers(size_t chunk)
+{
+    // The container value is the JSON text of the nested containers, the string member inside the container value is pulled.
+    String input = "{\"data\":{\"a\":[1,{\"b\":\"}\"},[]],\"c\":null},\"list\":[true,false],\"b\":2}";
+    String data, list, b;
+    json_field_t fields[] = {json_field_t("data", 1, &data), json_field_t("list", 1, &list), json_field_t("b", 0, &b)};
+    HOST_CHECK(tokenize(input, fields, 3, chunk));
+    HOST_CHECK(data == "{\"a\":[1,{\"b\":\"}\"},[]],\"c\":null}");
+    HOST_CHECK(list == "[true,false]");
+    HOST_CHECK(b == "}");
+    HOST_CHECK(input.substring(fields[0].p1, fields[0].p2) == data);
+}
+
+static void testInvalid()
+{
+    String v;
+    json_field_t field("a", 1, &v);
+    HOST_CHECK(!tokenize("{\"a\" 1}", &field, 1));
+    HOST_CHECK(!tokenize("{\"x\":1,,\"a\":2}", &field, 1));
+    HOST_CHECK(!tokenize("{\"x\":[1}", &field, 1));
+    HOST_CHECK(!tokenize("{\"x\":\"\\uzzzz\"}", &field, 1));
+    HOST_CHECK(!tokenize("{\"x\":1}}", &field, 1));
+
+    // The input is not scanned further when all members were found.
+    HOST_CHECK(tokenize("{\"a\":\"ok\"} trailing", &field, 1) && v == "ok");
+
+    // The member name that is longer than FIREBASE_JSON_KEY_SIZE is not matched.
+    String name;
+    while (name.length() <= FIREBASE_JSON_KEY_SIZE)
+        name += 'k';
+    String input = "{\"" + name + "\":1,\"a\":2}";
+    json_field_t fields[] = {json_field_t(name.c_str(), 1), json_field_t("a", 1, &v)};
+    HOST_CHECK(tokenize(input, fields, 2) && !fields[0].found && fields[1].found && v == "2");
+}
+
+// The node name of the push response with the members in any order.
+static void testPushName()
+{
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    Database.url("https://host-test-default-rtdb.firebaseio.com");
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    AsyncResult result;
+    mock.addResponse(httpResponse("{ \"other\" : {\"name\":\"nested\"} , \"name\" : \"-Nabc\" }"));
+    Database.push<number_t>(aClient, "/list", number_t(1), result);
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(!result.isError() && result.to<RealtimeDatabaseResult>().name() == "-Nabc");
+}
+
+int main()
+{
+    // The whole input, byte by byte and in chunks.
+    size_t chunks[] = {0, 1, 3, 7};
+    for (size_t chunk : chunks)
+    {
+        testMembers(chunk);
+        testEscapes(chunk);
+        testContainers(chunk);
+    }
+    testInvalid();
+    testPushName();
+
+    printf("JSON tokenizer passed\n");
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The requests of the queued async tasks that are pipelined on the keep-alive connection.
+// The requests in flight, the order of the responses, the request that is not pipelined and the pipelined requests
+// that are sent again when the server closed the connection are checked.
+
+#define ENABLE_DATABASE
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+NoAuth no_auth;
+
+static void loopFor(int count)
+{
+    for (int i = 0; i < count; i++)
+        app.loop();
+}
+
+static void loopTasks()
+{
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == 0);
+}
+
+int main()
+{
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<RealtimeDatabase>(Database);
+    Database.url("https://host-test-default-rtdb.firebaseio.com");
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    aClient.setPipelining(4);
+
+    // The requests of the queued tasks are sent before the first response was received.
+    AsyncResult r[4];
+    for (int i = 0; i < 4; i++)
+        Database.get(aClient, "/pipe/" + String(i), r[i]);
+    loopFor(20);
+    HOST_CHECK(mock.requestCount == 4);
+    HOST_CHECK(mock.connectCount == 1);
+    HOST_CHECK(mock.written().find("GET /pipe/3.json HTTP/1.1\r\n") != std::string::npos);
+
+    // The responses are read in order of the requests.
+    for (int i = 0; i < 4; i++)
+        mock.addResponse(httpResponse(String(i * 10)));
+    loopTasks();
+    for (int i = 0; i < 4; i++)
+        HOST_CHECK(!r[i].isError() && String(r[i].c_str()) == String(i * 10));
+    HOST_CHECK(mock.connectCount == 1);
+
+    // The POST request is not pipelined, the request of the next task is sent after the POST response was read.
+    mock.clearWritten();
+    uint32_t requests = mock.requestCount;
+    AsyncResult g1, p1, g2;
+    Database.get(aClient, "/pipe/a", g1);
+    Database.push<number_t>(aClient, "/pipe/list", number_t(1), p1);
+    Database.get(aClient, "/pipe/b", g2);
+    loopFor(20);
+    HOST_CHECK(mock.requestCount == requests + 1);
+
+    mock.addResponse(httpResponse("\"a\""));
+    mock.addResponse(httpResponse("{\"name\":\"-Nabc\"}"));
+    mock.addResponse(httpResponse("\"b\""));
+    loopTasks();
+    HOST_CHECK(mock.requestCount == requests + 3);
+    HOST_CHECK(!g1.isError() && !p1.isError() && !g2.isError());
+    HOST_CHECK(strcmp(g1.c_str(), "\"a\"") == 0 && strcmp(g2.c_str(), "\"b\"") == 0);
+
+    // The server closed the connection after the first response, the pipelined requests are sent again
+    // on the new connection.
+    requests = mock.requestCount;
+    uint32_t connects = mock.connectCount;
+    AsyncResult c[3];
+    for (int i = 0; i < 3; i++)
+        Database.get(aClient, "/pipe/c" + String(i), c[i]);
+    loopFor(20);
+    HOST_CHECK(mock.requestCount == requests + 3);
+
+    mock.addResponse(httpResponse("0"), true /* close */);
+    loopFor(50);
+    HOST_CHECK(mock.connectCount == connects + 1);
+    HOST_CHECK(mock.requestCount == requests + 5);
+
+    mock.addResponse(httpResponse("1"));
+    mock.addResponse(httpResponse("2"));
+    loopTasks();
+    for (int i = 0; i < 3; i++)
+        HOST_CHECK(!c[i].isError() && String(c[i].c_str()) == String(i));
+
+    printf("pipelined requests passed\n");
+    return 0;
+}
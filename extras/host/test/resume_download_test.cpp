@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The Storage download that was interrupted by the connection drop and resumed with the byte-range request.
+// The download that is not resumed by default, the Range header, the partial content and the whole content
+// (the server ignored the range request) appended to the BLOB, the sync download and the retry limit are checked.
+
+#define ENABLE_STORAGE
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+Storage storage;
+NoAuth no_auth;
+
+static const size_t size = 3000;
+static String content;
+static uint8_t out[size];
+
+static String header(int code, const char *status, size_t len, const String &extra = "")
+{
+    String res = "HTTP/1.1 " + String(code) + " " + status + "\r\nContent-Type: application/octet-stream\r\nContent-Length: ";
+    res += String((unsigned int)len);
+    res += "\r\n";
+    res += extra;
+    res += "\r\n";
+    return res;
+}
+
+// The response that the connection drops after the data of length was sent.
+static void addDropped(size_t len) { mock.addResponse(header(200, "OK", size) + content.substring(0, len), true /* close */); }
+
+static void addRange(size_t offset)
+{
+    String range = "Content-Range: bytes " + String((unsigned int)offset) + "-" + String((unsigned int)size - 1) + "/" + String((unsigned int)size) + "\r\n";
+    mock.addResponse(header(206, "Partial Content", size - offset, range) + content.substring(offset));
+}
+
+static bool received() { return memcmp(out, content.c_str(), size) == 0; }
+
+static void download(FirebaseStorage::Parent &parent, AsyncResult &result)
+{
+    memset(out, 0, size);
+    BlobConfig blob(out, size);
+    mock.clearWritten();
+    storage.download(aClient, parent, getBlob(blob), result);
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+    {
+        app.loop();
+        // The read time out of the dropped connection.
+        hostAdvanceTime(100);
+    }
+    HOST_CHECK(aClient.taskCount() == 0);
+}
+
+static bool hasRange(size_t offset) { return mock.written().find(("Range: bytes=" + String((unsigned int)offset) + "-\r\n").c_str()) != std::string::npos; }
+
+int main()
+{
+    for (size_t i = 0; i < size; i++)
+        content += (char)('a' + i % 26);
+
+    initializeApp(aClient, app, getAuth(no_auth));
+    app.getApp<Storage>(storage);
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    // The download is not resumed by default, it fails at the read time out.
+    FirebaseStorage::Parent parent("host-test.appspot.com", "data.bin");
+    HOST_CHECK(parent.getResumeRetry() == 0);
+    AsyncResult r1;
+    uint32_t requests = mock.requestCount;
+    addDropped(1000);
+    download(parent, r1);
+    HOST_CHECK(aClient.lastError().code() == FIREBASE_ERROR_TCP_RECEIVE_TIMEOUT && !received());
+    HOST_CHECK(mock.requestCount == requests + 1);
+    HOST_CHECK(mock.written().find("Range: bytes=") == std::string::npos);
+
+    // The partial content is appended at the offset of the received data.
+    parent.setResume(2, 0);
+    AsyncResult r2;
+    requests = mock.requestCount;
+    uint32_t connects = mock.connectCount;
+    addDropped(1200);
+    addRange(1200);
+    download(parent, r2);
+    HOST_CHECK(!r2.isError() && received());
+    HOST_CHECK(mock.requestCount == requests + 2 && mock.connectCount == connects + 2);
+    HOST_CHECK(hasRange(1200));
+
+    // The server ignored the range request and sent the whole content, the data that was received is skipped.
+    AsyncResult r3;
+    addDropped(1500);
+    mock.addResponse(header(200, "OK", size) + content);
+    download(parent, r3);
+    HOST_CHECK(!r3.isError() && received());
+    HOST_CHECK(hasRange(1500));
+
+    // The sync download is resumed in place until the retry limit.
+    addDropped(700);
+    addDropped(1400);
+    addRange(1400);
+    memset(out, 0, size);
+    BlobConfig blob(out, size);
+    mock.clearWritten();
+    HOST_CHECK(storage.download(aClient, parent, getBlob(blob)));
+    HOST_CHECK(received() && hasRange(700) && hasRange(1400));
+
+    // The retry limit was reached, the sync download fails at the read time out.
+    aClient.setSyncReadTimeout(1);
+    requests = mock.requestCount;
+    addDropped(500);
+    addDropped(900);
+    addDropped(1300);
+    memset(out, 0, size);
+    blob.setBlob(out, size);
+    HOST_CHECK(!storage.download(aClient, parent, getBlob(blob)));
+    HOST_CHECK(mock.requestCount == requests + 3);
+
+    printf("resumed downloads passed\n");
+    return 0;
+}
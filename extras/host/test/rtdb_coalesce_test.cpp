@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// The RealtimeDatabase set and update calls that are merged into one multi-location update request.
+// The path, the query (auth parameter) and the payload of the merged PATCH request and the result of each write are checked.
+
+#define ENABLE_DATABASE
+#define ENABLE_LEGACY_TOKEN
+
+#include <FirebaseClient.h>
+#include "../mock/MockClient.h"
+#include "../bench/Bench.h"
+
+MockClient mock;
+AsyncClientClass aClient(mock);
+FirebaseApp app;
+RealtimeDatabase Database;
+LegacyToken legacy_token("host-secret");
+
+static void loopTasks()
+{
+    BenchTimer t;
+    while (aClient.taskCount() && t.elapsedMs() < 2000)
+        app.loop();
+    HOST_CHECK(aClient.taskCount() == 0);
+}
+
+int main()
+{
+    initializeApp(aClient, app, getAuth(legacy_token));
+    app.getApp<RealtimeDatabase>(Database);
+    Database.url("https://host-test-default-rtdb.firebaseio.com");
+    for (int i = 0; i < 10 && !app.ready(); i++)
+        app.loop();
+    HOST_CHECK(app.ready());
+
+    Database.setWriteCoalescing(true, 50);
+
+    AsyncResult r1, r2, r3;
+    Database.set<int>(aClient, "/devices/d1/temp", 20, r1);
+    Database.update(aClient, "/devices/d2", object_t("{\"hum\":40,\"on\":true}"), r2);
+    Database.set<string_t>(aClient, "/devices/d1/name", string_t("dev 1"), r3);
+
+    mock.addResponse(httpResponse("{\"d1/temp\":20,\"d2/hum\":40,\"d2/on\":true,\"d1/name\":\"dev 1\"}"));
+    loopTasks();
+
+    const std::string &req = mock.written();
+    HOST_CHECK(mock.requestCount == 1);
+    HOST_CHECK(req.find("PATCH /devices.json?auth=host-secret HTTP/1.1\r\n") == 0);
+    HOST_CHECK(req.find("\r\n\r\n{\"d1/temp\":20,\"d2/hum\":40,\"d2/on\":true,\"d1/name\":\"dev 1\"}") != std::string::npos);
+
+    HOST_CHECK(!r1.isError() && !r2.isError() && !r3.isError());
+    HOST_CHECK(Database.coalesceStats().requests == 1 && Database.coalesceStats().writes == 3);
+
+    // The write to the path that was already written replaces the queued value.
+    mock.clearWritten();
+    AsyncResult r4, r5;
+    Database.set<int>(aClient, "/devices/d1/temp", 21, r4);
+    Database.set<int>(aClient, "/devices/d1/temp", 22, r5);
+    mock.addResponse(httpResponse("{\"temp\":22}"));
+    loopTasks();
+    HOST_CHECK(mock.requestCount == 2);
+    HOST_CHECK(mock.written().find("PATCH /devices/d1.json?auth=host-secret HTTP/1.1\r\n") == 0);
+    HOST_CHECK(mock.written().find("\r\n\r\n{\"temp\":22}") != std::string::npos);
+    HOST_CHECK(!r4.isError() && !r5.isError());
+
+    printf("merged multi-location update requests passed\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+# SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+#
+# SPDX-License-Identifier: MIT
+
+"""Convert the bsdiff patch to the delta OTA patch format.
+
+The delta OTA update (ENABLE_DELTA_OTA) reads the ENDSLEY/BSDIFF43 header (16 bytes magic and
+8 bytes patched image size) followed by the uncompressed bsdiff control, diff and extra data
+interleaved. The bsdiff tool writes the same data as bzip2 stream (ENDSLEY/BSDIFF43) or as three
+bzip2 blocks (BSDIFF40) which are too large to decompress on device, this tool decompresses them
+and optionally gzip compresses the whole patch (the device requires ENABLE_GZIP).
+
+Usage:
+    bsdiff firmware_old.bin firmware_new.bin firmware.bsdiff
+    python3 delta_ota_patch.py --gzip firmware.bsdiff firmware.patch
+    python3 delta_ota_patch.py --self-test
+
+Then upload firmware.patch to Storage or Cloud Storage, or as Base64 string to RTDB, in place of
+the full image.
+"""
+
+import argparse
+import bz2
+import gzip
+import struct
+import sys
+
+MAGIC_43 = b"ENDSLEY/BSDIFF43"
+MAGIC_40 = b"BSDIFF40"
+
+
+def offtin(buf, pos=0):
+    """The bsdiff signed 64-bit integer (sign and magnitude, little endian)."""
+    y = struct.unpack_from("<Q", buf, pos)[0]
+    return -(y & ~(1 << 63)) if y & (1 << 63) else y
+
+
+def offtout(x):
+    return struct.pack("<Q", (-x | (1 << 63)) if x < 0 else x)
+
+
+def convert(patch):
+    """Return the header and the uncompressed interleaved data of the bsdiff patch."""
+    if patch.startswith(MAGIC_43):
+        if len(patch) < 24:
+            raise ValueError("truncated ENDSLEY/BSDIFF43 header")
+        body = patch[24:]
+        # The patch that was already converted.
+        if not body.startswith(b"BZh"):
+            return patch
+        return patch[:24] + bz2.decompress(body)
+
+    if patch.startswith(MAGIC_40):
+        if len(patch) < 32:
+            raise ValueError("truncated BSDIFF40 header")
+        ctrl_len, diff_len, new_size = offtin(patch, 8), offtin(patch, 16), offtin(patch, 24)
+        if ctrl_len < 0 or diff_len < 0 or new_size < 0:
+            raise ValueError("invalid BSDIFF40 header")
+        ctrl = bz2.decompress(patch[32:32 + ctrl_len])
+        diff = bz2.decompress(patch[32 + ctrl_len:32 + ctrl_len + diff_len])
+        extra = bz2.decompress(patch[32 + ctrl_len + diff_len:])
+
+        out = bytearray(MAGIC_43 + offtout(new_size))
+        diff_pos = extra_pos = 0
+        for i in range(0, len(ctrl) - len(ctrl) % 24, 24):
+            d, e = offtin(ctrl, i), offtin(ctrl, i + 8)
+            if d < 0 or e < 0 or diff_pos + d > len(diff) or extra_pos + e > len(extra):
+                raise ValueError("invalid BSDIFF40 control data")
+            out += ctrl[i:i + 24] + diff[diff_pos:diff_pos + d] + extra[extra_pos:extra_pos + e]
+            diff_pos += d
+            extra_pos += e
+        return bytes(out)
+
+    raise ValueError("not a bsdiff patch")
+
+
+def apply(old, patch):
+    """Apply the converted patch as the device does, to check the conversion."""
+    if patch.startswith(b"\x1f\x8b"):
+        patch = gzip.decompress(patch)
+    if not patch.startswith(MAGIC_43):
+        raise ValueError("not a delta OTA patch")
+    new_size = offtin(patch, 16)
+    new = bytearray()
+    pos, old_pos = 24, 0
+    while len(new) < new_size:
+        d, e, seek = offtin(patch, pos), offtin(patch, pos + 8), offtin(patch, pos + 16)
+        pos += 24
+        for k in range(d):
+            b = old[old_pos + k] if 0 <= old_pos + k < len(old) else 0
+            new.append((patch[pos + k] + b) & 0xFF)
+        pos += d
+        new += patch[pos:pos + e]
+        pos += e
+        old_pos += d + seek
+    if len(new) != new_size:
+        raise ValueError("invalid patch")
+    return bytes(new)
+
+
+def self_test():
+    old = bytes((i * 7 + (i >> 5)) & 0xFF for i in range(4096))
+    new = bytearray(old[:1000]) + b"inserted code" + old[1000:3000] + b"appended data"
+    new[10] ^= 0x04
+
+    # The control entries: diff of the first part, extra of the inserted bytes, diff of the rest and the appended data.
+    ctrl = [(1000, 13, 0), (2000, 13, 0)]
+    diff = bytes((new[i] - old[i]) & 0xFF for i in range(1000))
+    diff += bytes((new[1013 + i] - old[1000 + i]) & 0xFF for i in range(2000))
+    extra = b"inserted code" + b"appended data"
+
+    expected = bytearray(MAGIC_43 + offtout(len(new)))
+    expected += offtout(1000) + offtout(13) + offtout(0) + diff[:1000] + extra[:13]
+    expected += offtout(2000) + offtout(13) + offtout(0) + diff[1000:] + extra[13:]
+    expected = bytes(expected)
+
+    bsdiff43 = MAGIC_43 + offtout(len(new)) + bz2.compress(expected[24:])
+    ctrl_bz = bz2.compress(b"".join(offtout(d) + offtout(e) + offtout(s) for d, e, s in ctrl))
+    diff_bz = bz2.compress(diff)
+    bsdiff40 = MAGIC_40 + offtout(len(ctrl_bz)) + offtout(len(diff_bz)) + offtout(len(new)) + ctrl_bz + diff_bz + bz2.compress(extra)
+
+    for patch in (bsdiff43, bsdiff40, expected):
+        converted = convert(patch)
+        assert converted == expected, "converted patch mismatch"
+        assert apply(old, converted) == bytes(new), "patched image mismatch"
+        assert apply(old, gzip.compress(converted)) == bytes(new), "gzip patched image mismatch"
+
+    for bad in (b"BSDIFF4", b"not a patch", MAGIC_43[:10]):
+        try:
+            convert(bad)
+            raise AssertionError("invalid patch was converted")
+        except ValueError:
+            pass
+
+    print("delta_ota_patch self test passed")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert the bsdiff patch to the delta OTA patch format.")
+    parser.add_argument("input", nargs="?", help="the bsdiff patch (ENDSLEY/BSDIFF43 or BSDIFF40)")
+    parser.add_argument("output", nargs="?", help="the delta OTA patch")
+    parser.add_argument("--gzip", action="store_true", help="gzip compress the patch (requires ENABLE_GZIP)")
+    parser.add_argument("--old", help="the running image to check the converted patch with")
+    parser.add_argument("--new", help="the new image that the patched running image should match")
+    parser.add_argument("--self-test", action="store_true", help="run the conversion test")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return self_test()
+
+    if not args.input or not args.output:
+        parser.error("the input and output patches are required")
+
+    with open(args.input, "rb") as f:
+        patch = convert(f.read())
+
+    if args.old and args.new:
+        with open(args.old, "rb") as f:
+            old = f.read()
+        with open(args.new, "rb") as f:
+            if apply(old, patch) != f.read():
+                sys.exit("the patched image does not match the new image")
+
+    out = gzip.compress(patch, 9) if args.gzip else patch
+    with open(args.output, "wb") as f:
+        f.write(out)
+    print("%s: %d bytes (%s)" % (args.output, len(out), "gzip" if args.gzip else "uncompressed"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
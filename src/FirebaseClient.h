@@ -94,7 +94,7 @@ namespace firebase_ns
         {
             app.deinit = false;
             app.aClient = &aClient;
-            app.aclient_addr = reinterpret_cast<uint32_t>(&aClient);
+            app.aclient_handle = clientHandleBase(app.aClient);
 #if defined(ENABLE_JWT)
             app.jwtProcessor()->setAppDebug(getAppDebug(app.aClient));
 #endif
@@ -102,10 +102,10 @@ namespace firebase_ns
             {
                 resultSetDebug(app.refResult, getAppDebug(app.aClient));
                 resultSetEvent(app.refResult, getAppEvent(app.aClient));
-                app.setRefResult(app.refResult, reinterpret_cast<uint32_t>(&(app.getRVec(app.aClient))));
+                app.setRefResult(app.refResult);
             }
 
-            app.addRemoveClientVecBase(app.aClient, reinterpret_cast<uint32_t>(&(app.cVec)), true);
+            app.addRemoveClientVecBase(app.aClient, &app.cVec, true);
             app.auth_data.user_auth.copy(auth);
 
             app.auth_data.app_token.clear();
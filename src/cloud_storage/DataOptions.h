@@ -335,7 +335,10 @@ namespace GoogleCloudStorage
         friend class Storage;
 
     private:
-        String bucketId, object;
+        String bucketId, object, hash;
+        firebase_hash_type hash_type = hash_none;
+        uint8_t resume_retry = FIREBASE_DOWNLOAD_RESUME_RETRY;
+        uint16_t resume_interval = FIREBASE_DOWNLOAD_RESUME_INTERVAL_SEC;
 
     public:
         Parent() {}
@@ -361,6 +364,38 @@ namespace GoogleCloudStorage
         }
         String getObject() const { return object; }
         String getBucketId() const { return bucketId; }
+        /**
+         * Set the expected digest of the object to verify the downloaded data.
+         *
+         * @param type The hash algorithm i.e. hash_md5, hash_sha256 or hash_crc32c.
+         * @param digest The expected digest in hex or Base64 e.g. the md5Hash or crc32c of the object metadata.
+         *
+         * The download and OTA tasks fail with FIREBASE_ERROR_DOWNLOAD_HASH_MISMATCH error when the digest does not match,
+         * and the firmware is not applied.
+         */
+        void setHash(firebase_hash_type type, const String &digest)
+        {
+            this->hash_type = type;
+            this->hash = digest;
+        }
+        firebase_hash_type getHashType() const { return hash_type; }
+        String getHash() const { return hash; }
+        /**
+         * Set the retry policy of the interrupted download.
+         *
+         * @param maxRetry The maximum number of byte-range requests to resume the download, 0 to disable (default FIREBASE_DOWNLOAD_RESUME_RETRY).
+         * @param intervalSec The time in seconds to wait before resuming (default FIREBASE_DOWNLOAD_RESUME_INTERVAL_SEC).
+         *
+         * When the connection drops or the read times out, the download and OTA tasks continue from the received data
+         * instead of failing.
+         */
+        void setResume(uint8_t maxRetry, uint16_t intervalSec = FIREBASE_DOWNLOAD_RESUME_INTERVAL_SEC)
+        {
+            this->resume_retry = maxRetry;
+            this->resume_interval = intervalSec;
+        }
+        uint8_t getResumeRetry() const { return resume_retry; }
+        uint16_t getResumeInterval() const { return resume_interval; }
     };
 
     class DataOptions
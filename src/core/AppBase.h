@@ -9,11 +9,21 @@
 
 #include <Arduino.h>
 #include "./core/AsyncResult/AsyncResult.h"
+#include "./core/Utils/Handle.h"
+
+// The async clients loop cost of FirebaseApp.
+struct app_loop_stats_t
+{
+    uint32_t last_us = 0; // The time spent in the last loop in microseconds.
+    uint32_t max_us = 0;  // The longest loop time in microseconds.
+    uint32_t count = 0;   // The number of loops.
+    uint16_t clients = 0; // The number of async clients that were processed in the last loop.
+};
 
 struct cvec_address_info_t
 {
-    uint32_t cvec_addr = 0;
-    uint32_t app_addr = 0;
+    firebase_handle_t service_handle = 0; // The Firebase service (AppBase) handle
+    firebase_handle_t app_handle = 0;     // The FirebaseApp handle
     app_token_t *app_token = nullptr;
 };
 
@@ -33,77 +43,97 @@ class AppBase
 public:
     AppBase() {}
 
-    static void removeCvecAddressList(std::vector<cvec_address_info_t> *cvec_address_list, uint32_t app_addr)
+    static void removeCvecAddressList(std::vector<cvec_address_info_t> *cvec_address_list, firebase_handle_t service_handle)
     {
         for (int i = cvec_address_list->size() - 1; i >= 0; i--)
         {
-            if (app_addr == (*cvec_address_list)[i].app_addr)
+            if (service_handle == (*cvec_address_list)[i].service_handle)
                 cvec_address_list->erase(cvec_address_list->begin() + i);
         }
     }
 
-    static void staticLoop(const app_token_t *aToken, uint32_t cvec_addr)
+    // Start the new pass of the async clients loop.
+    // The client that was already processed in the current pass is skipped.
+    static uint32_t beginLoop()
     {
-        std::vector<uint32_t> cVec = *reinterpret_cast<std::vector<uint32_t> *>(cvec_addr);
+        static uint32_t tick = 0;
+        if (++tick == 0)
+            tick = 1;
+        return tick;
+    }
 
-        for (size_t i = 0; i < cVec.size(); i++)
+    // Run the async clients of the Firebase service and return the number of clients that were processed.
+    static size_t staticLoop(const app_token_t *aToken, firebase_handle_t service_handle, uint32_t tick)
+    {
+        size_t count = 0;
+        // The client list is not copied, the service and its client list are looked up again for every client
+        // as they can be changed or destroyed by the result callback while processing.
+        for (size_t i = 0;; i++)
         {
-            AsyncClientClass *client = reinterpret_cast<AsyncClientClass *>(cVec[i]);
-            if (client)
-            {
-                // Store the auth time in all async clients.
-                // The auth time will be used to reconnect the Stream when auth changed.
-                if (aToken && aToken->auth_ts > 0 && aToken->authenticated)
-                    client->setAuthTs(aToken->auth_ts);
-                client->process(true);
-                client->handleRemove();
-            }
+            AppBase *service = handleRegistry().get<AppBase>(service_handle, handle_type_service);
+            if (!service || i >= service->cVec.size())
+                break;
+
+            // The destroyed client handle is no longer valid.
+            AsyncClientClass *client = handleRegistry().get<AsyncClientClass>(service->cVec[i], handle_type_client);
+            if (!client || client->loop_tick == tick)
+                continue;
+
+            client->loop_tick = tick;
+            // Store the auth time in all async clients.
+            // The auth time will be used to reconnect the Stream when auth changed.
+            if (aToken && aToken->auth_ts > 0 && aToken->authenticated)
+                client->setAuthTs(aToken->auth_ts);
+            client->process(true);
+            client->handleRemove();
+            count++;
         }
+        return count;
     }
 
 private:
-    // FirebaseApp address and FirebaseApp vector address
-    uint32_t app_addr = 0, avec_addr = 0, ul_dl_task_running_addr = 0, ota_storage_addr = 0, cvec_address_list_addr = 0, app_loop_count_addr = 0;
+    // The FirebaseApp handle, the pointers to FirebaseApp data are valid only when this handle is valid.
+    firebase_handle_t app_handle = 0;
+    ObjectHandle handle; // This service handle
+    bool *ul_dl_task_running = nullptr;
+    uint16_t *app_loop_count = nullptr;
+    std::vector<cvec_address_info_t> *cvec_address_list = nullptr;
+    uintptr_t ota_storage_addr = 0;
     Timer displayInfoTimer;
     app_token_t *app_token = nullptr;
     user_auth_data *user_auth = nullptr;
     String service_url;
-    std::vector<uint32_t> cVec; // AsyncClient vector
+    std::vector<firebase_handle_t> cVec; // AsyncClient handle vector
     URLUtil uut;
     StringUtil sut;
 
-    void setApp(uint32_t app_addr, auth_data_t *auth_data, uint32_t avec_addr, uint32_t ul_dl_task_running_addr, uint32_t cvec_address_list_addr, uint32_t app_loop_count_addr)
+    void setApp(firebase_handle_t app_handle, auth_data_t *auth_data, bool *ul_dl_task_running, std::vector<cvec_address_info_t> *cvec_address_list, uint16_t *app_loop_count)
     {
-        this->app_addr = app_addr;
+        this->app_handle = app_handle;
         this->app_token = &auth_data->app_token;
         this->user_auth = &auth_data->user_auth;
-        this->avec_addr = avec_addr; // AsyncClient vector (list) address
-        this->cvec_address_list_addr = cvec_address_list_addr;
-        this->app_loop_count_addr = app_loop_count_addr;
-        this->ul_dl_task_running_addr = ul_dl_task_running_addr;
+        this->cvec_address_list = cvec_address_list;
+        this->app_loop_count = app_loop_count;
+        this->ul_dl_task_running = ul_dl_task_running;
     }
 
-    app_token_t *appToken()
-    {
-        if (avec_addr > 0)
-        {
-            const std::vector<uint32_t> *aVec = reinterpret_cast<std::vector<uint32_t> *>(avec_addr);
-            List vec;
-            return vec.existed(*aVec, app_addr) ? app_token : nullptr;
-        }
-        return nullptr;
-    }
+    bool appExisted() const { return handleRegistry().isValid(app_handle, handle_type_app); }
+
+    app_token_t *appToken() { return appExisted() ? app_token : nullptr; }
+
+    bool *ulDlTaskRunning() { return appExisted() ? ul_dl_task_running : nullptr; }
 
     void url(const String &url) { this->service_url = url; }
 
     void resetAppImpl()
     {
-        if (this->app_addr && this->cvec_address_list_addr > 0)
-            removeCvecAddressList(reinterpret_cast<std::vector<cvec_address_info_t> *>(this->cvec_address_list_addr), this->app_addr);
-        this->app_addr = 0;
+        if (appExisted() && cvec_address_list)
+            removeCvecAddressList(cvec_address_list, handle.get(this, handle_type_service));
+        this->app_handle = 0;
         this->app_token = nullptr;
-        this->avec_addr = 0; // AsyncClient vector (list) address
-        this->ul_dl_task_running_addr = 0;
+        this->cvec_address_list = nullptr;
+        this->app_loop_count = nullptr;
+        this->ul_dl_task_running = nullptr;
     }
 
     void loopImpl()
@@ -111,19 +141,17 @@ private:
 
         if (displayInfoTimer.remaining() == 0 || !displayInfoTimer.isRunning())
         {
-            if (app_loop_count_addr && *reinterpret_cast<uint16_t *>(app_loop_count_addr) <= 1)
+            if (appExisted() && app_loop_count && *app_loop_count <= 1)
                 Serial.println("🔥 FirebaseApp::loop() or FirebaseApp::ready() has never been called.");
 
             displayInfoTimer.feed(60);
         }
 
-        staticLoop(appToken(), reinterpret_cast<uint32_t>(&cVec));
+        staticLoop(appToken(), handle.get(this, handle_type_service), beginLoop());
     }
 
 protected:
     void setResultUID(AsyncResult *aResult, const String &uid) { aResult->val[ares_ns::res_uid] = uid; }
-    void setRVec(AsyncResult *aResult, uint32_t addr) { aResult->rvec_addr = addr; }
-    std::vector<uint32_t> &getRVec(AsyncClientClass *aClient) { return aClient->getResultList(); }
     app_log_t *getAppDebug(AsyncClientClass *aClient) { return &aClient->getAppDebug(); }
     void resultSetDebug(AsyncResult *aResult, app_log_t *debug_log) { aResult->debug_log = debug_log; }
     void resultSetEvent(AsyncResult *aResult, app_log_t *event_log) { aResult->event_log = event_log; }
@@ -138,7 +166,9 @@ protected:
     AsyncResult *getResultBase(AsyncClientClass *aClient) { return aClient->getResult(); }
     void newRequestBase(AsyncClientClass *aClient, async_data *sData, const String &url, const String &path, const String &extras, reqns::http_request_method method, const slot_options_t &options, const String &uid, const String &etag) { aClient->newRequest(sData, url, path, extras, method, options, uid, etag); }
     void setAuthTsBase(AsyncClientClass *aClient, uint32_t ts) { aClient->auth_ts = ts; }
-    void addRemoveClientVecBase(AsyncClientClass *aClient, uint32_t cvec_addr, bool add) { aClient->addRemoveClientVec(cvec_addr, add); }
+    firebase_handle_t resultHandleBase(AsyncResult *aResult) { return aResult->handle(); }
+    firebase_handle_t clientHandleBase(AsyncClientClass *aClient) { return aClient->handle(); }
+    void addRemoveClientVecBase(AsyncClientClass *aClient, std::vector<firebase_handle_t> *cVec, bool add) { aClient->addRemoveClientVec(cVec, add); }
     void handleRemoveBase(AsyncClientClass *aClient) { aClient->handleRemove(); }
     void removeSlotBase(AsyncClientClass *aClient, uint8_t slot, bool sse = true) { aClient->removeSlot(slot, sse); }
     size_t slotCountBase(const AsyncClientClass *aClient) { return aClient->slotCount(); }
@@ -160,9 +190,13 @@ protected:
         aClient->process(async);
     }
     template <typename T>
-    uint32_t cVecAddr(T &app) { return reinterpret_cast<uint32_t>(&app.cVec); }
+    firebase_handle_t serviceHandle(T &app)
+    {
+        AppBase *service = &app;
+        return service->handle.get(service, handle_type_service);
+    }
     template <typename T>
-    void setAppBase(T &app, uint32_t app_addr, auth_data_t *auth_data, uint32_t avec_addr, uint32_t app_ota_status_addr, uint32_t cvec_address_list_addr, uint32_t app_loop_count_addr) { app.setApp(app_addr, auth_data, avec_addr, app_ota_status_addr, cvec_address_list_addr, app_loop_count_addr); }
+    void setAppBase(T &app, firebase_handle_t app_handle, auth_data_t *auth_data, bool *ul_dl_task_running, std::vector<cvec_address_info_t> *cvec_address_list, uint16_t *app_loop_count) { app.setApp(app_handle, auth_data, ul_dl_task_running, cvec_address_list, app_loop_count); }
 };
 
 #endif
\ No newline at end of file
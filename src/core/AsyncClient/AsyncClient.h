@@ -11,6 +11,8 @@
 #include "./core/Error.h"
 #include "./core/Utils/OTA.h"
 #include "./core/Utils/StringUtil.h"
+#include "./core/Utils/List.h"
+#include "./core/Utils/Handle.h"
 #include "./core/AsyncClient/SlotManager.h"
 #if defined(ENABLE_DATABASE)
 #define PUBLIC_DATABASE_RESULT_IMPL_BASE : public RTDBResultImpl
@@ -40,23 +42,41 @@ class AsyncClientClass PUBLIC_DATABASE_RESULT_IMPL_BASE
 private:
     StringUtil sut;
     URLUtil uut;
+    buffer_pool pool;
+#if defined(ENABLE_GZIP)
+    // The decoder of the gzip compressed responses, only one response is read at a time.
+    GzipDecoder gzip;
+#endif
     SlotManager sman;
-    String header, resETag;
-    uint32_t addr = 0, auth_ts = 0, cvec_addr = 0, sync_send_timeout_sec = 0, sync_read_timeout_sec = 0;
+    String resETag;
+    uint32_t auth_ts = 0, sync_send_timeout_sec = 0, sync_read_timeout_sec = 0;
+    ObjectHandle obj_handle;
     Memory mem;
     Base64Util b64ut;
     OTAUtil otaut;
     bool inProcess = false, inStopAsync = false;
+    uint8_t pipeline_depth = 0;
+    uint32_t loop_tick = 0; // The scheduler pass that this client was processed in.
 
     // Friends access
-    std::vector<uint32_t> &getResultList() { return sman.rVec; }
+    firebase_handle_t handle() { return obj_handle.get(this, handle_type_client); }
     app_log_t &getAppDebug() { return sman.debug_log; }
     app_log_t &getAppEvent() { return sman.event_log; }
     void stop() { sman.stop(); }
     void removeSlot(uint8_t slot, bool sse = true) { sman.removeSlot(slot, sse); }
     template <typename T>
     void setClientError(T &request, int code) { sman.setClientError(request, code); }
-    async_data *createSlot(slot_options_t &options) { return sman.createSlot(options); }
+    async_data *createSlot(slot_options_t &options)
+    {
+        async_data *sData = sman.createSlot(options);
+        if (sData)
+            sData->response.respCtx.pool = &pool;
+#if defined(ENABLE_GZIP)
+        if (sData)
+            sData->response.gzip = &gzip;
+#endif
+        return sData;
+    }
     void eventPushBack(int code, const String &msg) { sman.event_log.push_back(code, msg); }
     size_t slotCount() const { return sman.sVec.size(); }
     AsyncResult *getResult() { return sman.getResult(); }
@@ -100,6 +120,7 @@ private:
             (void)state;
             if (sData->request.base64)
             {
+                sData->request.b64enc.begin();
                 ret = sendImpl(sData, reinterpret_cast<const uint8_t *>("\""), 1, totalLen, astate_send_payload);
                 if (ret != ret_continue)
                     return ret;
@@ -126,7 +147,7 @@ private:
                     (int)(sData->request.file_data.data_size - sData->request.file_data.data_pos) < toSend)
                     toSend = sData->request.file_data.data_size - sData->request.file_data.data_pos;
 
-                buf = reinterpret_cast<uint8_t *>(mem.alloc(toSend));
+                buf = reinterpret_cast<uint8_t *>(pool.acquire(toSend));
 #if defined(ENABLE_FS)
                 if (sData->request.file_data.filename.length() > 0)
                 {
@@ -146,10 +167,19 @@ private:
                     sData->request.file_data.data_pos += toSend;
                 }
 
-                uint8_t *temp = reinterpret_cast<uint8_t *>(b64ut.encodeToChars(mem, buf, toSend));
-                mem.release(&buf);
-                toSend = strlen(reinterpret_cast<char *>(temp));
-                buf = temp;
+#if defined(ENABLE_FS)
+                bool last = sData->request.file_data.filename.length() > 0 ? !sData->request.file_data.file.available() : sData->request.file_data.data_pos >= sData->request.file_data.data_size;
+#else
+                bool last = sData->request.file_data.data_pos >= sData->request.file_data.data_size;
+#endif
+                // The chunk is encoded into the pooled buffer, the padding is added to the last chunk only.
+                char *temp = reinterpret_cast<char *>(pool.acquire(base64_encoder::outputLength(toSend), false));
+                size_t len = sData->request.b64enc.update(buf, toSend, temp);
+                if (last)
+                    len += sData->request.b64enc.finish(temp + len);
+                pool.release(&buf);
+                toSend = len;
+                buf = reinterpret_cast<uint8_t *>(temp);
             }
             else
             {
@@ -160,7 +190,7 @@ private:
 #endif
                     toSend = totalLen - sData->request.file_data.data_pos < FIREBASE_CHUNK_SIZE ? totalLen - sData->request.file_data.data_pos : FIREBASE_CHUNK_SIZE;
 
-                buf = reinterpret_cast<uint8_t *>(mem.alloc(toSend));
+                buf = reinterpret_cast<uint8_t *>(pool.acquire(toSend));
 
 #if defined(ENABLE_FS)
                 if (sData->request.file_data.filename.length() > 0)
@@ -180,7 +210,9 @@ private:
                 sData->request.file_data.data_pos += toSend;
             }
 
-            ret = sendImpl(sData, buf, toSend, totalLen, astate_send_payload);
+            // The read bytes may be kept by the Base64 encoder until the group is complete.
+            if (toSend > 0)
+                ret = sendImpl(sData, buf, toSend, totalLen, astate_send_payload);
         }
         else if (sData->request.base64)
             ret = sendImpl(sData, reinterpret_cast<const uint8_t *>("\""), 1, totalLen, astate_send_payload);
@@ -190,7 +222,7 @@ private:
 #endif
 
         if (buf)
-            mem.release(&buf);
+            pool.release(&buf);
 
         return ret;
     }
@@ -214,7 +246,7 @@ private:
         if (data && len && sman.client)
         {
             uint16_t toSend = len - sData->request.dataIndex > FIREBASE_CHUNK_SIZE ? FIREBASE_CHUNK_SIZE : len - sData->request.dataIndex;
-            size_t sent = sData->request.tcpWrite(data + sData->request.dataIndex, toSend);
+            size_t sent = sData->request.tcpWrite(data, sData->request.dataIndex, toSend);
             if (sent == toSend)
             {
                 sData->request.dataIndex += toSend;
@@ -323,7 +355,7 @@ private:
             // Stop the server connection when entering the initial/auth token request states or host, port, and SSE mode changes or session timed out.
             sman.newCon(sData, sData->request.getHost(true, &sData->response.val[resns::location]).c_str(), sData->request.port);
 
-            if ((sman.client_type == tcpc_sync && !sman.conn.isConnected()))
+            if ((sman.client_type == tcpc_sync && !sman.conn->isConnected()))
             {
                 if (sData->request.getHost(true, &sData->response.val[resns::location]).length() == 0)
                 {
@@ -341,21 +373,24 @@ private:
                 if (ret != ret_complete)
                     return sman.connErrorHandler(sData, sData->state);
 
-                sman.conn.sse = sData->sse;
-                sman.conn.async = sData->async;
+                sman.conn->sse = sData->sse;
+                sman.conn->async = sData->async;
                 sData->auth_ts = auth_ts;
             }
 
             if (sData->upload)
                 sData->upload_progress_enabled = false;
+
+            if (sData->download || sData->sse)
+                sData->request.removeExtrasHeaders();
+
             // Non-auth task header sending.
             if (!sData->auth_used && sData->request.app_token && sData->request.app_token->auth_data_type != user_auth_data_no_token)
             {
                 // Set the auth token to the end point uri or authorization header when it is available.
-                header = sData->request.val[reqns::header];
-                header.replace(FIREBASE_AUTH_PLACEHOLDER, sData->request.app_token->val[app_tk_ns::token]);
-                ret = sendHeader(sData, header.c_str());
-                sut.clear(header);
+                sData->request.setToken(&sData->request.app_token->val[app_tk_ns::token]);
+                ret = sendHeader(sData, reinterpret_cast<const uint8_t *>(sData->request.val[reqns::header].c_str()), sData->request.headerLength());
+                sData->request.setToken(nullptr);
                 return ret;
             }
             // Auth task header sending.
@@ -397,6 +432,15 @@ private:
         if (sData->response.httpCode == 0) // No responses.
             return ret_continue;
 
+#if defined(ENABLE_FIRESTORE)
+        // The next page of documents is requested by the same task.
+        if (sData->response.respCtx.stage == res_handler::response_stage_finished && sData->doc_stream.nextPage())
+        {
+            sData->state = astate_send_header;
+            return ret_continue;
+        }
+#endif
+
 #if defined(ENABLE_CLOUD_STORAGE)
         if (sData->request.file_data.resumable.isEnabled() && sData->request.file_data.resumable.getLocation().length() && sData->response.respCtx.stage == res_handler::response_stage_finished)
         {
@@ -455,6 +499,14 @@ private:
             readPayload(sData);
         }
 
+#if defined(ENABLE_FIRESTORE)
+        if (sData->doc_stream.isEnabled())
+            readDocuments(sData);
+#endif
+
+        if (sData->payload_sink)
+            writePayloadSink(sData);
+
         if (sData->response.respCtx.stage == res_handler::response_stage_finished)
         {
             // The payload stage ended by read timeout instead of the protocol
@@ -498,45 +550,161 @@ private:
             if (sData->request.method == reqns::http_post)
                 parseNodeName(&sData->aResult.rtdbResult);
 
-            // Data available from sse event
+            // Prevent sse timed out due to large sse Stream playload
+            // This is not prevent the timed out from user blocking code and delay.
             if (sData->response.flags.sse && payload->length())
-            {
+                feedSSETimer(&sData->aResult.rtdbResult);
+#endif
+        }
 
-                if (payload->indexOf("event: ") > -1 && payload->indexOf("data: ") > -1 && payload->indexOf("\n") > -1)
-                {
-                    // Prevent sse timed out due to large sse Stream playload
-                    // This is not prevent the timed out from user blocking code and delay.
-                    feedSSETimer(&sData->aResult.rtdbResult);
+#if defined(ENABLE_DATABASE)
+        // The complete events are dispatched even no new data was read.
+        if (sData->response.flags.sse && sData->response.val[resns::payload].length())
+            readSSE(sData);
+#endif
+        return true;
+    }
 
-                    uint32_t len = payload->length();
+#if defined(ENABLE_DATABASE)
+    // Dispatches the complete events from SSE Stream payload.
+    // All complete events will be sent to the result callback.
+    // Only one event per call will be set to the async result (which is polled) to prevent the unread event from overwriting.
+    void readSSE(async_data *sData)
+    {
+        String *payload = &sData->response.val[resns::payload];
+        sse_framer &es = sData->response.event_stream;
+        size_t len = 0;
 
-                    // The event data was received while more data (events) are available.
-                    bool partial = (*payload)[len - 1] == '\n' && ((len > 2 && (*payload)[len - 2] == '}') || (len > 3 && (*payload)[len - 3] == '}'));
+        while ((len = es.frame(*payload)) > 0)
+        {
+            setRefPayload(&sData->aResult.rtdbResult, payload);
+            setSSE(&sData->aResult.rtdbResult, es.event_p1, es.event_p2, es.data_p1, es.data_p2);
 
-                    if (((*payload)[len - 1] == '\n' && sData->response.tcpAvailable() == 0) || partial)
-                    {
-                        setRefPayload(&sData->aResult.rtdbResult, payload);
-                        parseSSE(&sData->aResult.rtdbResult);
+            if (sData->cache())
+                sData->rtdb_cache->apply(sData->request.val[reqns::path], sData->aResult.rtdbResult.event(), sData->aResult.rtdbResult.dataPath(), sData->aResult.rtdbResult.data());
 
-                        // Event filtering.
-                        if (sman.sseFilter(sData))
-                        {
-                            // save payload to slot result
-                            sData->aResult.setPayload(*payload);
-                            clear(*payload);
-                            sData->response.flags.payload_available = true;
-                            sman.returnResult(sData, true);
-                        }
-                        else
-                            clear(*payload);
+            if (sData->mux())
+                dispatchListeners(sData);
 
-                        sData->response.flags.http_response = false;
-                    }
-                }
+            // Event filtering.
+            bool dispatch = sman.sseFilter(sData);
+            if (dispatch)
+            {
+                // save event payload to slot result
+                if (len == payload->length())
+                    sData->aResult.setPayload(*payload);
+                else
+                    sData->aResult.setPayload(payload->substring(0, len));
+                es.keep();
             }
+            else
+            {
+                // The result keeps the last dispatched event and its offsets.
+                setRefPayload(&sData->aResult.rtdbResult, &sData->aResult.val[ares_ns::data_payload]);
+                if (es.isKept(sData->aResult.val[ares_ns::data_payload].length()))
+                    setSSE(&sData->aResult.rtdbResult, es.kept_event_p1, es.kept_event_p2, es.kept_data_p1, es.kept_data_p2);
+                else
+                    clearSSE(&sData->aResult.rtdbResult);
+            }
+
+            payload->remove(0, len);
+            es.consume(len);
+
+            if (dispatch)
+            {
+                sData->response.flags.payload_available = true;
+                sman.returnResult(sData, true);
+            }
+
+            sData->response.flags.http_response = false;
+
+            if (dispatch && !sData->cb)
+                break;
+        }
+    }
 #endif
+
+#if defined(ENABLE_DATABASE)
+    // Passes the Stream event to the multiplexer listeners, the data path and data are relative to the listener path.
+    void dispatchListeners(async_data *sData)
+    {
+        StreamMultiplexer *mux = sData->mux();
+        String event = sData->aResult.rtdbResult.event(), dataPath = sData->aResult.rtdbResult.dataPath(), data = sData->aResult.rtdbResult.data();
+
+        // The listeners can be added or removed, and the multiplexer can be destroyed by the callback,
+        // the listeners of this event are copied and the multiplexer is checked after every callback.
+        std::vector<stream_listener_t> listeners = mux->listeners;
+        for (size_t i = 0; i < listeners.size(); i++)
+        {
+            const stream_listener_t &listener = listeners[i];
+            String evt = event, path = dataPath, value = data;
+            if (!listener.cb || !mux->getEvent(listener, evt, path, value) || !sman.sseFilter(listener.filter, evt, sData->response.flags.http_response))
+                continue;
+
+            // The SSE frame of the listener event.
+            String payload = "event: ";
+            payload += evt;
+            int event_p1 = payload.length() - evt.length(), event_p2 = payload.length();
+            payload += "\ndata: ";
+            int data_p1 = payload.length();
+            payload += "{\"path\":\"";
+            payload += path;
+            payload += "\",\"data\":";
+            payload += value;
+            payload += '}';
+            int data_p2 = payload.length();
+            payload += "\n\n";
+
+            AsyncResult aResult;
+            aResult.setUID(listener.uid);
+            aResult.setPath(listener.path);
+            aResult.setPayload(payload);
+            setSSE(&aResult.rtdbResult, event_p1, event_p2, data_p1, data_p2);
+            listener.cb(aResult);
+
+            if (!(mux = sData->mux()))
+                break;
+        }
+    }
+#endif
+
+#if defined(ENABLE_FIRESTORE)
+    // Passes the documents of the payload data that was read to the document callback and keeps the payload string empty.
+    // When the response was read, the next page is requested or the documents count is set as the result payload.
+    // The HTTP error response payload is kept for the async result.
+    void readDocuments(async_data *sData)
+    {
+        if (sData->response.httpCode == 0 || sData->response.httpCode >= FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST)
+            return;
+
+        String *payload = &sData->response.val[resns::payload];
+        if (payload->length())
+        {
+            sData->doc_stream.feed(*payload, sData->aResult.uid());
+            clear(*payload);
+        }
+
+        if (sData->response.respCtx.stage == res_handler::response_stage_finished && !sData->doc_stream.endPage(sData->request.val[reqns::header]))
+            sData->doc_stream.getSummary(*payload);
+    }
+#endif
+
+    // Hands the payload data that was read to the payload sink and keeps the payload string empty.
+    // The HTTP error response payload is kept for the async result, the final call is made when the task was removed.
+    void writePayloadSink(async_data *sData)
+    {
+        if (sData->payload_sink_done || sData->upload || sData->download || sData->sse || sData->response.httpCode >= FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST)
+            return;
+
+        String *payload = &sData->response.val[resns::payload];
+        bool final = sData->response.respCtx.stage == res_handler::response_stage_finished;
+
+        if (payload->length() || final)
+        {
+            sData->payload_sink_done = final;
+            sData->payload_sink(sData->aResult, reinterpret_cast<const uint8_t *>(payload->c_str()), payload->length(), final);
+            clear(*payload);
         }
-        return true;
     }
 
     // Handles response header read process.
@@ -567,6 +735,14 @@ private:
 #endif
                 if (sData->request.method == reqns::http_delete && sData->response.httpCode == FIREBASE_ERROR_HTTP_CODE_NO_CONTENT)
                     sman.debug_log.push_back(-1, "Delete operation complete");
+
+                // The resumed download, the partial content continues from the range offset.
+                if (sData->download && sData->response.httpCode == FIREBASE_ERROR_HTTP_CODE_PARTIAL_CONTENT && sData->response.respCtx.stage == res_handler::response_stage_payload)
+                {
+                    sData->response.httpCode = FIREBASE_ERROR_HTTP_CODE_OK;
+                    sData->response.payloadLen += sData->request.resume.getOffset();
+                    sData->response.payloadRead = sData->request.resume.getOffset();
+                }
             }
         }
     }
@@ -592,7 +768,8 @@ private:
                     if (sData->response.payloadLen)
                     {
                         // At the beginning step, preparing file, tempolary blob data buffer and flash (OTA) to write.
-                        if (sData->response.payloadRead == 0)
+                        // The resumed download appends to the prepared output.
+                        if (sData->response.payloadRead == 0 && sData->request.resume.getOffset() == 0)
                         {
                             if (sData->request.ota)
                             {
@@ -645,7 +822,7 @@ private:
                             // if base64, skip the double quote at the beginning of string response payload (in Realtime Database)
                             ofs = sData->request.base64 && sData->response.payloadRead == 0 ? 1 : 0;
                             toRead = (int)(sData->response.payloadLen - sData->response.payloadRead) > FIREBASE_CHUNK_SIZE + ofs ? FIREBASE_CHUNK_SIZE + ofs : sData->response.payloadLen - sData->response.payloadRead;
-                            buf = reinterpret_cast<uint8_t *>(mem.alloc(toRead));
+                            buf = reinterpret_cast<uint8_t *>(pool.acquire(toRead));
                             read = sData->response.tcpRead(buf, toRead);
                         }
 
@@ -675,6 +852,7 @@ private:
                                     if (sData->request.ota_error != 0)
                                     {
                                         // OTA error.
+                                        otaut.abortDownloadOTA();
                                         sman.setAsyncError(sData, astate_read_response, sData->request.ota_error, !sData->sse, false);
                                         goto exit;
                                     }
@@ -708,11 +886,41 @@ private:
                             }
                             else // Raw byte array response payload
                             {
+                                // The data that was written before the download was resumed is skipped when the server ignored the range request.
+                                int skip = sData->request.resume.skipLength(sData->response.payloadRead - read, read);
+                                if (skip > 0)
+                                {
+                                    memmove(buf, buf + skip, read - skip);
+                                    read -= skip;
+                                }
+
+                                // The data is verified before the firmware is applied or the download is completed.
+                                if (sData->request.hash.isEnabled())
+                                {
+                                    sData->request.hash.update(buf, read);
+                                    if (sData->response.payloadRead == sData->response.payloadLen && !sData->request.hash.verify())
+                                    {
+#if defined(OTA_UPDATE_ENABLED) && defined(FIREBASE_OTA_UPDATER)
+                                        if (sData->request.ota)
+                                            otaut.abortDownloadOTA();
+#endif
+                                        sman.setAsyncError(sData, astate_read_response, FIREBASE_ERROR_DOWNLOAD_HASH_MISMATCH, !sData->sse, true);
+                                        goto exit;
+                                    }
+                                }
+
                                 // To write flash (OTA)
                                 if (sData->request.ota)
                                 {
 #if defined(OTA_UPDATE_ENABLED) && defined(FIREBASE_OTA_UPDATER)
-                                    b64ut.updateWrite(buf, read);
+                                    if (!b64ut.updateWrite(buf, read))
+                                    {
+                                        // The flash write error or the invalid delta OTA patch.
+                                        sData->request.ota_error = otaut.writeErrorCode();
+                                        otaut.abortDownloadOTA();
+                                        sman.setAsyncError(sData, astate_read_response, sData->request.ota_error, !sData->sse, false);
+                                        goto exit;
+                                    }
 
                                     if (sData->response.payloadRead == sData->response.payloadLen)
                                     {
@@ -752,14 +960,17 @@ private:
                         sman.returnResult(sData, false);
                     }
                 }
-                else
-                    sData->response.readPayload();
+                else if (!sData->response.readPayload())
+                {
+                    // Compressed payload decoding error.
+                    sman.setAsyncError(sData, astate_read_response, FIREBASE_ERROR_GZIP_DECODING, !sData->sse, false);
+                }
             }
         }
     exit:
 
         if (buf)
-            mem.release(&buf);
+            pool.release(&buf);
 
         if (sData->response.payloadLen > 0 && sData->response.payloadRead >= sData->response.payloadLen && sData->response.tcpAvailable() == 0)
         {
@@ -788,6 +999,9 @@ private:
 
             if (sData->response.httpCode == FIREBASE_ERROR_HTTP_CODE_OK && sData->download)
             {
+                // The downloaded payload is not read by the response handler, the response is finished here
+                // instead of waiting for the read timeout.
+                sData->response.respCtx.stage = res_handler::response_stage_finished;
                 sData->aResult.download_data.total = sData->response.payloadLen;
                 sData->aResult.download_data.downloaded = sData->response.payloadRead;
                 sman.returnResult(sData, false);
@@ -875,8 +1089,36 @@ private:
         return false;
     }
 
+    // Resumes the download that was interrupted by the connection drop or read time out with the byte-range request.
+    // The data that was read is kept in the file, blob or OTA updater.
+    bool resumeDownload(async_data *sData)
+    {
+        if (!sData->download || sData->request.base64 || !sData->request.resume.isEnabled() || sData->response.tcpAvailable() > 0 ||
+            sData->response.httpCode != FIREBASE_ERROR_HTTP_CODE_OK || sData->response.respCtx.stage != res_handler::response_stage_payload ||
+            sData->response.payloadRead == 0 || sData->response.payloadRead >= sData->response.payloadLen)
+            return false;
+
+        if (sData->response.read_timer.remaining() > 0 && sman.conn->isConnected())
+            return false;
+
+        if (!sData->request.resume.resume(sData->response.payloadRead))
+            return false;
+
+        sman.debug_log.push_back(-1, "Resuming the download...");
+        sman.stop();
+        sData->request.resume.setHeader(sData->request.val[reqns::header]);
+        // The response of the range request is read from its status line.
+        sData->response.respCtx.stage = res_handler::response_stage_undefined;
+        sData->state = astate_send_header;
+        sData->return_type = ret_continue;
+        return true;
+    }
+
     bool handleReadTimeout(async_data *sData)
     {
+        if (resumeDownload(sData))
+            return true;
+
         if (!sData->sse && sData->response.read_timer.remaining() == 0)
         {
             // TCP read error.
@@ -1005,21 +1247,37 @@ private:
 
     void setAuthTs(uint32_t ts) { auth_ts = ts; }
 
-    void addRemoveClientVec(uint32_t cvec_addr, bool add)
+    void addRemoveClientVec(std::vector<firebase_handle_t> *cVec, bool add)
     {
-        this->cvec_addr = cvec_addr;
-        if (cvec_addr > 0)
+        if (!cVec)
+            return;
+
+        // Remove the handles of destroyed clients.
+        for (int i = cVec->size() - 1; i >= 0; i--)
         {
-            std::vector<uint32_t> *cVec = reinterpret_cast<std::vector<uint32_t> *>(cvec_addr);
-            List v;
-            v.addRemoveList(*cVec, this->addr, add);
+            if (!handleRegistry().isValid((*cVec)[i], handle_type_client))
+                cVec->erase(cVec->begin() + i);
         }
+
+        List v;
+        v.addRemoveList(*cVec, handle(), add);
     }
 
     void exitProcess(bool status) { inProcess = status; }
 
     void process(bool async)
     {
+        // The sync download is resumed in place, the task is processed again until it was finished.
+        bool resume = false;
+        do
+            processTask(async, resume);
+        while (resume);
+    }
+
+    // Process the task of the first slot, the resume is set when the sync download should be resumed.
+    void processTask(bool async, bool &resume)
+    {
+        resume = false;
         if (processLocked())
             return;
 
@@ -1036,27 +1294,65 @@ private:
             sman.getResult()->dataLog().pop_front();
             sData->aResult.dataLog().pop_front();
 
-            if (!sData->auth_used && (sData->request.ota || sData->download || sData->upload) && sData->request.ul_dl_task_running_addr > 0)
-            {
-                bool *ul_dl_task_running = reinterpret_cast<bool *>(sData->request.ul_dl_task_running_addr);
-                *ul_dl_task_running = true;
-            }
+            if (!sData->auth_used && (sData->request.ota || sData->download || sData->upload) && sData->request.ul_dl_task_running)
+                *sData->request.ul_dl_task_running = true;
 
             if (sData->async && !async)
                 return exitProcess(false);
 
+            // The request is held to merge the subsequent requests.
+            if (sData->coalesce && sData->state == astate_undefined && millis() - sData->hold_ts < sData->hold_ms)
+                return exitProcess(false);
+
+            // Use the server connection that the task was used or the connection for its host.
+            // The task is refused when all pooled connections are carrying the Stream.
+            if (!sman.selectConn(sData))
+            {
+                sman.setAsyncError(sData, sData->state, FIREBASE_ERROR_NO_FREE_CONNECTION, !sData->sse, false);
+                if (sData->async)
+                    sman.returnResult(sData, false);
+                removeSlot(slot, false);
+                return exitProcess(false);
+            }
+
             // Restart connection when authenticate, client or network changed
-            if ((sData->sse && (sData->auth_ts != auth_ts || !sman.conn.isConnected())) || sman.conn.isChanged())
+            if ((sData->sse && (sData->auth_ts != auth_ts || !sman.conn->isConnected())) || sman.conn->isChanged())
             {
                 sman.stop();
+#if defined(ENABLE_DATABASE)
+                sman.releaseCache(sData);
+#endif
                 sData->state = astate_send_header;
             }
 
             // Resume incomplete async task from previously stopped.
-            if (!sman.conn.async && sData->async && !sData->complete)
+            if (!sman.conn->async && sData->async && !sData->complete)
             {
                 sData->state = astate_send_header;
-                sman.conn.async = sData->async;
+                sman.conn->async = sData->async;
+            }
+
+            if (sData->pipelined)
+            {
+                sData->pipelined = false;
+                // The pipelined request was sent on the server connection that was closed, send it again.
+                if (sData->conn_id != sman.conn->id || !sman.conn->isConnected())
+                {
+                    sData->state = astate_send_header;
+                    sData->response.respCtx.stage = res_handler::response_stage_undefined;
+                }
+                else // The response read time-out starts when this task becomes the running task.
+                    sData->response.feedTimer(sync_read_timeout_sec > 0 && !sData->async ? sync_read_timeout_sec : -1);
+            }
+
+            // Wait for the interval before resuming the download.
+            if (sData->request.resume.isResuming())
+            {
+                if (!sData->request.resume.ready() && sData->async)
+                    return exitProcess(false);
+                while (!sData->request.resume.ready())
+                    sys_idle();
+                sData->request.resume.setSent();
             }
 
             bool sending = false;
@@ -1090,6 +1386,9 @@ private:
                     return exitProcess(false);
             }
 
+            if (sData->state == astate_read_response && pipeline_depth > 1)
+                pipelineRequests(sData);
+
             sys_idle();
 
             if (sData->state == astate_read_response)
@@ -1148,7 +1447,7 @@ private:
                         sman.setAsyncError(sData, sData->state, sData->response.httpCode, !sData->sse, false);
                     }
 
-                    if (sData->async || sData->return_type == ret_failure)
+                    if (sData->async || sData->return_type == ret_failure || sData->request.resume.isResuming())
                         break;
                 }
             }
@@ -1165,26 +1464,97 @@ private:
                 sData->complete = true;
             }
 
+            resume = !sData->async && !sData->to_remove && sData->request.resume.isResuming();
+
             if (sData->to_remove)
                 removeSlot(slot);
         }
         exitProcess(false);
     }
 
-    FirebaseError *_lastError() { return &sman.lastErr; }
+    // Check whether the task's request can be pipelined.
+    // Only the async tasks with the idempotent request that its payload is in memory are allowed.
+    bool isPipelinable(const async_data *sData)
+    {
+#if defined(ENABLE_FIRESTORE)
+        // The task may request the next page on the connection.
+        if (sData->doc_stream.isEnabled())
+            return false;
+#endif
+        return sData->async && !sData->sse && !sData->auth_used && !sData->upload && !sData->download && !sData->request.ota &&
+               (sData->request.method == reqns::http_get || sData->request.method == reqns::http_put || sData->request.method == reqns::http_delete);
+    }
 
-public:
-    AsyncClientClass()
+    // Sends the requests of the queued tasks back-to-back on the keep-alive connection while the running task is waiting for its response.
+    // The responses are read in order when the tasks become the running task (slot 0).
+    void pipelineRequests(async_data *head)
     {
-        this->addr = reinterpret_cast<uint32_t>(this);
-        sman.client_type = tcpc_sync;
+        if (!isPipelinable(head) || !sman.conn->isConnected())
+            return;
+
+        uint8_t depth = 1;
+        for (size_t slot = 1; slot < slotCount() && depth < pipeline_depth; slot++)
+        {
+            async_data *sData = sman.getData(slot);
+            if (!sData || sData->to_remove || !isPipelinable(sData))
+                break;
+
+            if (sData->pipelined && sData->conn_id == sman.conn->id)
+            {
+                depth++;
+                continue;
+            }
+
+            // The request was sent on the server connection that was closed, send it again on this connection.
+            if (sData->pipelined)
+            {
+                sData->pipelined = false;
+                sData->state = astate_undefined;
+                sData->response.respCtx.stage = res_handler::response_stage_undefined;
+            }
+
+            if (sData->state != astate_undefined || !sman.isConnReusable(sData, sData->request.getHost(true).c_str(), sData->request.port))
+                break;
+
+            // Wait for the auth token.
+            if (sData->request.app_token && sData->request.app_token->auth_data_type != user_auth_data_no_token &&
+                sData->request.app_token->val[app_tk_ns::token].length() == 0)
+                break;
+
+            sData->response.clear();
+            sData->request.feedTimer();
+            sData->return_type = send(sData);
+
+            while ((sData->state == astate_send_header || sData->state == astate_send_payload) && sData->return_type != ret_failure)
+            {
+                sData->return_type = send(sData);
+                if (handleSendTimeout(sData))
+                    break;
+            }
+
+            if (sData->state != astate_read_response)
+            {
+                // Send error. The partially sent request breaks the pipeline, the sent requests will be sent again.
+                sman.stop();
+                break;
+            }
+
+            sData->pipelined = true;
+            sData->conn_id = sman.conn->id;
+            depth++;
+        }
     }
 
+    FirebaseError *_lastError() { return &sman.lastErr; }
+
+public:
+    AsyncClientClass() { sman.client_type = tcpc_sync; }
+
     explicit AsyncClientClass(Client &client) { setClient(client); }
 
     ~AsyncClientClass()
     {
-        sman.stop();
+        sman.stopAll();
         for (size_t i = 0; i < sman.sVec.size(); i++)
         {
             sman.reset(sman.getData(i), true);
@@ -1192,7 +1562,6 @@ public:
             delete sData;
             sData = nullptr;
         }
-        addRemoveClientVec(cvec_addr, false);
     }
 
     /**
@@ -1201,7 +1570,8 @@ public:
      */
     void setNetworkStatusCallback(AsyncClientNetworkStatusCallback cb)
     {
-        sman.conn.setNetworkStatusCallback(cb);
+        for (uint8_t i = 0; i < FIREBASE_CONNECTION_POOL_SIZE; i++)
+            sman.conns[i].setNetworkStatusCallback(cb);
     }
 
     /**
@@ -1215,7 +1585,7 @@ public:
     void setAsyncResult(AsyncResult &result)
     {
         sman.refResult = &result;
-        sman.result_addr = reinterpret_cast<uint32_t>(sman.refResult);
+        sman.result_handle = result.handle();
     }
 
     /**
@@ -1227,7 +1597,7 @@ public:
     void unsetAsyncResult()
     {
         sman.refResult = nullptr;
-        sman.result_addr = 0;
+        sman.result_handle = 0;
     }
 
     /**
@@ -1319,6 +1689,63 @@ public:
      */
     void setSSEFilters(const String &sse_events_filter) { sman.sse_events_filter = sse_events_filter; }
 
+    /**
+     * Set the maximum number of requests that are sent on the server connection before their responses were read (HTTP pipelining).
+     *
+     * @param depth The number of requests in flight including the running task. The value 0 or 1 disables the pipelining (default).
+     *
+     * The requests of queued async tasks are sent back-to-back while the running task is waiting for its response and
+     * the responses are read in order.
+     *
+     * Only the GET, PUT and DELETE requests of async tasks to the same host are pipelined.
+     * The Stream, file/BLOB upload and download, OTA and auth tasks are not pipelined.
+     *
+     * When the server connection was closed before all responses were read, the unanswered requests will be sent again.
+     */
+    void setPipelining(uint8_t depth) { pipeline_depth = depth; }
+
+    /**
+     * Get the scratch buffer pool usage.
+     *
+     * @return buffer_pool_stats_t The usage of the buffers that were kept by this async client for reading the response and
+     * sending and receiving the file/BLOB data chunks.
+     *
+     * The allocs is the number of heap allocations and the reused is the number of heap allocations that were avoided.
+     * The in_use and peak are the current and peak total size of pooled buffers in use in bytes.
+     * The reserved is the total size of pooled buffers in bytes.
+     */
+    buffer_pool_stats_t bufferPoolStats() const { return pool.stats(); }
+
+    /**
+     * Add the SSL client to the connection pool.
+     *
+     * @param client The SSL client.
+     * @return bool Returns true if the client was added.
+     *
+     * The async client keeps one server connection per SSL client. The task will use the open connection to its host
+     * or the idle connection instead of closing the connection of the other host, which avoids the reconnection (SSL handshake)
+     * when the tasks of different services e.g. Realtime database, Firestore and Storage are mixed.
+     * The Realtime database Stream also keeps its own connection.
+     *
+     * The SSL client that was set via the constructor or AsyncClientClass::setClient is the first client of the pool.
+     * The maximum number of clients is FIREBASE_CONNECTION_POOL_SIZE.
+     */
+    bool addClient(Client &client)
+    {
+        if (sman.conn_count >= FIREBASE_CONNECTION_POOL_SIZE)
+            return false;
+        sman.clients[sman.conn_count++] = &client;
+        return true;
+    }
+
+    /**
+     * Get the server connections usage.
+     *
+     * @return conn_pool_stats_t The numbers of server connections that were made, the connections that were made in place of
+     * the previous connection of the same SSL client (reconnects) and the requests that reused the open connection.
+     */
+    conn_pool_stats_t connectionStats() const { return sman.conn_stats; }
+
     /**
      * Set the SSL client.
      *
@@ -1327,8 +1754,8 @@ public:
     void setClient(Client &client)
     {
         sman.client = &client;
-        sman.conn.setClientChange();
-        this->addr = reinterpret_cast<uint32_t>(this);
+        sman.clients[0] = &client;
+        sman.conns[0].setClientChange();
         sman.client_type = tcpc_sync;
     }
 };
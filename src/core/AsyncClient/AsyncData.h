@@ -10,9 +10,26 @@
 #include "./core/AsyncClient/ConnectionHandler.h"
 #include "./core/AsyncClient/RequestHandler.h"
 #include "./core/AsyncClient/ResponseHandler.h"
+#include "./core/AsyncClient/DocumentStream.h"
+#include "./core/AsyncClient/RTDBCache.h"
+#include "./core/AsyncClient/StreamMultiplexer.h"
 #include "./core/AsyncResult/AsyncResult.h"
 #include "./core/AsyncClient/AsyncState.h"
 
+// The result of the task that was merged to another task, the result of that task is also delivered to it.
+struct async_result_target_t
+{
+    firebase_handle_t result_handle = 0;
+    AsyncResult *result = nullptr;
+    AsyncResultCallback cb = NULL;
+    String uid;
+    // The index of the task data in the merged request.
+    int index = -1;
+};
+
+// Get the result of the merged task at index from the result of the merged request.
+typedef void (*AsyncResultFilter)(AsyncResult &aResult, int index);
+
 struct async_data
 {
     friend class FirebaseApp;
@@ -30,32 +47,64 @@ public:
     res_handler response;
     async_error_t error;
     bool to_remove = false, auth_used = false, complete = false, async = false, stop_current_async = false, sse = false, path_not_existed = false;
-    bool download = false, upload_progress_enabled = false, upload = false;
-    uint32_t auth_ts = 0, addr = 0, ref_result_addr = 0;
+    bool download = false, upload_progress_enabled = false, upload = false, pipelined = false;
+    // The request that the subsequent requests can be merged to, it is held for hold_ms before sending.
+    bool coalesce = false;
+    unsigned long hold_ms = 0, hold_ts = 0;
+    String coalesce_query; // The query of the merged request, the requests with other query are not merged to it.
+    std::vector<async_result_target_t> targets;
+    AsyncResultFilter result_filter = NULL;
+    uint32_t auth_ts = 0, conn_id = 0;
+    firebase_handle_t ref_result_handle = 0;
     AsyncResult aResult;
     AsyncResult *refResult = nullptr;
     AsyncResultCallback cb = NULL;
+    AsyncPayloadSinkCallback payload_sink = NULL;
+    bool payload_sink_done = false;
+#if defined(ENABLE_FIRESTORE)
+    // The documents of runQuery and list response that are passed to the document callback.
+    document_stream doc_stream;
+#endif
+#if defined(ENABLE_DATABASE)
+    // The local cache that the Stream events are applied to.
+    rtdb_local_cache *rtdb_cache = nullptr;
+    firebase_handle_t rtdb_cache_handle = 0;
+    // The listeners that the Stream events are dispatched to.
+    StreamMultiplexer *stream_mux = nullptr;
+    firebase_handle_t stream_mux_handle = 0;
+#endif
     Timer err_timer;
 
-    async_data()
+    async_data() { err_timer.feed(0); }
+
+    void setRefResult(AsyncResult *refResult)
     {
-        addr = reinterpret_cast<uint32_t>(this);
-        err_timer.feed(0);
+        this->refResult = refResult;
+        ref_result_handle = refResult ? refResult->handle() : 0;
+        // The payload sink is the option of the request that was called with this async result.
+        payload_sink = refResult && !sse ? refResult->payload_sink : NULL;
     }
 
-    void setRefResult(AsyncResult *refResult, uint32_t rvec_addr)
+#if defined(ENABLE_DATABASE)
+    void setCache(rtdb_local_cache *cache)
     {
-        this->refResult = refResult;
-        ref_result_addr = reinterpret_cast<uint32_t>(refResult);
-        this->refResult->rvec_addr = rvec_addr;
-        if (rvec_addr > 0)
-        {
-            std::vector<uint32_t> *rVec = reinterpret_cast<std::vector<uint32_t> *>(rvec_addr);
-            List vec;
-            vec.addRemoveList(*rVec, ref_result_addr, true);
-        }
+        rtdb_cache = cache;
+        rtdb_cache_handle = cache ? cache->handle() : 0;
+    }
+
+    // The local cache, or nullptr when the RealtimeDatabase that owns it was destroyed while the Stream is running.
+    rtdb_local_cache *cache() const { return rtdb_cache && handleRegistry().isValid(rtdb_cache_handle, handle_type_cache) ? rtdb_cache : nullptr; }
+
+    void setMux(StreamMultiplexer *mux)
+    {
+        stream_mux = mux;
+        stream_mux_handle = mux ? mux->handle() : 0;
     }
 
+    // The Stream multiplexer, or nullptr when it was destroyed while the Stream is running.
+    StreamMultiplexer *mux() const { return stream_mux && handleRegistry().isValid(stream_mux_handle, handle_type_stream_mux) ? stream_mux : nullptr; }
+#endif
+
     void reset()
     {
         state = astate_undefined;
@@ -70,7 +119,25 @@ public:
         stop_current_async = false;
         sse = false;
         path_not_existed = false;
+        pipelined = false;
+        coalesce = false;
+        hold_ms = 0;
+        coalesce_query.remove(0, coalesce_query.length());
+        targets.clear();
+        result_filter = NULL;
+        conn_id = 0;
         cb = NULL;
+        payload_sink = NULL;
+        payload_sink_done = false;
+#if defined(ENABLE_FIRESTORE)
+        doc_stream.clear();
+#endif
+#if defined(ENABLE_DATABASE)
+        rtdb_cache = nullptr;
+        rtdb_cache_handle = 0;
+        stream_mux = nullptr;
+        stream_mux_handle = 0;
+#endif
         err_timer.reset();
     }
 };
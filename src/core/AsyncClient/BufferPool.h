@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_ASYNC_CLIENT_BUFFER_POOL_H
+#define CORE_ASYNC_CLIENT_BUFFER_POOL_H
+
+#include <Arduino.h>
+#include "./core/Utils/Memory.h"
+
+// The number of scratch buffers that are kept by the async client.
+#if !defined(FIREBASE_BUFFER_POOL_SIZE)
+#define FIREBASE_BUFFER_POOL_SIZE 4
+#endif
+
+// The largest scratch buffer size in bytes that is kept by the async client.
+// The larger buffer e.g. resumable upload chunk is allocated and freed as usual.
+#if !defined(FIREBASE_BUFFER_POOL_MAX_BLOCK_SIZE)
+#define FIREBASE_BUFFER_POOL_MAX_BLOCK_SIZE 2052
+#endif
+
+// The scratch buffer pool usage.
+struct buffer_pool_stats_t
+{
+    uint32_t allocs = 0;   // The number of heap allocations.
+    uint32_t reused = 0;   // The number of heap allocations that were avoided by reusing the pooled buffer.
+    uint32_t in_use = 0;   // The total size of pooled buffers in use in bytes.
+    uint32_t peak = 0;     // The peak total size of pooled buffers in use in bytes.
+    uint32_t reserved = 0; // The total size of pooled buffers in bytes.
+};
+
+// The scratch buffers that are owned by the async client for its life time.
+// The response read/header buffers and the upload/download chunk buffers are taken from
+// and returned to this pool instead of being allocated and freed for every response and chunk.
+struct buffer_pool
+{
+private:
+    struct block_t
+    {
+        uint8_t *ptr = nullptr;
+        size_t size = 0, len = 0;
+        bool used = false;
+    };
+
+    Memory mem;
+    block_t blocks[FIREBASE_BUFFER_POOL_SIZE];
+    buffer_pool_stats_t st;
+
+    void setUsage(size_t len)
+    {
+        st.in_use += len;
+        if (st.in_use > st.peak)
+            st.peak = st.in_use;
+    }
+
+public:
+    buffer_pool() {}
+
+    ~buffer_pool()
+    {
+        for (size_t i = 0; i < FIREBASE_BUFFER_POOL_SIZE; i++)
+            mem.release(&blocks[i].ptr);
+    }
+
+    // Get the buffer that can hold len bytes plus the null terminator.
+    void *acquire(size_t len, bool clear = true)
+    {
+        size_t size = mem.getReservedLen(len);
+        int fit = -1, spare = -1;
+
+        if (size <= FIREBASE_BUFFER_POOL_MAX_BLOCK_SIZE)
+        {
+            for (size_t i = 0; i < FIREBASE_BUFFER_POOL_SIZE; i++)
+            {
+                if (blocks[i].used)
+                    continue;
+                if (blocks[i].size >= size && (fit == -1 || blocks[i].size < blocks[fit].size))
+                    fit = i;
+                else if (blocks[i].size < size && (spare == -1 || blocks[i].size > blocks[spare].size))
+                    spare = i;
+            }
+        }
+
+        if (fit == -1 && spare > -1)
+        {
+            // Grow the largest free block that is too small.
+            uint8_t *p = reinterpret_cast<uint8_t *>(mem.reallocate(blocks[spare].ptr, size));
+            if (p)
+            {
+                st.reserved += size - blocks[spare].size;
+                blocks[spare].ptr = p;
+                blocks[spare].size = size;
+                fit = spare;
+                st.allocs++;
+            }
+        }
+        else if (fit > -1)
+            st.reused++;
+
+        if (fit == -1)
+        {
+            // Pool is full or the size is too large.
+            st.allocs++;
+            return mem.alloc(len, clear);
+        }
+
+        blocks[fit].used = true;
+        blocks[fit].len = size;
+        setUsage(size);
+        if (clear)
+            memset(blocks[fit].ptr, 0, size);
+        return blocks[fit].ptr;
+    }
+
+    // Return the buffer to the pool or free the buffer that is not pooled.
+    void release(void *ptr)
+    {
+        void **p = reinterpret_cast<void **>(ptr);
+        if (!*p)
+            return;
+
+        for (size_t i = 0; i < FIREBASE_BUFFER_POOL_SIZE; i++)
+        {
+            if (blocks[i].used && blocks[i].ptr == *p)
+            {
+                blocks[i].used = false;
+                st.in_use -= blocks[i].len;
+                *p = nullptr;
+                return;
+            }
+        }
+
+        // The buffer that is not pooled or was allocated by others e.g. base64 encoder.
+        mem.release(ptr);
+    }
+
+    buffer_pool_stats_t stats() const { return st; }
+};
+
+#endif
@@ -10,6 +10,17 @@
 #include <Arduino.h>
 #include <Client.h>
 #include "./core/AsyncResult/AppLog.h"
+#include "./core/Utils/Memory.h"
+#include "./core/Utils/Timer.h"
+
+#if !defined(FIREBASE_TCP_READ_BUFFER_SIZE)
+#define FIREBASE_TCP_READ_BUFFER_SIZE 512
+#endif
+
+// The maximum number of SSL clients (server connections) of the async client.
+#if !defined(FIREBASE_CONNECTION_POOL_SIZE)
+#define FIREBASE_CONNECTION_POOL_SIZE 4
+#endif
 
 typedef bool (*AsyncClientNetworkStatusCallback)();
 
@@ -42,6 +53,152 @@ namespace firebase_ns
 
 using namespace firebase_ns;
 
+// The read-ahead buffer of the server connection.
+// The response data is read from the client in blocks instead of byte by byte (which
+// goes through the SSL layer on every call) and kept here until it was consumed.
+// The buffered data belongs to the connection, not the task, it will be discarded
+// when the connection was closed.
+struct tcp_reader
+{
+private:
+    Memory mem;
+    uint8_t *buf = nullptr;
+    size_t pos = 0, len = 0;
+
+public:
+    const size_t bufSize = FIREBASE_TCP_READ_BUFFER_SIZE;
+    Client *client = nullptr;
+
+    tcp_reader() {}
+
+    ~tcp_reader() { mem.release(&buf); }
+
+    void setClient(Client *client)
+    {
+        if (this->client != client)
+            clear();
+        this->client = client;
+    }
+
+    // Discard the buffered data.
+    void clear()
+    {
+        pos = 0;
+        len = 0;
+    }
+
+    // Discard the buffered data and free the buffer.
+    void release()
+    {
+        clear();
+        mem.release(&buf);
+    }
+
+    // The number of buffered bytes that are not consumed.
+    size_t buffered() const { return len - pos; }
+
+    // Pointer to the first buffered byte that is not consumed.
+    const uint8_t *data() const { return buf + pos; }
+
+    void consume(size_t n)
+    {
+        pos += n < buffered() ? n : buffered();
+        if (pos == len)
+            clear();
+    }
+
+    // Read the available data from client into the free space of buffer.
+    // The limit (when > 0) is the maximum number of bytes to read from client.
+    // Returns the number of buffered bytes.
+    size_t fill(size_t limit = 0)
+    {
+        if (!client)
+            return buffered();
+
+        if (!buf)
+            buf = reinterpret_cast<uint8_t *>(mem.alloc(bufSize, false));
+
+        if (!buf)
+            return 0;
+
+        if (pos > 0 && pos == len)
+            clear();
+
+        int avail = client->available();
+        if (avail > 0 && len < bufSize)
+        {
+            // Move the remaining data to the front to get the contiguous free space.
+            if (pos > 0)
+            {
+                memmove(buf, buf + pos, len - pos);
+                len -= pos;
+                pos = 0;
+            }
+
+            size_t toRead = bufSize - len;
+            if ((size_t)avail < toRead)
+                toRead = avail;
+            if (limit > 0 && limit < toRead)
+                toRead = limit;
+
+            int read = client->read(buf + len, toRead);
+            if (read > 0)
+                len += read;
+        }
+        return buffered();
+    }
+
+    int available() { return buffered() + (client ? client->available() : 0); }
+
+    bool connected() { return client && client->connected(); }
+
+    int peek()
+    {
+        if (buffered())
+            return buf[pos];
+        return client ? client->peek() : -1;
+    }
+
+    int read()
+    {
+        if (buffered())
+        {
+            int c = buf[pos];
+            consume(1);
+            return c;
+        }
+        return client ? client->read() : -1;
+    }
+
+    // Read the buffered data first and then the data from client.
+    int read(uint8_t *dst, size_t size)
+    {
+        size_t n = buffered() < size ? buffered() : size;
+        if (n)
+        {
+            memcpy(dst, data(), n);
+            consume(n);
+        }
+
+        if (n < size && client && client->available())
+        {
+            int read = client->read(dst + n, size - n);
+            if (read > 0)
+                n += read;
+        }
+
+        return n > 0 ? (int)n : (client ? 0 : -1);
+    }
+};
+
+// The server connections usage of the async client.
+struct conn_pool_stats_t
+{
+    uint32_t connects = 0;   // The number of server connections that were made.
+    uint32_t reconnects = 0; // The number of server connections that were made in place of the previous connection of the same SSL client.
+    uint32_t reused = 0;     // The number of requests that reused the open server connection.
+};
+
 struct conn_handler : public ConnBase
 {
 private:
@@ -54,8 +211,12 @@ private:
 
 public:
     bool sse = false, async = false;
+    uint32_t id = 0; // The identifier of the current server connection which is unique in the async client.
+    uint32_t used_ms = 0;
+    Timer session_timer; // The session time-out of this server connection.
     String host;
     uint16_t port = 443;
+    tcp_reader reader;
 
     conn_handler() {}
 
@@ -64,6 +225,7 @@ public:
         this->client_type = client_type;
         this->client = client;
         this->debug_log = debug_log;
+        reader.setClient(client);
     }
 
     void setNetworkStatusCallback(AsyncClientNetworkStatusCallback cb)
@@ -90,6 +252,7 @@ public:
         }
 
         client->stop();
+        reader.clear();
         function_return_type ret = ret_failure;
         if (!isConnected() && client_type == tcpc_sync)
             ret = client->connect(host, port) > 0 ? ret_complete : ret_failure;
@@ -111,6 +274,7 @@ public:
             if (client)
                 client->stop();
         }
+        reader.release();
         reset();
     }
 
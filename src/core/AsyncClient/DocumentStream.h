@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_ASYNC_CLIENT_DOCUMENT_STREAM_H
+#define CORE_ASYNC_CLIENT_DOCUMENT_STREAM_H
+
+#include <Arduino.h>
+#include "./core/Utils/JSONTokenizer.h"
+#include "./core/Utils/URL.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+// The Firestore document that was read from the runQuery or list response.
+struct firestore_document_t
+{
+    String name;                   // The resource name of the document.
+    String fields;                 // The JSON object of the document fields.
+    String createTime, updateTime; // The time at which the document was created and last changed.
+    String readTime;               // The time at which the document was read (runQuery only).
+    String uid;                    // The UID of the async result of the task.
+    uint32_t index = 0;            // The position of the document in the results.
+};
+
+// The callback function that receives the document of runQuery or list response.
+typedef void (*FirestoreDocumentCallback)(firestore_document_t &document);
+
+// Frames the documents from the response payload chunks of runQuery (the array of RunQueryResponse objects)
+// and list (the documents array of ListDocumentsResponse object).
+// The document is passed to the callback as soon as its JSON object was read, only one document is kept in memory.
+// The list response members other than the documents are kept to get the next page token.
+struct document_stream
+{
+private:
+    FirestoreDocumentCallback cb = NULL;
+    bool paged = false, next_page = false, in_string = false, esc = false;
+    String element, outer;
+    uint32_t stack = 0; // The container types, the bit is set for object.
+    uint8_t depth = 0, elem_depth = 0;
+    uint32_t count = 0, pages = 0;
+
+    bool isObject() const { return depth > 0 && depth <= 32 && (stack >> (depth - 1)) & 1; }
+
+    // The depth of array that contains the documents.
+    uint8_t resultsDepth() const { return paged ? 2 : 1; }
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    void push(bool object)
+    {
+        if (depth < 32)
+        {
+            if (object)
+                stack |= (1UL << depth);
+            else
+                stack &= ~(1UL << depth);
+        }
+        depth++;
+    }
+
+    void emit(const String &uid)
+    {
+        firestore_document_t doc;
+        uint8_t d = paged ? 1 : 2;
+        json_field_t fields[5] = {json_field_t("name", d, &doc.name), json_field_t("fields", d, &doc.fields),
+                                  json_field_t("createTime", d, &doc.createTime), json_field_t("updateTime", d, &doc.updateTime),
+                                  json_field_t("readTime", 1, &doc.readTime)};
+        JSONTokenizer jt;
+        jt.begin(fields, paged ? 4 : 5);
+        jt.feed(element);
+        // The buffer is reused by the next document.
+        element.remove(0, element.length());
+
+        // The runQuery response that has no document e.g. the read time of empty result and skipped results.
+        if (doc.name.length() == 0)
+            return;
+
+        doc.index = count++;
+        doc.uid = uid;
+        cb(doc);
+    }
+
+    void put(char c, const String &uid)
+    {
+        bool capture = elem_depth > 0;
+        if (capture)
+            element += c;
+
+        if (in_string)
+        {
+            if (esc)
+                esc = false;
+            else if (c == '\\')
+                esc = true;
+            else if (c == '"')
+                in_string = false;
+            if (!capture)
+                outer += c;
+            return;
+        }
+
+        if (c == '"')
+            in_string = true;
+        else if (c == '{' || c == '[')
+        {
+            // The document object in the results array.
+            if (!capture && c == '{' && depth == resultsDepth() && !isObject())
+            {
+                element += c;
+                elem_depth = depth + 1;
+                capture = true;
+            }
+            push(c == '{');
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (depth > 0)
+                depth--;
+            if (capture && depth + 1 == elem_depth)
+            {
+                elem_depth = 0;
+                emit(uid);
+                return;
+            }
+        }
+        // The document separators are not kept.
+        else if (!capture && (isSpace(c) || (c == ',' && depth == resultsDepth() && !isObject())))
+            return;
+
+        if (!capture)
+            outer += c;
+    }
+
+    void resetPage()
+    {
+        element.remove(0, element.length());
+        outer.remove(0, outer.length());
+        stack = 0;
+        depth = 0;
+        elem_depth = 0;
+        in_string = false;
+        esc = false;
+    }
+
+public:
+    document_stream() {}
+
+    /**
+     * Start the documents streaming.
+     *
+     * @param cb The document callback.
+     * @param paged The list response that its next pages will be requested.
+     */
+    void begin(FirestoreDocumentCallback cb, bool paged)
+    {
+        clear();
+        this->cb = cb;
+        this->paged = paged;
+    }
+
+    bool isEnabled() const { return cb != NULL; }
+
+    // Read the payload chunk.
+    void feed(const String &data, const String &uid)
+    {
+        for (size_t i = 0; i < data.length(); i++)
+            put(data[i], uid);
+    }
+
+    // The response of the page was read, the request header is changed to request the next page if the response has the next page token.
+    // Returns true when the next page will be requested.
+    bool endPage(String &header)
+    {
+        if (next_page)
+            return true;
+
+        String token;
+        if (paged)
+        {
+            json_field_t field("nextPageToken", 1, &token);
+            JSONTokenizer jt;
+            jt.begin(&field, 1);
+            jt.feed(outer);
+        }
+        resetPage();
+        pages++;
+
+        int end = header.indexOf(" HTTP/1.1\r\n");
+        if (token.length() == 0 || end < 0)
+            return false;
+
+        String target = header.substring(0, end);
+
+        // Remove the page token of the previous page request.
+        int p = target.indexOf("?pageToken=");
+        if (p < 0)
+            p = target.indexOf("&pageToken=");
+        if (p > -1)
+        {
+            int q = target.indexOf('&', p + 1);
+            if (q < 0)
+                target.remove(p);
+            else
+                target.remove(p + 1, q - p);
+        }
+
+        URLUtil uut;
+        target += target.indexOf('?') > -1 ? '&' : '?';
+        target += "pageToken=";
+        target += uut.encode(token);
+        header = target + header.substring(end);
+        next_page = true;
+        return true;
+    }
+
+    // Returns true when the next page was requested, the request should be sent again.
+    bool nextPage()
+    {
+        bool ret = next_page;
+        next_page = false;
+        return ret;
+    }
+
+    // The result payload of the completed task.
+    void getSummary(String &payload)
+    {
+        payload = "{\"documentCount\":";
+        payload += count;
+        if (paged)
+        {
+            payload += ",\"pageCount\":";
+            payload += pages;
+        }
+        payload += '}';
+    }
+
+    void clear()
+    {
+        resetPage();
+        cb = NULL;
+        paged = false;
+        next_page = false;
+        count = 0;
+        pages = 0;
+    }
+};
+
+#endif
+#endif
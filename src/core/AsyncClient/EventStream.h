@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_ASYNC_CLIENT_EVENT_STREAM_H
+#define CORE_ASYNC_CLIENT_EVENT_STREAM_H
+
+#include <Arduino.h>
+
+// The incremental text/event-stream (SSE) framer.
+// The stream data is appended to the payload string as it arrives and the framer scans only
+// the bytes that were not scanned yet. The complete event (terminated by a blank line) is
+// found at the beginning of the payload string, the event and data field values are kept
+// as the offsets in that event, no field value string is created.
+struct sse_framer
+{
+public:
+    // The offsets of event field value and data field value in the event.
+    // The multi-line data is given as the range from the first to the last data line.
+    int event_p1 = -1, event_p2 = -1, data_p1 = -1, data_p2 = -1;
+    // The offsets of the last dispatched event which is kept as the result payload.
+    int kept_event_p1 = -1, kept_event_p2 = -1, kept_data_p1 = -1, kept_data_p2 = -1;
+
+    sse_framer() {}
+
+    // The current event was dispatched, its offsets are kept for the result payload.
+    void keep()
+    {
+        kept_event_p1 = event_p1;
+        kept_event_p2 = event_p2;
+        kept_data_p1 = data_p1;
+        kept_data_p2 = data_p2;
+    }
+
+    // The kept offsets are in the result payload of this length.
+    bool isKept(size_t len) const { return kept_event_p2 <= (int)len && kept_data_p2 <= (int)len; }
+
+    void clear()
+    {
+        scan = 0;
+        line = 0;
+        event_p1 = -1;
+        event_p2 = -1;
+        data_p1 = -1;
+        data_p2 = -1;
+        kept_event_p1 = -1;
+        kept_event_p2 = -1;
+        kept_data_p1 = -1;
+        kept_data_p2 = -1;
+    }
+
+    // Scans the new data in buf and returns the length of the complete event at the beginning of buf,
+    // or 0 when the event is not complete yet.
+    // The event should be removed from buf with consume() before the next call.
+    size_t frame(const String &buf)
+    {
+        const char *s = buf.c_str();
+        size_t len = buf.length();
+
+        while (scan < len)
+        {
+            const char *nl = reinterpret_cast<const char *>(memchr(s + scan, '\n', len - scan));
+            if (!nl)
+            {
+                scan = len;
+                break;
+            }
+
+            size_t end = nl - s;
+            scan = end + 1;
+
+            // Line without the CR.
+            size_t lineEnd = end > line && s[end - 1] == '\r' ? end - 1 : end;
+
+            // Blank line, dispatch the event.
+            // The blank lines before any field (keep-alive bytes) are skipped as a part of this event.
+            if (lineEnd == line)
+            {
+                if (event_p1 > -1 || data_p1 > -1)
+                    return scan;
+                line = scan;
+                continue;
+            }
+
+            parseLine(s, line, lineEnd);
+            line = scan;
+        }
+        return 0;
+    }
+
+    // Resets the framer state after the event of length len was removed from the beginning of the buffer.
+    void consume(size_t len)
+    {
+        scan = scan > len ? scan - len : 0;
+        line = line > len ? line - len : 0;
+        event_p1 = -1;
+        event_p2 = -1;
+        data_p1 = -1;
+        data_p2 = -1;
+    }
+
+private:
+    size_t scan = 0, line = 0;
+
+    void parseLine(const char *s, size_t p1, size_t p2)
+    {
+        // Comment line.
+        if (s[p1] == ':')
+            return;
+
+        const char *colon = reinterpret_cast<const char *>(memchr(s + p1, ':', p2 - p1));
+        size_t nameLen = colon ? colon - (s + p1) : p2 - p1;
+        size_t value = colon ? colon - s + 1 : p2;
+
+        if (value < p2 && s[value] == ' ')
+            value++;
+
+        if (nameLen == 5 && memcmp(s + p1, "event", 5) == 0)
+        {
+            event_p1 = value;
+            event_p2 = p2;
+        }
+        else if (nameLen == 4 && memcmp(s + p1, "data", 4) == 0)
+        {
+            if (data_p1 == -1)
+                data_p1 = value;
+            data_p2 = p2;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,511 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_ASYNC_CLIENT_RTDB_CACHE_H
+#define CORE_ASYNC_CLIENT_RTDB_CACHE_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./core/Utils/JSONPath.h"
+#include "./core/Utils/Handle.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The default maximum memory in bytes that is used by the Realtime database local cache.
+#if !defined(FIREBASE_RTDB_CACHE_SIZE)
+#define FIREBASE_RTDB_CACHE_SIZE 4096
+#endif
+
+// The Realtime database local cache stats.
+struct rtdb_cache_stats_t
+{
+    uint32_t hits = 0;      // The number of get calls that were served from the cache.
+    uint32_t misses = 0;    // The number of get calls that were sent to the server.
+    uint32_t evictions = 0; // The number of nodes that were removed to keep the cache size.
+    size_t size = 0;        // The memory used by the cached nodes in bytes (approximate).
+    size_t nodes = 0;       // The number of cached nodes.
+};
+
+// The node of the cache tree, the key is the path segment.
+struct rtdb_cache_node
+{
+    String key;
+    String value; // The JSON text of the primitive value.
+    rtdb_cache_node *parent = nullptr;
+    std::vector<rtdb_cache_node *> children;
+    uint32_t used = 0;     // The last access tick.
+    bool complete = false; // The whole value at this node is known.
+    bool array = false;    // The value was the JSON array.
+};
+
+// The path-indexed tree of the data that was received from the Stream put and patch events.
+// The get request of the path that is under the path of an active Stream is served from the cache when the whole
+// value at that path is known. The least recently used nodes are removed when the cache size exceeds the limit.
+class rtdb_local_cache
+{
+private:
+    rtdb_cache_node root;
+    std::vector<String> roots; // The paths of the Streams that their data are kept in sync.
+    rtdb_cache_stats_t stats;
+    size_t limit = FIREBASE_RTDB_CACHE_SIZE;
+    uint32_t tick = 0;
+    bool enabled = false;
+    firebase_ns::ObjectHandle obj_handle;
+
+    static size_t nodeSize(const rtdb_cache_node *node) { return sizeof(rtdb_cache_node) + node->key.length() + node->value.length(); }
+
+    // Get the next path segment from position p.
+    static bool nextSegment(const String &path, int &p, String &seg)
+    {
+        if (p >= (int)path.length())
+            return false;
+        int q = path.indexOf('/', p);
+        if (q < 0)
+            q = path.length();
+        seg = path.substring(p, q);
+        p = q + 1;
+        return true;
+    }
+
+    rtdb_cache_node *findChild(rtdb_cache_node *node, const String &key)
+    {
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (node->children[i]->key == key)
+                return node->children[i];
+        }
+        return nullptr;
+    }
+
+    rtdb_cache_node *addChild(rtdb_cache_node *node, const String &key)
+    {
+        rtdb_cache_node *child = new rtdb_cache_node();
+        child->key = key;
+        child->parent = node;
+        child->complete = node->complete;
+        child->used = tick;
+        node->children.push_back(child);
+        stats.size += nodeSize(child);
+        stats.nodes++;
+        return child;
+    }
+
+    void setValue(rtdb_cache_node *node, const String &value)
+    {
+        stats.size -= node->value.length();
+        node->value = value;
+        stats.size += node->value.length();
+    }
+
+    void clearChildren(rtdb_cache_node *node)
+    {
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            clearChildren(node->children[i]);
+            stats.size -= nodeSize(node->children[i]);
+            stats.nodes--;
+            delete node->children[i];
+        }
+        node->children.clear();
+    }
+
+    void removeNode(rtdb_cache_node *node)
+    {
+        rtdb_cache_node *parent = node->parent;
+        clearChildren(node);
+        for (size_t i = 0; i < parent->children.size(); i++)
+        {
+            if (parent->children[i] == node)
+            {
+                parent->children.erase(parent->children.begin() + i);
+                break;
+            }
+        }
+        stats.size -= nodeSize(node);
+        stats.nodes--;
+        delete node;
+    }
+
+    static bool isNull(const rtdb_cache_node *node) { return node->value.length() == 0 && node->children.size() == 0; }
+
+    // The null node is not kept when its parent is complete, its absence means null.
+    void prune(rtdb_cache_node *node)
+    {
+        while (node->parent && node->parent->complete && isNull(node))
+        {
+            rtdb_cache_node *parent = node->parent;
+            removeNode(node);
+            node = parent;
+        }
+    }
+
+    // Parse the JSON value into the node, the null members are kept only when keepNull is set (the patch data).
+    bool parse(const char *s, size_t &i, rtdb_cache_node *node, uint8_t depth, bool keepNull = false)
+    {
+        JSONPathUtil::skipSpace(s, i);
+        if (s[i] == '{' || s[i] == '[')
+        {
+            // The Realtime database limits the depth of data to 32 levels.
+            if (depth > 32)
+                return false;
+            bool object = s[i++] == '{';
+            node->array = !object;
+            for (int n = 0;; n++)
+            {
+                JSONPathUtil::skipSpace(s, i);
+                if (s[i] == (object ? '}' : ']'))
+                {
+                    i++;
+                    return true;
+                }
+                String key;
+                if (object)
+                {
+                    size_t k = i;
+                    if (s[i] != '"' || !JSONPathUtil::skipString(s, i))
+                        return false;
+                    key = String(s + k + 1).substring(0, i - k - 2);
+                    JSONPathUtil::skipSpace(s, i);
+                    if (s[i++] != ':')
+                        return false;
+                }
+                else
+                    key = String(n);
+
+                rtdb_cache_node *child = addChild(node, key);
+                if (!parse(s, i, child, depth + 1))
+                    return false;
+                // The null member or element.
+                if (!keepNull && isNull(child))
+                    removeNode(child);
+
+                JSONPathUtil::skipSpace(s, i);
+                if (s[i] == ',')
+                    i++;
+                else if (s[i] != (object ? '}' : ']'))
+                    return false;
+            }
+        }
+
+        size_t v = i;
+        if (s[i] == '"')
+        {
+            if (!JSONPathUtil::skipString(s, i))
+                return false;
+        }
+        else
+        {
+            while (s[i] && s[i] != ',' && s[i] != '}' && s[i] != ']' && s[i] != ' ' && s[i] != '\t' && s[i] != '\r' && s[i] != '\n')
+                i++;
+        }
+
+        if (i == v)
+            return false;
+
+        String value = String(s + v).substring(0, i - v);
+        if (value != "null")
+            setValue(node, value);
+        return true;
+    }
+
+    // Set the value at path.
+    void set(const String &path, const char *json)
+    {
+        rtdb_cache_node *node = &root;
+        String seg;
+        int p = 0;
+        while (nextSegment(path, p, seg))
+        {
+            rtdb_cache_node *child = findChild(node, seg);
+            if (!child)
+            {
+                // The primitive value is replaced by the object.
+                setValue(node, "");
+                child = addChild(node, seg);
+            }
+            child->used = tick;
+            node = child;
+        }
+
+        clearChildren(node);
+        setValue(node, "");
+        node->array = false;
+        node->complete = true;
+        size_t i = 0;
+        if (!parse(json, i, node, 0))
+        {
+            // The data that can't be parsed is not cached.
+            clearChildren(node);
+            setValue(node, "");
+            node->complete = false;
+            invalidate(node);
+        }
+        prune(node);
+    }
+
+    // The ancestors of the node that its data was removed are not complete.
+    void invalidate(rtdb_cache_node *node)
+    {
+        for (rtdb_cache_node *n = node; n; n = n->parent)
+            n->complete = false;
+    }
+
+    // Find the least recently used node, the ancestor is taken before its descendants.
+    void findLRU(rtdb_cache_node *node, rtdb_cache_node *&lru)
+    {
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (!lru || node->children[i]->used < lru->used)
+                lru = node->children[i];
+            findLRU(node->children[i], lru);
+        }
+    }
+
+    void evict()
+    {
+        while (stats.size > limit)
+        {
+            rtdb_cache_node *lru = nullptr;
+            findLRU(&root, lru);
+            if (!lru)
+                break;
+            rtdb_cache_node *parent = lru->parent;
+            stats.evictions += 1;
+            removeNode(lru);
+            invalidate(parent);
+        }
+    }
+
+    bool isArray(const rtdb_cache_node *node)
+    {
+        if (!node->array)
+            return false;
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (node->children[i]->key != String(i))
+                return false;
+        }
+        return true;
+    }
+
+    void toJSON(rtdb_cache_node *node, String &out)
+    {
+        node->used = tick;
+        if (node->value.length())
+        {
+            out += node->value;
+            return;
+        }
+
+        if (node->children.size() == 0)
+        {
+            out += "null";
+            return;
+        }
+
+        bool array = isArray(node);
+        out += array ? '[' : '{';
+        for (size_t i = 0; i < node->children.size(); i++)
+        {
+            if (i > 0)
+                out += ',';
+            if (!array)
+            {
+                out += '"';
+                out += node->children[i]->key;
+                out += "\":";
+            }
+            toJSON(node->children[i], out);
+        }
+        out += array ? ']' : '}';
+    }
+
+    bool isCovered(const String &path)
+    {
+        for (size_t i = 0; i < roots.size(); i++)
+        {
+            if (JSONPathUtil::isAncestor(roots[i], path))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    rtdb_local_cache() {}
+    ~rtdb_local_cache() { clear(); }
+
+    // The handle that the Stream task keeps to check that the cache still exists.
+    firebase_ns::firebase_handle_t handle() { return obj_handle.get(this, firebase_ns::handle_type_cache); }
+
+    /**
+     * Enable the cache.
+     *
+     * @param enable The option to keep the Stream data in the cache.
+     * @param limit The maximum memory in bytes that is used by the cache.
+     */
+    void begin(bool enable, size_t limit)
+    {
+        clear();
+        enabled = enable;
+        this->limit = limit;
+    }
+
+    // Apply the Stream event of the Stream at path.
+    void apply(const String &path, const String &event, const String &dataPath, const String &data)
+    {
+        if (!enabled)
+            return;
+
+        String streamPath = JSONPathUtil::normalize(path), location = JSONPathUtil::join(streamPath, JSONPathUtil::normalize(dataPath));
+        tick++;
+
+        if (event == "put")
+        {
+            // The first event of the Stream is the whole data at the Stream path.
+            if (location == streamPath && !isCovered(streamPath))
+                roots.push_back(streamPath);
+            set(location, data.c_str());
+        }
+        else if (event == "patch")
+        {
+            // The patch data is the object of the children to update.
+            rtdb_cache_node temp;
+            size_t i = 0;
+            if (parse(data.c_str(), i, &temp, 0, true) && !temp.array)
+            {
+                for (size_t j = 0; j < temp.children.size(); j++)
+                {
+                    String value;
+                    toJSON(temp.children[j], value);
+                    set(JSONPathUtil::join(location, JSONPathUtil::normalize(temp.children[j]->key)), value.c_str());
+                }
+            }
+            else
+                removeRoot(streamPath);
+            clearChildren(&temp);
+        }
+        else if (event == "cancel" || event == "auth_revoked")
+            removeRoot(streamPath);
+
+        evict();
+    }
+
+    // The data of the Stream at path is no longer kept in sync.
+    void removeRoot(const String &path)
+    {
+        String streamPath = JSONPathUtil::normalize(path);
+        bool found = false;
+        for (size_t i = 0; i < roots.size(); i++)
+        {
+            if (roots[i] == streamPath)
+            {
+                roots.erase(roots.begin() + i);
+                found = true;
+                break;
+            }
+        }
+
+        // The data is kept when it is also kept in sync by another Stream.
+        if (!found || isCovered(streamPath))
+            return;
+
+        // The Streams at the descendant paths are removed with the data.
+        for (size_t i = 0; i < roots.size();)
+        {
+            if (JSONPathUtil::isAncestor(streamPath, roots[i]))
+                roots.erase(roots.begin() + i);
+            else
+                i++;
+        }
+
+        rtdb_cache_node *node = &root;
+        String seg;
+        int p = 0;
+        while (node && nextSegment(streamPath, p, seg))
+            node = findChild(node, seg);
+
+        if (!node)
+            return;
+
+        if (node == &root)
+        {
+            clearChildren(&root);
+            setValue(&root, "");
+            root.complete = false;
+        }
+        else
+        {
+            rtdb_cache_node *parent = node->parent;
+            removeNode(node);
+            invalidate(parent);
+        }
+    }
+
+    /**
+     * Get the cached value.
+     *
+     * @param path The node path.
+     * @param value The JSON text of the value.
+     * @return bool Returns true if the whole value at path is in the cache and it is kept in sync by the Stream.
+     */
+    bool get(const String &path, String &value)
+    {
+        if (!enabled)
+            return false;
+
+        String location = JSONPathUtil::normalize(path);
+        rtdb_cache_node *node = &root;
+        bool hit = isCovered(location);
+        String seg;
+        int p = 0;
+        tick++;
+        while (hit && nextSegment(location, p, seg))
+        {
+            node->used = tick;
+            rtdb_cache_node *child = findChild(node, seg);
+            if (!child)
+            {
+                // The child of the known value does not exist.
+                hit = node->complete;
+                node = nullptr;
+                break;
+            }
+            node = child;
+        }
+
+        if (hit && node)
+            hit = node->complete;
+
+        if (!hit)
+        {
+            stats.misses++;
+            return false;
+        }
+
+        stats.hits++;
+        value.remove(0, value.length());
+        if (node)
+            toJSON(node, value);
+        else
+            value = "null";
+        return true;
+    }
+
+    rtdb_cache_stats_t getStats() const { return stats; }
+
+    void clear()
+    {
+        clearChildren(&root);
+        setValue(&root, "");
+        root.complete = false;
+        roots.clear();
+        stats.size = 0;
+        stats.nodes = 0;
+    }
+};
+
+#endif
+#endif
@@ -10,10 +10,12 @@
 #include <Arduino.h>
 #include <Client.h>
 #include "./core/File/FileConfig.h"
+#include "./core/File/ResumableDownload.h"
 #include "./core/Utils/Timer.h"
 #include "./core/Utils/StringUtil.h"
 #include "./core/Utils/URL.h"
 #include "./core/Utils/Base64.h"
+#include "./core/Utils/Hash.h"
 #include "./core/AsyncClient/ConnectionHandler.h"
 #include "./core/Auth/Token/AppToken.h"
 
@@ -23,13 +25,8 @@
 #endif
 #endif
 
-#if defined(ENABLE_GZIP) && defined(FIREBASE_GZIP_LIB)
-#include <stdlib.h>
-#include <stdio.h>
-extern "C"
-{
-    #include FIREBASE_GZIP_LIB
-}
+// The gzip compressed response payload will be decoded by GzipDecoder (core/Utils/Gzip.h).
+#if defined(ENABLE_GZIP)
 #define EXTRAS_HEADERS "Accept-Encoding: gzip\r\n"
 #else
 #define EXTRAS_HEADERS ""
@@ -79,14 +76,26 @@ public:
     file_config_data file_data;
     bool base64 = false, ota = false, connected = false;
     int command = 0;
-    uint32_t ul_dl_task_running_addr = 0, ota_storage_addr = 0, payloadLen = 0;
+    bool *ul_dl_task_running = nullptr;
+    uintptr_t ota_storage_addr = 0;
+    uint32_t payloadLen = 0;
     uint32_t dataLen = 0, payloadIndex = 0;
     uint16_t dataIndex = 0;
     int8_t b64Pad = 0;
     int16_t ota_error = 0;
+    // The file/blob data is Base64 encoded in chunks, the bytes of incomplete group are kept for the next chunk.
+    base64_encoder b64enc;
+    // The optional digest of the downloaded data.
+    hash_verifier hash;
+    // The byte-range resume of the interrupted download.
+    file_download_resumable_data resume;
     reqns::http_request_method method = reqns::http_undefined;
     Timer send_timer;
 
+    // The auth token that will be written in place of the placeholder in the header.
+    const String *token = nullptr;
+    int token_pos = -1;
+
     tcp_client_type client_type = tcpc_sync;
     Client *client = nullptr;
 
@@ -113,12 +122,23 @@ public:
         dataLen = 0;
         payloadIndex = 0;
         dataIndex = 0;
+        token = nullptr;
+        token_pos = -1;
         b64Pad = 0;
         ota_error = 0;
+        hash.clear();
+        resume.clear();
         method = reqns::http_undefined;
     }
 
     void addNewLine() { val[reqns::header] += "\r\n"; }
+    // The payload of download task is written as it is to file, blob or flash and the Stream connection is kept by its task,
+    // the compressed payload is not accepted.
+    void removeExtrasHeaders()
+    {
+        if (strlen(EXTRAS_HEADERS))
+            val[reqns::header].replace(EXTRAS_HEADERS, "");
+    }
     void addHostHeader(const String &host) { sut.printTo(val[reqns::header], host.length() + String(EXTRAS_HEADERS).length(), "Host: %s\r\n%s", host.c_str(), EXTRAS_HEADERS); }
     void addConnectionHeader(bool keepAlive) { sut.printTo(val[reqns::header], 50, "Connection: %s\r\n", keepAlive ? "keep-alive" : "close"); }
     void addContentType(const String &type) { sut.printTo(val[reqns::header], type.length(), "Content-Type: %s\r\n", type.c_str()); }
@@ -181,6 +201,67 @@ public:
         return 0;
     }
 
+    // Set the auth token to write with the header, or nullptr to write the header as it is.
+    // The placeholder position is searched at the beginning of header sending only.
+    void setToken(const String *token)
+    {
+        this->token = token;
+        if (token && dataIndex == 0)
+            token_pos = val[reqns::header].indexOf(FIREBASE_AUTH_PLACEHOLDER);
+    }
+
+    // The length of header to write with the auth token.
+    size_t headerLength() const
+    {
+        size_t len = val[reqns::header].length();
+        if (token && token_pos > -1)
+            len += token->length() - strlen(FIREBASE_AUTH_PLACEHOLDER);
+        return len;
+    }
+
+    // Write the data from offset.
+    // When the auth token was set, the data is the header which will be written in segments i.e. the header
+    // before the placeholder, the auth token and the header after the placeholder, the token is not copied.
+    size_t tcpWrite(const uint8_t *data, size_t offset, size_t size)
+    {
+        if (!token || token_pos < 0)
+            return tcpWrite(data + offset, size);
+
+        const size_t pos = token_pos, tokenLen = token->length(), placeholderLen = strlen(FIREBASE_AUTH_PLACEHOLDER);
+        size_t sent = 0;
+        while (size > 0)
+        {
+            const uint8_t *seg = nullptr;
+            size_t segLen = 0;
+            if (offset < pos)
+            {
+                seg = data + offset;
+                segLen = pos - offset;
+            }
+            else if (offset < pos + tokenLen)
+            {
+                seg = reinterpret_cast<const uint8_t *>(token->c_str()) + offset - pos;
+                segLen = pos + tokenLen - offset;
+            }
+            else
+            {
+                seg = data + offset - tokenLen + placeholderLen;
+                segLen = size;
+            }
+
+            if (segLen > size)
+                segLen = size;
+
+            size_t write = tcpWrite(seg, segLen);
+            sent += write;
+            offset += write;
+            size -= write;
+            if (write < segLen)
+                break;
+        }
+        return sent;
+    }
+
     // This will set the Content-Lenght header with actual file size and header len.
     // Note: If no custom header assigned, the new line will append to the header.
     void setFileContentLength(int headerLen = 0, const String &customHeader = "")
@@ -12,7 +12,10 @@
 #include "./core/Error.h"
 #include "./core/AsyncClient/ConnectionHandler.h"
 #include "./core/AsyncClient/RequestHandler.h"
+#include "./core/AsyncClient/EventStream.h"
+#include "./core/AsyncClient/BufferPool.h"
 #include "./core/Utils/StringUtil.h"
+#include "./core/Utils/Gzip.h"
 
 namespace resns
 {
@@ -25,6 +28,20 @@ namespace resns
         location,
         max_type
     };
+
+    // The response header fields that are used by the library.
+    enum header_field_type_t
+    {
+        hdr_unknown,
+        hdr_etag,
+        hdr_range,
+        hdr_location,
+        hdr_connection,
+        hdr_content_type,
+        hdr_content_length,
+        hdr_content_encoding,
+        hdr_transfer_encoding
+    };
 }
 
 struct res_handler
@@ -71,6 +88,7 @@ public:
         const int hdrSize = 512;
         char *hdr = nullptr;
         String *location = nullptr;
+        buffer_pool *pool = nullptr; // The scratch buffer pool of the async client that owns the buf and hdr.
         int totalRead = 0;       //  Reference to a counter tracking total bytes read (caller must reset).
         char endToken = '\n';    // Character to stop reading at (e.g., '\n' for headers/SSE). Pass 0 to read until the buffer is full (binary/body mode).
         long bytesRemState = -1; // [IN/OUT] Stateful counter. Default to -1 (Infinite/Unknown)
@@ -106,25 +124,29 @@ public:
         void newHdr()
         {
             freeHdr();
-            hdr = (char *)malloc(hdrSize);
+            hdr = pool ? (char *)pool->acquire(hdrSize, false) : (char *)malloc(hdrSize);
         }
 
         void newBuf()
         {
             freeBuf();
-            buf = (uint8_t *)malloc(bufSize);
+            buf = pool ? (uint8_t *)pool->acquire(bufSize, false) : (uint8_t *)malloc(bufSize);
         }
 
         void freeBuf()
         {
-            if (buf)
+            if (pool)
+                pool->release(&buf);
+            else if (buf)
                 free(buf);
             buf = nullptr;
         }
 
         void freeHdr()
         {
-            if (hdr)
+            if (pool)
+                pool->release(&hdr);
+            else if (hdr)
                 free(hdr);
             hdr = nullptr;
         }
@@ -136,6 +158,14 @@ public:
         }
     };
 
+    // The parsed header line.
+    struct header_line_t
+    {
+        resns::header_field_type_t field = resns::hdr_unknown;
+        const char *value = nullptr; // The header value (null terminated).
+        size_t len = 0;              // The length of header value.
+    };
+
     struct auth_error_t
     {
         String string;
@@ -150,12 +180,18 @@ public:
     uint16_t toFillLen = 0, toFillIndex = 0;
     String val[resns::max_type];
     ResponseContext respCtx;
+    sse_framer event_stream;
     Timer read_timer;
     bool auth_data_available = false;
 
     tcp_client_type client_type = tcpc_sync;
     Client *client = nullptr;
+    tcp_reader *reader = nullptr;
     Memory mem;
+#if defined(ENABLE_GZIP)
+    GzipDecoder *gzip = nullptr; // The decoder of the async client that is reused by its responses.
+    bool gzip_active = false;
+#endif
 
     res_handler() {}
 
@@ -164,12 +200,14 @@ public:
         mem.release(&toFill);
         toFillLen = 0;
         toFillIndex = 0;
+        releaseGzip();
     }
 
-    void setClient(tcp_client_type client_type, Client *client)
+    void setClient(tcp_client_type client_type, Client *client, tcp_reader *reader)
     {
         this->client_type = client_type;
         this->client = client;
+        this->reader = reader;
     }
 
     void clear()
@@ -190,13 +228,18 @@ public:
         payloadRead = 0;
         error.resp_code = 0;
         sut.clear(error.string);
+        event_stream.clear();
+        releaseGzip();
     }
 
     void clearHeader(bool clearPayload)
     {
         sut.clear(val[resns::header]);
         if (clearPayload)
+        {
             sut.clear(val[resns::payload]);
+            event_stream.clear();
+        }
 
         payloadRead = 0;
         error.resp_code = 0;
@@ -205,10 +248,11 @@ public:
 
     void feedTimer(int interval = -1) { read_timer.feed(interval == -1 ? FIREBASE_TCP_READ_TIMEOUT_SEC : interval); }
 
+    // The read-ahead data of the connection is counted as available and will be read first.
     int tcpAvailable()
     {
         if (client_type == tcpc_sync)
-            return client ? client->available() : 0;
+            return reader ? reader->available() : 0;
 
         return 0;
     }
@@ -216,7 +260,7 @@ public:
     int tcpRead(uint8_t *buf, size_t size)
     {
         if (client_type == tcpc_sync)
-            return client ? client->read(buf, size) : -1;
+            return reader ? reader->read(buf, size) : -1;
         return 0;
     }
 
@@ -226,9 +270,12 @@ public:
      * * This function acts as a filter. If respCtx.isChunked is true, it strips HTTP hex
      * headers and returns only the payload. It handles timeouts and connection
      * checks automatically.
-     * @tparam TSRC Source stream type (e.g., WiFiClient, EthernetClient)
+     * The data is taken from the source read-ahead buffer in blocks, the line end
+     * and chunk boundaries are located within the buffered block instead of reading
+     * the stream byte by byte.
+     * @tparam TSRC Buffered source stream type (e.g., tcp_reader)
      * @tparam TSNK Debug sink type (e.g., HardwareSerial)
-     * @param source      Pointer to the network client to read from.
+     * @param source      Pointer to the buffered network client to read from.
      * @param sink        Pointer to a Serial object for debug logging (can be NULL).
      * - If respCtx.isChunked=true:  Internal state (counts bytes left in current chunk).
      * @param respCtx    Reference to a ResponseContext struct that maintains state across calls.
@@ -246,9 +293,10 @@ public:
     static int readResponse(TSRC *source, TSNK *sink, ResponseContext &respCtx)
     {
         char *buffer = (char *)respCtx.buf;
-        const char endToken = respCtx.stage == response_stage_payload ? 0 : respCtx.endToken;
+        const bool payload = respCtx.stage == response_stage_payload;
+        const char endToken = payload ? 0 : respCtx.endToken;
+        const size_t cap = respCtx.bufSize - 1;
         size_t pos = 0;
-        int c;
 
         unsigned long ms_start = millis();
         unsigned long timeout = 5000;
@@ -266,103 +314,124 @@ public:
         while ((source->connected() || source->available()) && (millis() - ms_start < timeout))
         {
             // Content-Length Limit Check (Non-Chunked)
-            if (!respCtx.isChunked && respCtx.bytesRemState == 0)
-            {
-                buffer[pos] = '\0';
-                if (sink)
-                    sink->print(buffer);
-                return (int)pos;
-            }
+            if (payload && !respCtx.isChunked && respCtx.bytesRemState == 0)
+                return endRead(sink, buffer, pos);
+
+            // Never read ahead beyond the content length of this response.
+            size_t limit = payload && !respCtx.isChunked && respCtx.bytesRemState > 0 ? respCtx.bytesRemState : 0;
+            size_t avail = source->fill(limit);
 
-            if (!source->available())
+            if (avail == 0)
             {
+                if (payload && pos > 0)
+                    return endRead(sink, buffer, pos);
                 sys_idle();
                 continue;
             }
 
-            c = source->read();
-            if (c == -1)
+            const uint8_t *data = source->data();
+            ms_start = millis();
+
+            if (!payload) // status line and header read
+            {
+                size_t n = avail < cap - pos ? avail : cap - pos;
+                const uint8_t *end = endToken != 0 ? reinterpret_cast<const uint8_t *>(memchr(data, endToken, n)) : nullptr;
+                if (end)
+                    n = end - data + 1;
+
+                memcpy(buffer + pos, data, n);
+                source->consume(n);
+                pos += n;
+                respCtx.totalRead += n;
+
+                if (end || pos >= cap)
+                    return endRead(sink, buffer, pos);
+
                 continue;
+            }
 
-            if (respCtx.stage == response_stage_payload) // payload read
+            if (respCtx.isChunked && respCtx.bytesRemState == 0)
             {
-                if (respCtx.isChunked)
+                // We are reading the Hex Size Line
+                const uint8_t *end = reinterpret_cast<const uint8_t *>(memchr(data, '\n', avail));
+                size_t n = end ? end - data + 1 : avail;
+                source->consume(n);
+
+                for (size_t i = 0; i < n; i++)
                 {
-                    if (respCtx.bytesRemState == 0)
+                    int val = hexValue(data[i]);
+                    if (val >= 0)
                     {
-                        // We are reading the Hex Size Line
-                        if (c == '\r')
-                            continue; // ignore CR
-
-                        if (c == '\n')
-                        {
-                            // If we hit a newline but haven't seen any digits yet,
-                            // it is just the trailing whitespace of the previous chunk.
-                            if (!respCtx.stateChunkSizeRead)
-                                continue;
-
-                            // If we saw digits and the value is 0, it's the actual End of Stream.
-                            if (respCtx.tempSize == 0)
-                            {
-                                // The response ended per protocol (RFC 9112 terminal chunk).
-                                // Consume the trailing CRLF if it already arrived so no stale
-                                // bytes remain to desync the next keep-alive request.
-                                respCtx.chunkedEnd = true;
-                                while (source->available() && (source->peek() == '\r' || source->peek() == '\n'))
-                                    source->read();
-                                return (int)pos;
-                            }
-
-                            // Otherwise, lock in the new chunk size
-                            respCtx.bytesRemState = respCtx.tempSize;
-                            respCtx.tempSize = 0;
-                            respCtx.stateChunkSizeRead = false; // Reset for next chunk
-                        }
-                        else
-                        {
-                            // Parse Hex
-                            int val = -1;
-                            if (c >= '0' && c <= '9')
-                                val = c - '0';
-                            else if (c >= 'a' && c <= 'f')
-                                val = c - 'a' + 10;
-                            else if (c >= 'A' && c <= 'F')
-                                val = c - 'A' + 10;
-
-                            if (val >= 0)
-                            {
-                                respCtx.tempSize = (respCtx.tempSize * 16) + val;
-                                respCtx.stateChunkSizeRead = true; // Mark that we found a valid digit
-                            }
-                        }
-                        ms_start = millis(); // Reset timeout while parsing headers
-                        continue;            // Don't write these bytes to buffer
+                        respCtx.tempSize = (respCtx.tempSize * 16) + val;
+                        respCtx.stateChunkSizeRead = true; // Mark that we found a valid digit
                     }
-                    respCtx.bytesRemState--;
                 }
-                else if (respCtx.bytesRemState > 0)
-                    respCtx.bytesRemState--;
-            }
 
-            buffer[pos++] = (char)c;
-            respCtx.totalRead++;
+                // If we hit a newline but haven't seen any digits yet,
+                // it is just the trailing whitespace of the previous chunk.
+                if (!end || !respCtx.stateChunkSizeRead)
+                    continue;
 
-            if ((endToken != 0 && c == endToken) || pos >= respCtx.bufSize - 1 ||
-                (respCtx.stage == response_stage_payload && ((source->available() == 0) || (!respCtx.isChunked && respCtx.bytesRemState == 0))))
-            {
-                buffer[pos] = '\0';
-                if (sink)
-                    sink->print(buffer);
+                // If we saw digits and the value is 0, it's the actual End of Stream.
+                if (respCtx.tempSize == 0)
+                {
+                    // The response ended per protocol (RFC 9112 terminal chunk).
+                    // Consume the trailing CRLF if it already arrived so no stale
+                    // bytes remain to desync the next keep-alive request.
+                    respCtx.chunkedEnd = true;
+                    respCtx.stateChunkSizeRead = false;
+                    while (source->available() && (source->peek() == '\r' || source->peek() == '\n'))
+                        source->read();
+                    return endRead(sink, buffer, pos);
+                }
 
-                return (int)pos;
+                // Otherwise, lock in the new chunk size
+                respCtx.bytesRemState = respCtx.tempSize;
+                respCtx.tempSize = 0;
+                respCtx.stateChunkSizeRead = false; // Reset for next chunk
+                continue;
             }
 
-            ms_start = millis();
+            // Payload data, up to the end of current chunk or content length.
+            size_t n = avail < cap - pos ? avail : cap - pos;
+            if (respCtx.bytesRemState > 0 && (size_t)respCtx.bytesRemState < n)
+                n = respCtx.bytesRemState;
+
+            memcpy(buffer + pos, data, n);
+            source->consume(n);
+            pos += n;
+            respCtx.totalRead += n;
+
+            if (respCtx.bytesRemState > 0)
+                respCtx.bytesRemState -= n;
+
+            if (pos >= cap || source->available() == 0 || (!respCtx.isChunked && respCtx.bytesRemState == 0))
+                return endRead(sink, buffer, pos);
         }
 
         return millis() - ms_start < timeout ? 0 : -2;
     }
 
+    template <typename TSNK>
+    static int endRead(TSNK *sink, char *buffer, size_t pos)
+    {
+        buffer[pos] = '\0';
+        if (sink)
+            sink->print(buffer);
+        return (int)pos;
+    }
+
+    static int hexValue(uint8_t c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        else if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
     void readMetaData()
     {
         if (respCtx.stage == response_stage_finished || respCtx.stage == response_stage_payload)
@@ -371,7 +440,10 @@ public:
         if (!respCtx.buf)
             respCtx.newBuf();
 
-        int len = readResponse<Client, Client>(client, nullptr, respCtx);
+        if (!reader)
+            return;
+
+        int len = readResponse<tcp_reader, Client>(reader, nullptr, respCtx);
 
         if (httpCode == 0 && len > 0)
         {
@@ -380,6 +452,8 @@ public:
             {
                 sut.clear(val[resns::header]);
                 sut.clear(val[resns::payload]);
+                event_stream.clear();
+                flags.uploadRange = false;
                 httpCode = code;
                 respCtx.stage = response_stage_header;
                 return;
@@ -395,6 +469,7 @@ public:
             if (strcmp((const char *)respCtx.buf, "\r\n") == 0 || len <= 0)
             {
                 respCtx.freeHdr();
+                releaseGzip();
                 clearHeader(!respCtx.isAuth);
                 if (httpCode == FIREBASE_ERROR_HTTP_CODE_NO_CONTENT)
                     respCtx.stage = response_stage_finished;
@@ -406,66 +481,83 @@ public:
                 if (!respCtx.hdr)
                     respCtx.newHdr();
 
-                flags.uploadRange = false;
                 flags.http_response = true;
 
-                if (parseHeaders((const char *)respCtx.buf, "ETag", respCtx.hdr, respCtx.hdrSize))
-                    val[resns::etag] = respCtx.hdr;
+                header_line_t line;
+                if (!parseHeaderLine((const char *)respCtx.buf, line, respCtx.hdr, respCtx.hdrSize))
+                    return;
 
-                if (respCtx.location && parseHeaders((const char *)respCtx.buf, "Location", respCtx.hdr, respCtx.hdrSize))
-                    *respCtx.location = respCtx.hdr;
-
-                if (parseHeaders((const char *)respCtx.buf, "Content-Length", respCtx.hdr, respCtx.hdrSize))
+                switch (line.field)
                 {
-                    payloadLen = atoi(respCtx.hdr);
+                case resns::hdr_etag:
+                    val[resns::etag] = line.value;
+                    break;
+
+                case resns::hdr_location:
+                    if (respCtx.location)
+                        *respCtx.location = line.value;
+                    break;
+
+                case resns::hdr_content_length:
+                    payloadLen = atoi(line.value);
                     respCtx.bytesRemState = payloadLen;
-                }
+                    break;
 
-                if (parseHeaders((const char *)respCtx.buf, "Connection", respCtx.hdr, respCtx.hdrSize))
-                {
-                    if (strstr(respCtx.hdr, "keep-alive"))
+                case resns::hdr_connection:
+                    if (strstr(line.value, "keep-alive"))
                         flags.keep_alive = true;
                     // The server announced it will close this connection after this
                     // response (e.g. reached its max connection age/requests limit).
-                    if (strstr(respCtx.hdr, "close"))
+                    if (strstr(line.value, "close"))
                         flags.connection_close = true;
-                }
+                    break;
 
-                if (parseHeaders((const char *)respCtx.buf, "Transfer-Encoding", respCtx.hdr, respCtx.hdrSize) && strstr(respCtx.hdr, "chunked"))
-                {
-                    respCtx.isChunked = true;
-                    respCtx.bytesRemState = 0; // Initialize chunk logic to "expecting header"
-                    flags.chunks = true;
-                }
+                case resns::hdr_transfer_encoding:
+                    if (strstr(line.value, "chunked"))
+                    {
+                        respCtx.isChunked = true;
+                        respCtx.bytesRemState = 0; // Initialize chunk logic to "expecting header"
+                        flags.chunks = true;
+                    }
+                    break;
 
-                if (parseHeaders((const char *)respCtx.buf, "Content-Type", respCtx.hdr, respCtx.hdrSize) && strstr(respCtx.hdr, "text/event-stream"))
-                    flags.sse = true;
+                case resns::hdr_content_type:
+                    if (strstr(line.value, "text/event-stream"))
+                        flags.sse = true;
+                    break;
 
-                if (parseHeaders((const char *)respCtx.buf, "Content-Encoding", respCtx.hdr, respCtx.hdrSize) && strstr(respCtx.hdr, "gzip"))
-                    flags.gzip = true;
+                case resns::hdr_content_encoding:
+                    if (strstr(line.value, "gzip"))
+                        flags.gzip = true;
+                    break;
 
-                if (respCtx.isUpload)
-                {
-                    if (httpCode == FIREBASE_ERROR_HTTP_CODE_PERMANENT_REDIRECT && parseHeaders((const char *)respCtx.buf, "Range", respCtx.hdr, respCtx.hdrSize) && strstr(respCtx.hdr, "bytes="))
+                case resns::hdr_range:
+                    if (respCtx.isUpload && httpCode == FIREBASE_ERROR_HTTP_CODE_PERMANENT_REDIRECT && strstr(line.value, "bytes="))
                         flags.uploadRange = true;
+                    break;
+
+                default:
+                    break;
                 }
             }
         }
     }
 
-    void readPayload()
+    // Returns false when the compressed payload could not be decoded.
+    bool readPayload()
     {
         if (respCtx.stage == response_stage_finished)
-            return;
+            return true;
 
+        bool ret = true;
         if (respCtx.stage == response_stage_payload)
         {
             if (!respCtx.buf)
                 respCtx.newBuf();
 
-            if (client->connected() || client->available())
+            if (reader && (reader->connected() || reader->available()))
             {
-                int len = readResponse<Client, Client>(client, nullptr, respCtx);
+                int len = readResponse<tcp_reader, Client>(reader, nullptr, respCtx);
 
                 if (len < 0 || (!respCtx.isChunked && respCtx.bytesRemState == 0 && len == 0))
                 {
@@ -487,17 +579,73 @@ public:
                         payloadRead += len;
                         respCtx.buf[len] = '\0';
                         reserveString();
-                        val[resns::payload] += (const char *)respCtx.buf;
+#if defined(ENABLE_GZIP)
+                        if (flags.gzip)
+                            ret = inflatePayload(respCtx.buf, len);
+                        else
+#endif
+                            val[resns::payload] += (const char *)respCtx.buf;
                     }
 
-                    if ((!respCtx.isChunked && respCtx.bytesRemState <= 0) || (respCtx.isChunked && (len == 0 || respCtx.chunkedEnd)))
+                    if (!ret || (!respCtx.isChunked && respCtx.bytesRemState <= 0) || (respCtx.isChunked && (len == 0 || respCtx.chunkedEnd)))
                     {
                         respCtx.stage = response_stage_finished;
                         respCtx.freeBuf();
                     }
                 }
             }
+
+            if (respCtx.stage == response_stage_finished)
+                releaseGzip();
         }
+        return ret;
+    }
+
+#if defined(ENABLE_GZIP)
+    // Decode the gzip compressed payload chunk and append the decoded data to the payload.
+    bool inflatePayload(const uint8_t *data, size_t len)
+    {
+        if (!gzip)
+            return false;
+
+        // The window is allocated once and kept by the decoder.
+        if (!gzip_active)
+        {
+            if (!gzip->begin())
+                return false;
+            gzip_active = true;
+        }
+
+        char out[256];
+        size_t pos = 0, produced = 0;
+        do
+        {
+            size_t consumed = 0;
+            GzipDecoder::gzip_status_t status = gzip->decode(data + pos, len - pos, consumed, reinterpret_cast<uint8_t *>(out), sizeof(out), produced);
+            pos += consumed;
+
+            // The decoded data may contain the null character.
+            if (produced > 0)
+                val[resns::payload].concat(out, produced);
+
+            if (status == GzipDecoder::gzip_status_error)
+                return false;
+
+            if (status == GzipDecoder::gzip_status_done)
+                break;
+
+            // Continue while there is the remaining input or the output buffer was full (more decoded data).
+        } while (pos < len || produced == sizeof(out));
+
+        return true;
+    }
+#endif
+
+    void releaseGzip()
+    {
+#if defined(ENABLE_GZIP)
+        gzip_active = false;
+#endif
     }
 
     void reserveString()
@@ -534,40 +682,86 @@ public:
         return atoi(code_str);
     }
 
-    int parseHeaders(const char *src, const char *key, char *out_buf, size_t out_len)
+    // Get the header field type from its name.
+    // The known header names have distinct lengths, the name length selects the only candidate to compare.
+    resns::header_field_type_t getHeaderField(const char *name, size_t len)
     {
-        const char *p = src;
-        size_t key_len = strlen(key);
+        const char *key = nullptr;
+        resns::header_field_type_t field = resns::hdr_unknown;
 
-        while (*p != '\0')
+        switch (len)
         {
-            while (*p == '\r' || *p == '\n')
-                p++;
+        case 4:
+            key = "ETag";
+            field = resns::hdr_etag;
+            break;
+        case 5:
+            key = "Range";
+            field = resns::hdr_range;
+            break;
+        case 8:
+            key = "Location";
+            field = resns::hdr_location;
+            break;
+        case 10:
+            key = "Connection";
+            field = resns::hdr_connection;
+            break;
+        case 12:
+            key = "Content-Type";
+            field = resns::hdr_content_type;
+            break;
+        case 14:
+            key = "Content-Length";
+            field = resns::hdr_content_length;
+            break;
+        case 16:
+            key = "Content-Encoding";
+            field = resns::hdr_content_encoding;
+            break;
+        case 17:
+            key = "Transfer-Encoding";
+            field = resns::hdr_transfer_encoding;
+            break;
+        default:
+            return resns::hdr_unknown;
+        }
 
-            if (*p == '\0')
-                break;
+        return strncasecmp(name, key, len) == 0 ? field : resns::hdr_unknown;
+    }
 
-            if (strncasecmp(p, key, key_len) == 0 && p[key_len] == ':')
-            {
-                p += key_len + 1;
+    // Split the header line into name and value in one pass.
+    // The value (without leading white spaces and line ending) will be copied to out_buf.
+    // Returns false when the line is not a known header field.
+    bool parseHeaderLine(const char *src, header_line_t &line, char *out_buf, size_t out_len)
+    {
+        const char *p = src;
+        while (*p == '\r' || *p == '\n')
+            p++;
 
-                while (*p == ' ' || *p == '\t')
-                    p++;
+        const char *colon = strchr(p, ':');
+        if (!colon)
+            return false;
 
-                size_t i = 0;
-                while (*p != '\r' && *p != '\n' && *p != '\0')
-                {
-                    if (i < out_len - 1)
-                        out_buf[i++] = *p;
-                    p++;
-                }
-                out_buf[i] = '\0';
-                return 1;
-            }
-            while (*p != '\0' && *p != '\r' && *p != '\n')
-                p++;
+        line.field = getHeaderField(p, colon - p);
+        if (line.field == resns::hdr_unknown)
+            return false;
+
+        p = colon + 1;
+        while (*p == ' ' || *p == '\t')
+            p++;
+
+        size_t i = 0;
+        while (*p != '\r' && *p != '\n' && *p != '\0')
+        {
+            if (i < out_len - 1)
+                out_buf[i++] = *p;
+            p++;
         }
-        return 0;
+        out_buf[i] = '\0';
+        line.value = out_buf;
+        line.len = i;
+        return true;
     }
 };
 
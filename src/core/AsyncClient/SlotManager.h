@@ -27,17 +27,20 @@ class SlotManager PUBLIC_DATABASE_RESULT_IMPL_BASE
 private:
     app_log_t debug_log;
     app_log_t event_log;
-    conn_handler conn;
-    std::vector<uint32_t> sVec;
-    Client *client = nullptr;
-    Timer session_timer;
+    conn_handler conns[FIREBASE_CONNECTION_POOL_SIZE];
+    conn_handler *conn = &conns[0]; // The server connection of the running task.
+    Client *clients[FIREBASE_CONNECTION_POOL_SIZE] = {};
+    uint8_t conn_count = 1;
+    uint32_t conn_seq = 0;
+    conn_pool_stats_t conn_stats;
+    std::vector<async_data *> sVec;
+    Client *client = nullptr; // The SSL client of the running task.
     uint32_t session_timeout_sec = 0;
-    uint32_t result_addr = 0;
+    firebase_handle_t result_handle = 0;
     AsyncResult *refResult = nullptr;
     AsyncResult aResult;
     FirebaseError lastErr;
     tcp_client_type client_type = tcpc_sync;
-    std::vector<uint32_t> rVec; // AsyncResult vector
     String sse_events_filter;
 
 public:
@@ -89,7 +92,7 @@ public:
     async_data *getData(uint8_t slot)
     {
         if (slot < sVec.size())
-            return reinterpret_cast<async_data *>(sVec[slot]);
+            return sVec[slot];
         return nullptr;
     }
 
@@ -101,9 +104,9 @@ public:
         sData->aResult.event_log = &event_log;
 
         if (index > -1)
-            sVec.insert(sVec.begin() + index, sData->addr);
+            sVec.insert(sVec.begin() + index, sData);
         else
-            sVec.push_back(sData->addr);
+            sVec.push_back(sData);
 
         return sData;
     }
@@ -115,7 +118,7 @@ public:
         if (slot_index == -2)
             return nullptr;
 
-        bool prev_async = getData(0) && getData(0)->async && conn.async;
+        bool prev_async = getData(0) && getData(0)->async && conn->async;
 
         async_data *sData = addSlot(slot_index);
         sData->reset();
@@ -138,11 +141,13 @@ public:
         if (sData->sse && !sse)
             return;
 
-        if (!sData->auth_used && sData->request.ota && sData->request.ul_dl_task_running_addr > 0)
-        {
-            bool *ul_dl_task_running = reinterpret_cast<bool *>(sData->request.ul_dl_task_running_addr);
-            *ul_dl_task_running = false;
-        }
+        // The unread response of this task will be read as the response of the next pipelined task.
+        // Close the connection, the pipelined requests will be sent again.
+        if (sData->state == astate_read_response && !sData->complete && isPipelined(slot + 1))
+            stop();
+
+        if (!sData->auth_used && sData->request.ota && sData->request.ul_dl_task_running)
+            *sData->request.ul_dl_task_running = false;
 
 #if defined(ENABLE_DATABASE)
         clearSSE(&sData->aResult.rtdbResult);
@@ -151,6 +156,14 @@ public:
         sData->request.closeFile();
 #endif
         setLastError(sData);
+
+        // The payload sink always gets the final call e.g. the HTTP error response or the failed and cancelled task.
+        if (sData->payload_sink && !sData->payload_sink_done)
+        {
+            sData->payload_sink_done = true;
+            sData->payload_sink(sData->aResult, reinterpret_cast<const uint8_t *>(""), 0, true);
+        }
+
         // data available from sync and asyn request except for sse
         returnResult(sData, true);
         reset(sData, sData->auth_used);
@@ -163,24 +176,43 @@ public:
     bool sseFilter(async_data *sData)
     {
 #if defined(ENABLE_DATABASE)
-        String event = sData->aResult.rtdbResult.event();
-        return (sse_events_filter.length() == 0 ||
-                (sData->response.flags.http_response && sse_events_filter.indexOf("get") > -1 && event.indexOf("put") > -1) ||
-                (!sData->response.flags.http_response && sse_events_filter.indexOf("put") > -1 && event.indexOf("put") > -1) ||
-                (sse_events_filter.indexOf("patch") > -1 && event.indexOf("patch") > -1) ||
-                (sse_events_filter.indexOf("keep-alive") > -1 && event.indexOf("keep-alive") > -1) ||
-                (sse_events_filter.indexOf("cancel") > -1 && event.indexOf("cancel") > -1) ||
-                (sse_events_filter.indexOf("auth_revoked") > -1 && event.indexOf("auth_revoked") > -1));
+        return sseFilter(sse_events_filter, sData->aResult.rtdbResult.event(), sData->response.flags.http_response);
 #else
         return false;
 #endif
     }
 
+    // Check the event with the events filter e.g. "get,put,patch,keep-alive,cancel,auth_revoked", the empty filter allows all events.
+    // The first put event since the Stream connected (the http response) is the get event.
+    static bool sseFilter(const String &filter, const String &event, bool first)
+    {
+        return (filter.length() == 0 ||
+                (first && filter.indexOf("get") > -1 && event.indexOf("put") > -1) ||
+                (!first && filter.indexOf("put") > -1 && event.indexOf("put") > -1) ||
+                (filter.indexOf("patch") > -1 && event.indexOf("patch") > -1) ||
+                (filter.indexOf("keep-alive") > -1 && event.indexOf("keep-alive") > -1) ||
+                (filter.indexOf("cancel") > -1 && event.indexOf("cancel") > -1) ||
+                (filter.indexOf("auth_revoked") > -1 && event.indexOf("auth_revoked") > -1));
+    }
+
+#if defined(ENABLE_DATABASE)
+    // The cached data of the Stream is no longer kept in sync when the Stream was stopped or restarted.
+    void releaseCache(async_data *sData)
+    {
+        if (sData->sse && sData->cache())
+            sData->rtdb_cache->removeRoot(sData->request.val[reqns::path]);
+    }
+#endif
+
     void reset(async_data *sData, bool disconnect)
     {
         if (disconnect)
             stop();
 
+#if defined(ENABLE_DATABASE)
+        releaseCache(sData);
+#endif
+
         sData->response.httpCode = 0;
         sData->error.code = 0;
         sData->response.flags.reset();
@@ -194,8 +226,7 @@ public:
 
     AsyncResult *getResult(async_data *sData)
     {
-        List vec;
-        return vec.existed(rVec, sData->ref_result_addr) ? sData->refResult : nullptr;
+        return handleRegistry().isValid(sData->ref_result_handle, handle_type_result) ? sData->refResult : nullptr;
     }
 
     void returnResult(async_data *sData, bool setData)
@@ -235,7 +266,10 @@ public:
             {
                 sData->refResult->upload_data.reset();
 
+                // The payload sink is the user option that is not copied from the task result.
+                AsyncPayloadSinkCallback payload_sink = sData->refResult->payload_sink;
                 *sData->refResult = sData->aResult;
+                sData->refResult->payload_sink = payload_sink;
 
                 if (setData)
                     sData->refResult->setPayload(sData->aResult.val[ares_ns::data_payload]);
@@ -254,6 +288,9 @@ public:
                 firebase_bebug_callback(sData->cb, sData->aResult, __func__, __LINE__, __FILE__);
         }
 
+        if (sData->targets.size() && (setData || error_notify_timeout))
+            returnTargetResults(sData, setData);
+
         if (getResult(sData))
         {
             // In case external async result was set, when download completed,
@@ -268,20 +305,109 @@ public:
         }
     }
 
+    // Deliver the result to the tasks that were merged to this task.
+    void returnTargetResults(async_data *sData, bool setData)
+    {
+        for (size_t i = 0; i < sData->targets.size(); i++)
+        {
+            async_result_target_t &target = sData->targets[i];
+            if (target.result && handleRegistry().isValid(target.result_handle, handle_type_result))
+            {
+                *target.result = sData->aResult;
+                if (setData)
+                    target.result->setPayload(sData->aResult.val[ares_ns::data_payload]);
+                if (setData && sData->result_filter)
+                    sData->result_filter(*target.result, target.index);
+                target.result->setUID(target.uid);
+            }
+
+            if (target.cb)
+            {
+                AsyncResult aResult;
+                aResult = sData->aResult;
+                aResult.setPayload(sData->aResult.val[ares_ns::data_payload]);
+                if (setData && sData->result_filter)
+                    sData->result_filter(aResult, target.index);
+                aResult.setUID(target.uid);
+                firebase_bebug_callback(target.cb, aResult, __func__, __LINE__, __FILE__);
+            }
+        }
+    }
+
+    // Select the server connection for the task from the pool.
+    // The connection that was used by the task, the open connection to the same host and the idle connection are preferred
+    // respectively, otherwise the least recently used connection that is not the Stream connection will be taken.
+    // Returns false when all connections are carrying the Stream, the current connection is kept unchanged.
+    bool selectConn(async_data *sData, const char *host = nullptr, uint16_t port = 0)
+    {
+        int sel = 0;
+        if (conn_count > 1)
+        {
+            sel = -1;
+            for (uint8_t i = 0; i < conn_count && sel == -1 && sData->conn_id > 0; i++)
+            {
+                if (conns[i].id == sData->conn_id && conns[i].isConnected())
+                    sel = i;
+            }
+
+            String h;
+            if (sel == -1 && !host)
+            {
+                h = sData->request.getHost(true, &sData->response.val[resns::location]);
+                host = h.c_str();
+                port = sData->request.port;
+            }
+
+            for (uint8_t i = 0; i < conn_count && sel == -1; i++)
+            {
+                if (conns[i].isConnected() && conns[i].sse == sData->sse && conns[i].port == port && strcmp(conns[i].host.c_str(), host) == 0)
+                    sel = i;
+            }
+
+            for (uint8_t i = 0; i < conn_count && sel == -1; i++)
+            {
+                if (!conns[i].isConnected())
+                    sel = i;
+            }
+
+            if (sel == -1)
+            {
+                for (uint8_t i = 0; i < conn_count; i++)
+                {
+                    if (!isStreamConn(conns[i]) && (sel == -1 || millis() - conns[i].used_ms > millis() - conns[sel].used_ms))
+                        sel = i;
+                }
+                // Never take over the Stream connection.
+                if (sel == -1)
+                    return false;
+            }
+        }
+
+        conn = &conns[sel];
+        client = clients[sel];
+        return true;
+    }
+
     void newCon(async_data *sData, const char *host, uint16_t port)
     {
-        conn.newConn(client_type, client, &debug_log);
+        if (!selectConn(sData, host, port))
+            return;
+        conn->newConn(client_type, client, &debug_log);
         sData->request.setClient(client_type, client);
-        sData->response.setClient(client_type, client);
+        sData->response.setClient(client_type, client, &conn->reader);
 
-        if ((!sData->sse && session_timeout_sec >= FIREBASE_SESSION_TIMEOUT_SEC && session_timer.remaining() == 0) || sData->stop_current_async ||
-            (conn.sse && !sData->sse) || (!conn.sse && sData->sse) || (sData->auth_used && sData->state == astate_undefined) ||
-            strcmp(conn.host.c_str(), host) != 0 || conn.port != port)
+        if (!isConnReusable(sData, host, port))
         {
             sData->stop_current_async = false;
             stop();
             getResult()->clear();
         }
+        else if (conn->isConnected())
+        {
+            conn_stats.reused++;
+            sData->conn_id = conn->id;
+        }
+        conn->used_ms = millis();
 
         // Required for sync task.
         if (!sData->async)
@@ -291,17 +417,56 @@ public:
         }
     }
 
+    // Check whether there is the task from slot that its request was sent on the current server connection and waiting for the response.
+    bool isPipelined(size_t slot)
+    {
+        for (size_t i = slot; i < sVec.size(); i++)
+        {
+            if (getData(i)->pipelined && getData(i)->conn_id == conn->id)
+                return true;
+        }
+        return false;
+    }
+
+    // Check whether the server connection is carrying the Stream task that is running.
+    // The connection of the Stream that was stopped is kept open until it is used by other task.
+    bool isStreamConn(conn_handler &c)
+    {
+        if (!c.sse || !c.isConnected())
+            return false;
+
+        for (size_t i = 0; i < sVec.size(); i++)
+        {
+            if (getData(i)->sse && !getData(i)->to_remove && getData(i)->conn_id == c.id)
+                return true;
+        }
+        return false;
+    }
+
+    // Check whether the current server connection can be used by the task without reconnecting.
+    bool isConnReusable(const async_data *sData, const char *host, uint16_t port)
+    {
+        return !((!sData->sse && session_timeout_sec >= FIREBASE_SESSION_TIMEOUT_SEC && conn->session_timer.remaining() == 0) || sData->stop_current_async ||
+                 (conn->sse && !sData->sse) || (!conn->sse && sData->sse) || (sData->auth_used && sData->state == astate_undefined) ||
+                 strcmp(conn->host.c_str(), host) != 0 || conn->port != port);
+    }
+
     void stop()
     {
-        if (conn.isConnected())
+        if (conn->isConnected())
             debug_log.push_back(-1, "Terminating the server connection...");
-        conn.stop();
+        conn->stop();
+    }
+
+    void stopAll()
+    {
+        for (uint8_t i = 0; i < conn_count; i++)
+            conns[i].stop();
     }
 
     AsyncResult *getResult()
     {
-        List vec;
-        return vec.existed(rVec, result_addr) ? refResult : &aResult;
+        return handleRegistry().isValid(result_handle, handle_type_result) ? refResult : &aResult;
     }
 
     void setAsyncError(async_data *sData, async_state state, int code, bool toRemove, bool toCloseFile)
@@ -376,13 +541,23 @@ public:
         sData->aResult.conn_ms = millis();
         debug_log.reset();
 
-        if (!conn.isConnected() && !sData->auth_used) // This info is already shown in auth task
+        if (!conn->isConnected() && !sData->auth_used) // This info is already shown in auth task
             debug_log.push_back(-1, "Connecting to server...");
 
-        sData->return_type = conn.connect(host, port);
+        bool reconnect = conn->id > 0;
+        sData->return_type = conn->connect(host, port);
+
+        if (conn->isConnected())
+        {
+            conn->id = ++conn_seq;
+            sData->conn_id = conn->id;
+            conn_stats.connects++;
+            if (reconnect)
+                conn_stats.reconnects++;
+        }
 
-        if (conn.isConnected() && !sData->sse && session_timeout_sec >= FIREBASE_SESSION_TIMEOUT_SEC)
-            session_timer.feed(session_timeout_sec);
+        if (conn->isConnected() && !sData->sse && session_timeout_sec >= FIREBASE_SESSION_TIMEOUT_SEC)
+            conn->session_timer.feed(session_timeout_sec);
 
         return sData->return_type;
     }
@@ -0,0 +1,280 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_ASYNC_CLIENT_STREAM_MULTIPLEXER_H
+#define CORE_ASYNC_CLIENT_STREAM_MULTIPLEXER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./core/AsyncResult/AsyncResult.h"
+#include "./core/Utils/JSONPath.h"
+#include "./core/Utils/Handle.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The Stream listener of StreamMultiplexer.
+struct stream_listener_t
+{
+    String path;   // The node path to listen.
+    String filter; // The events filter e.g. "put,patch".
+    String uid;    // The UID of the async result that is passed to the callback.
+    AsyncResultCallback cb = NULL;
+};
+
+/**
+ * Dispatches the events of one Stream to many listeners.
+ *
+ * The Stream is started at the common ancestor path of all listeners (see RealtimeDatabase::get with StreamMultiplexer),
+ * the listener receives the events of the data at and under its path, with the data path and data relative to its path,
+ * as if it is the Stream of its own path.
+ */
+class StreamMultiplexer
+{
+    friend class AsyncClientClass;
+    friend class RealtimeDatabase;
+    friend struct async_data;
+
+private:
+    std::vector<stream_listener_t> listeners;
+    String stream_path; // The path of the running Stream.
+    firebase_ns::ObjectHandle obj_handle;
+
+    // The handle that the Stream task keeps to check that the multiplexer still exists.
+    firebase_ns::firebase_handle_t handle() { return obj_handle.get(this, firebase_ns::handle_type_stream_mux); }
+
+    // Get the value at the path (the object members and array elements) of JSON value.
+    static String getValue(const String &json, const String &path)
+    {
+        const char *s = json.c_str();
+        size_t i = 0, v = 0;
+        int p = 0;
+        JSONPathUtil::skipSpace(s, i);
+        while (p < (int)path.length())
+        {
+            int q = path.indexOf('/', p);
+            if (q < 0)
+                q = path.length();
+            String seg = path.substring(p, q);
+            p = q + 1;
+
+            bool object = s[i] == '{';
+            if (!object && s[i] != '[')
+                return "null";
+            i++;
+            bool found = false;
+            for (int n = 0; !found; n++)
+            {
+                JSONPathUtil::skipSpace(s, i);
+                if (s[i] == '}' || s[i] == ']' || !s[i])
+                    return "null";
+                if (object)
+                {
+                    size_t k = i;
+                    if (s[i] != '"' || !JSONPathUtil::skipString(s, i))
+                        return "null";
+                    found = json.substring(k + 1, i - 1) == seg;
+                    JSONPathUtil::skipSpace(s, i);
+                    if (s[i++] != ':')
+                        return "null";
+                    JSONPathUtil::skipSpace(s, i);
+                }
+                else
+                    found = String(n) == seg;
+
+                if (!found)
+                {
+                    if (!JSONPathUtil::skipValue(s, i))
+                        return "null";
+                    JSONPathUtil::skipSpace(s, i);
+                    if (s[i] == ',')
+                        i++;
+                }
+            }
+        }
+        v = i;
+        if (!JSONPathUtil::skipValue(s, i) || i == v)
+            return "null";
+        return json.substring(v, i);
+    }
+
+    // The members of patch data that are at or under the path, the member names are relative to the path.
+    // Returns the value (put) when the member replaces the value at the path.
+    static bool getPatch(const String &json, const String &path, String &value, bool &put)
+    {
+        const char *s = json.c_str();
+        size_t i = 0;
+        JSONPathUtil::skipSpace(s, i);
+        if (s[i++] != '{')
+            return false;
+        value.remove(0, value.length());
+        while (true)
+        {
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] != '"')
+                break;
+            size_t k = i;
+            if (!JSONPathUtil::skipString(s, i))
+                return false;
+            String key = JSONPathUtil::normalize(json.substring(k + 1, i - 1));
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i++] != ':')
+                return false;
+            JSONPathUtil::skipSpace(s, i);
+            size_t v = i;
+            if (!JSONPathUtil::skipValue(s, i))
+                return false;
+            String member = json.substring(v, i);
+
+            if (JSONPathUtil::isAncestor(key, path))
+            {
+                value = getValue(member, JSONPathUtil::relative(key, path));
+                put = true;
+                return true;
+            }
+            else if (JSONPathUtil::isAncestor(path, key))
+            {
+                value += value.length() ? ',' : '{';
+                value += '"';
+                value += JSONPathUtil::relative(path, key);
+                value += "\":";
+                value += member;
+            }
+
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] != ',')
+                break;
+            i++;
+        }
+        put = false;
+        if (value.length())
+            value += '}';
+        return value.length() > 0;
+    }
+
+    /**
+     * Get the event of the listener.
+     *
+     * @param listener The listener.
+     * @param event The Stream event type, it will be the event type of the listener.
+     * @param dataPath The Stream event data path, it will be the data path relative to the listener path.
+     * @param data The Stream event data, it will be the data of the listener.
+     * @return bool Returns true if the event changes the data at or under the listener path, or it is not the data event.
+     * The events filter of the listener is not checked.
+     */
+    bool getEvent(const stream_listener_t &listener, String &event, String &dataPath, String &data)
+    {
+        if (event == "put" || event == "patch")
+        {
+            String root = JSONPathUtil::normalize(stream_path), path = JSONPathUtil::normalize(listener.path), location = JSONPathUtil::normalize(dataPath);
+            if (!JSONPathUtil::isAncestor(root, path))
+                return false;
+            path = JSONPathUtil::relative(root, path);
+
+            if (JSONPathUtil::isAncestor(path, location))
+                dataPath = "/" + JSONPathUtil::relative(path, location);
+            else if (!JSONPathUtil::isAncestor(location, path))
+                return false;
+            else if (event == "put")
+            {
+                data = getValue(data, JSONPathUtil::relative(location, path));
+                dataPath = "/";
+            }
+            else
+            {
+                bool put = false;
+                String value;
+                if (!getPatch(data, JSONPathUtil::relative(location, path), value, put))
+                    return false;
+                event = put ? "put" : "patch";
+                data = value;
+                dataPath = "/";
+            }
+        }
+
+        return true;
+    }
+
+public:
+    StreamMultiplexer() {}
+
+    /**
+     * Add the listener.
+     *
+     * @param path The node path to listen.
+     * @param cb The async result callback that receives the events of the node.
+     * @param filter The events filter (optional) e.g. "put,patch", see RealtimeDatabase::setSSEFilters.
+     * @param uid The user specified UID of async result (optional).
+     *
+     * The listener that was added while the Stream is running receives the events when its path is
+     * under the Stream path, otherwise the Stream should be started again.
+     */
+    void addListener(const String &path, AsyncResultCallback cb, const String &filter = "", const String &uid = "")
+    {
+        stream_listener_t listener;
+        listener.path = "/" + JSONPathUtil::normalize(path);
+        listener.cb = cb;
+        listener.filter = filter;
+        listener.uid = uid;
+        listeners.push_back(listener);
+    }
+
+    /**
+     * Remove the listeners of the path.
+     *
+     * @param path The node path of the listeners to remove.
+     */
+    void removeListener(const String &path)
+    {
+        String p = JSONPathUtil::normalize(path);
+        for (size_t i = 0; i < listeners.size();)
+        {
+            if (JSONPathUtil::normalize(listeners[i].path) == p)
+                listeners.erase(listeners.begin() + i);
+            else
+                i++;
+        }
+    }
+
+    /**
+     * Get the number of listeners.
+     *
+     * @return size_t The number of listeners.
+     */
+    size_t count() const { return listeners.size(); }
+
+    /**
+     * Get the common ancestor path of all listeners.
+     *
+     * @return String The path that the Stream will be started.
+     */
+    String path() const
+    {
+        if (listeners.size() == 0)
+            return "/";
+
+        String root = JSONPathUtil::normalize(listeners[0].path);
+        for (size_t i = 1; i < listeners.size(); i++)
+        {
+            String path = JSONPathUtil::normalize(listeners[i].path);
+            while (root.length() && !JSONPathUtil::isAncestor(root, path))
+            {
+                int p = root.lastIndexOf('/');
+                root.remove(p > -1 ? p : 0);
+            }
+        }
+        return "/" + root;
+    }
+
+    // Remove all listeners.
+    void clear()
+    {
+        listeners.clear();
+        stream_path.remove(0, stream_path.length());
+    }
+};
+
+#endif
+#endif
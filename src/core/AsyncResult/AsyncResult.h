@@ -10,7 +10,7 @@
 #include "./core/Core.h"
 #include "./core/AsyncResult/Value.h"
 #include "./core/Error.h"
-#include "./core/Utils/List.h"
+#include "./core/Utils/Handle.h"
 #include "./core/Utils/Timer.h"
 #include "./core/Utils/StringUtil.h"
 #include "./core/AsyncResult/AppLog.h"
@@ -37,6 +37,13 @@ namespace ares_ns
     };
 }
 
+class AsyncResult;
+
+// The response payload sink callback.
+// The data is the chunk of response payload, the final is true when the response payload was completely received
+// or the request was failed.
+typedef void (*AsyncPayloadSinkCallback)(AsyncResult &aResult, const uint8_t *data, size_t len, bool final);
+
 class AsyncResult PUBLIC_DATABASE_RESULT_BASE
 {
     friend class AsyncClientClass;
@@ -91,7 +98,7 @@ class AsyncResult PUBLIC_DATABASE_RESULT_BASE
 
 private:
     StringUtil sut;
-    uint32_t addr = 0, rvec_addr = 0;
+    ObjectHandle obj_handle;
     String val[ares_ns::max_type];
     download_data_t download_data;
     upload_data_t upload_data;
@@ -169,10 +176,13 @@ private:
     FirebaseError lastError;
     app_log_t data_log;
     uint32_t conn_ms = 0;
+    AsyncPayloadSinkCallback payload_sink = NULL;
 
     bool _downloadProgress() { return download_data.download_progress.isProgress(false); }
     bool _uploadProgress() { return upload_data.upload_progress.isProgress(false); }
     void errorPopFront() { lastError.err.pop_front(); }
+    // The handle that is kept by the async client and app instead of this object address.
+    firebase_handle_t handle() { return obj_handle.get(this, handle_type_result); }
 
 public:
     AsyncResult()
@@ -180,20 +190,10 @@ public:
 #if defined(ENABLE_DATABASE)
         setRefPayload(&rtdbResult, &val[ares_ns::data_payload]);
 #endif
-        addr = reinterpret_cast<uint32_t>(this);
         setUID();
     };
 
-    ~AsyncResult()
-    {
-        if (rvec_addr > 0)
-        {
-            std::vector<uint32_t> *rVec = reinterpret_cast<std::vector<uint32_t> *>(rvec_addr);
-            List vec;
-            addr = reinterpret_cast<uint32_t>(this);
-            vec.addRemoveList(*rVec, addr, false);
-        }
-    };
+    ~AsyncResult() {};
 
     /**
      * Get the pointer to the internal response payload string buffer.
@@ -414,6 +414,21 @@ public:
      * @return FirebaseError The internal FirebaseError object.
      */
     FirebaseError &error() { return lastError; }
+
+    /**
+     * Set the response payload sink.
+     * @param cb The AsyncPayloadSinkCallback function that receives the response payload chunks.
+     *
+     * The response payload of the async requests that are called with this async result will be passed to
+     * the callback function chunk by chunk as it was read instead of storing it in this async result.
+     * The last call is with the final parameter set to true. When the request was failed, the last call has no data
+     * and the HTTP error response payload is kept in this async result.
+     *
+     * This does not apply to the Stream, file/BLOB download and upload requests.
+     *
+     * To remove the payload sink, use AsyncResult::setPayloadSink(NULL).
+     */
+    void setPayloadSink(AsyncPayloadSinkCallback cb) { payload_sink = cb; }
 };
 
 typedef void (*AsyncResultCallback)(AsyncResult &aResult);
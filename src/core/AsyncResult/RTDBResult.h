@@ -16,6 +16,7 @@
 #include "./core/AsyncResult/AppLog.h"
 #include "./core/AsyncResult/Value.h"
 #include "./core/Utils/Timer.h"
+#include "./core/Utils/JSONTokenizer.h"
 
 namespace firebase_ns
 {
@@ -57,62 +58,86 @@ namespace firebase_ns
         }
         void parseNodeName()
         {
-            int p1 = 0, p2 = 0;
-            sut.parse(*ref_payload, "\"name\"", "}", p1, p2);
-            if (p1 > -1 && p2 > -1)
+            // The push response {"name":"-N..."}.
+            json_field_t field("name", 1, &node_name);
+            JSONTokenizer jt;
+            jt.begin(&field, 1);
+            jt.feed(*ref_payload);
+        }
+        void feed() { sse_timer.feed(FIREBASE_SSE_TIMEOUT_MS / 1000); }
+        // Find the path and data members of the event data at any order.
+        void parseSSEData(const char *s, int p1, int p2)
+        {
+            json_field_t fields[2] = {json_field_t("path", 1), json_field_t("data", 1)};
+            JSONTokenizer jt;
+            jt.begin(fields, 2);
+            jt.feed(s + p1, p2 - p1);
+            if (fields[0].found)
             {
-                node_name = ref_payload->substring(p1 + 1, p2 - 1);
+                data_path_p1 = p1 + fields[0].p1;
+                data_path_p2 = p1 + fields[0].p2;
+            }
+            if (fields[1].found)
+            {
+                // The string data is kept with its quotes.
+                bool str = s[p1 + fields[1].p1 - 1] == '"';
+                data_p1 = p1 + fields[1].p1 - (str ? 1 : 0);
+                data_p2 = p1 + fields[1].p2 + (str ? 1 : 0);
             }
         }
-        void feed() { sse_timer.feed(FIREBASE_SSE_TIMEOUT_MS / 1000); }
-        void parseSSE()
+        // Set the SSE event from the field value offsets in the event payload which were given by the event stream framer.
+        void setSSE(int event_p1, int event_p2, int data_p1, int data_p2)
         {
             clearSSE();
-            int p1 = 0, p2 = 0;
-            sut.parse(*ref_payload, "event", "\n", p1, p2);
-            if (p1 > -1 && p2 > -1)
+            if (event_p1 > -1)
             {
-                event_p1 = p1;
-                event_p2 = p2;
-                p1 = p2;
+                this->event_p1 = event_p1;
+                this->event_p2 = event_p2;
                 setEventResumeStatus(event_resume_status_undefined);
-                sse_timer.feed(String(event()).indexOf("cancel") > -1 || String(event()).indexOf("auth_revoked") > -1 ? 0 : FIREBASE_SSE_TIMEOUT_MS / 1000);
+                const char *evt = ref_payload->c_str() + event_p1;
+                size_t evtLen = event_p2 - event_p1;
+                bool closed = (evtLen == 6 && memcmp(evt, "cancel", 6) == 0) || (evtLen == 12 && memcmp(evt, "auth_revoked", 12) == 0);
+                sse_timer.feed(closed ? 0 : FIREBASE_SSE_TIMEOUT_MS / 1000);
                 sse = true;
             }
 
-            sut.parse(*ref_payload, "data", "\n", p1, p2);
-            if (p1 > -1 && p2 > -1)
+            if (data_p1 < 0)
+                return;
+
+            this->data_p1 = data_p1;
+            this->data_p2 = data_p2;
+
+            // The event data is the JSON object {"path":"...","data":...}.
+            const char *s = ref_payload->c_str();
+            static const char path_key[] = "{\"path\":\"";
+            const size_t path_key_len = sizeof(path_key) - 1;
+            if (data_p2 - data_p1 < (int)path_key_len || memcmp(s + data_p1, path_key, path_key_len) != 0)
+            {
+                // The members are not in the usual order or format.
+                parseSSEData(s, data_p1, data_p2);
+                return;
+            }
+
+            int p1 = data_p1 + path_key_len, p2 = p1;
+            while (p2 < data_p2 && s[p2] != '"')
+                p2++;
+
+            data_path_p1 = p1;
+            data_path_p2 = p2;
+
+            static const char data_key[] = ",\"data\":";
+            const size_t data_key_len = sizeof(data_key) - 1;
+            p1 = p2 + 1;
+            if (data_p2 - p1 >= (int)data_key_len && memcmp(s + p1, data_key, data_key_len) == 0)
             {
-                int p3 = p1, p4 = p2;
-                if (ref_payload->substring(p1, p2) == "null")
-                {
-                    data_p1 = p1;
-                    data_p2 = p2;
-                    return;
-                }
-
-                sut.parse(*ref_payload, "\"path\"", ",", p1, p2);
-                if (p1 > -1 && p2 > -1)
-                {
-                    data_path_p1 = p1 + 1;
-                    data_path_p2 = p2 - 1;
-                    p1 = p2;
-                }
-
-                sut.parse(*ref_payload, "\"data\"", "\n", p1, p2);
-                if (p1 > -1 && p2 > -1)
-                {
-                    if ((*ref_payload)[p2 - 1] == '}')
-                        p2--;
-                    data_p1 = p1;
-                    data_p2 = p2;
-                }
-
-                if (data_p1 == 0)
-                {
-                    data_p1 = p3;
-                    data_p2 = p4;
-                }
+                p1 += data_key_len;
+                while (p1 < data_p2 && s[p1] == ' ')
+                    p1++;
+                p2 = data_p2;
+                if (p2 > p1 && s[p2 - 1] == '}')
+                    p2--;
+                this->data_p1 = p1;
+                this->data_p2 = p2;
             }
         }
         void setEventResumeStatus(event_resume_status_t status) { event_resume_status = status; }
@@ -122,7 +147,7 @@ namespace firebase_ns
         void setRefPayload(RealtimeDatabaseResult *rtdbResult, String *payload) { rtdbResult->ref_payload = payload; }
         void clearSSE(RealtimeDatabaseResult *rtdbResult) { rtdbResult->clearSSE(); }
         void parseNodeName(RealtimeDatabaseResult *rtdbResult) { rtdbResult->parseNodeName(); }
-        void parseSSE(RealtimeDatabaseResult *rtdbResult) { rtdbResult->parseSSE(); }
+        void setSSE(RealtimeDatabaseResult *rtdbResult, int event_p1, int event_p2, int data_p1, int data_p2) { rtdbResult->setSSE(event_p1, event_p2, data_p1, data_p2); }
         void feedSSETimer(RealtimeDatabaseResult *rtdbResult) { rtdbResult->feed(); }
         void setEventResumeStatus(RealtimeDatabaseResult *rtdbResult, event_resume_status_t status) { rtdbResult->setEventResumeStatus(status); }
         event_resume_status_t eventResumeStatus(const RealtimeDatabaseResult *rtdbResult) { return rtdbResult->eventResumeStatus(); }
@@ -180,7 +205,7 @@ namespace firebase_ns
          */
         String data()
         {
-            if (data_p1 > 0)
+            if (data_p2 > data_p1)
                 return ref_payload->substring(data_p1, data_p2);
             return ref_payload ? ref_payload->c_str() : String();
         }
@@ -32,6 +32,7 @@ namespace firebase_ns
         AsyncResult *refResult = nullptr;
         bool auto_renew = true;
         bool force_refresh = false;
+        bool jwt_presign = false;
     };
 };
 #endif
\ No newline at end of file
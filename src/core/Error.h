@@ -9,6 +9,7 @@
 #define FIREBASE_ERROR_HTTP_CODE_OK 200
 #define FIREBASE_ERROR_HTTP_CODE_NON_AUTHORITATIVE_INFORMATION 203
 #define FIREBASE_ERROR_HTTP_CODE_NO_CONTENT 204
+#define FIREBASE_ERROR_HTTP_CODE_PARTIAL_CONTENT 206
 #define FIREBASE_ERROR_HTTP_CODE_MOVED_PERMANENTLY 301
 #define FIREBASE_ERROR_HTTP_CODE_FOUND 302
 #define FIREBASE_ERROR_HTTP_CODE_USE_PROXY 305
@@ -22,6 +23,7 @@
 #define FIREBASE_ERROR_HTTP_CODE_NOT_ACCEPTABLE 406
 #define FIREBASE_ERROR_HTTP_CODE_PROXY_AUTHENTICATION_REQUIRED 407
 #define FIREBASE_ERROR_HTTP_CODE_REQUEST_TIMEOUT 408
+#define FIREBASE_ERROR_HTTP_CODE_CONFLICT 409
 #define FIREBASE_ERROR_HTTP_CODE_LENGTH_REQUIRED 411
 #define FIREBASE_ERROR_HTTP_CODE_PRECONDITION_FAILED 412
 #define FIREBASE_ERROR_HTTP_CODE_PAYLOAD_TOO_LARGE 413
@@ -66,6 +68,10 @@
 #define FIREBASE_ERROR_FW_UPDATE_OTA_STORAGE_CLASS_OBJECT_UNINITIALIZE -123
 #define FIREBASE_ERROR_INVALID_DATABASE_URL -124
 #define FIREBASE_ERROR_INVALID_HOST -125
+#define FIREBASE_ERROR_GZIP_DECODING -126
+#define FIREBASE_ERROR_DOWNLOAD_HASH_MISMATCH -127
+#define FIREBASE_ERROR_NO_FREE_CONNECTION -128
+#define FIREBASE_ERROR_FW_UPDATE_UNSUPPORTED_PATCH -129
 
 #include "./core/AsyncResult/AppLog.h"
 
@@ -175,6 +181,18 @@ private:
             case FIREBASE_ERROR_INVALID_HOST:
                 err.push_back(code, "invalid host");
                 break;
+            case FIREBASE_ERROR_GZIP_DECODING:
+                err.push_back(code, "gzip decoding failed");
+                break;
+            case FIREBASE_ERROR_DOWNLOAD_HASH_MISMATCH:
+                err.push_back(code, "downloaded data hash mismatch");
+                break;
+            case FIREBASE_ERROR_NO_FREE_CONNECTION:
+                err.push_back(code, "no free server connection");
+                break;
+            case FIREBASE_ERROR_FW_UPDATE_UNSUPPORTED_PATCH:
+                err.push_back(code, "unsupported delta OTA patch format");
+                break;
             default:
                 err.push_back(code, "undefined");
                 break;
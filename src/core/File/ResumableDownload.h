@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_FILE_RESUMABLE_DOWNLOAD_H
+#define CORE_FILE_RESUMABLE_DOWNLOAD_H
+
+#include <Arduino.h>
+#include "./core/Utils/StringUtil.h"
+#include "./core/Utils/Timer.h"
+
+// The maximum number of byte-range requests to resume the interrupted download.
+#if !defined(FIREBASE_DOWNLOAD_RESUME_RETRY)
+#define FIREBASE_DOWNLOAD_RESUME_RETRY 0
+#endif
+
+// The time in seconds to wait before resuming the interrupted download.
+#if !defined(FIREBASE_DOWNLOAD_RESUME_INTERVAL_SEC)
+#define FIREBASE_DOWNLOAD_RESUME_INTERVAL_SEC 1
+#endif
+
+// The download that was interrupted by the connection drop or read time out is resumed with the byte-range
+// (Range: bytes=offset-) request, the received data is appended to the file, blob or OTA updater.
+struct file_download_resumable_data
+{
+private:
+    uint8_t max_retry = 0, retry = 0;
+    uint16_t interval = 0;
+    size_t offset = 0;
+    bool resuming = false;
+    Timer timer;
+    StringUtil sut;
+
+public:
+    file_download_resumable_data() {}
+    void setPolicy(uint8_t maxRetry, uint16_t intervalSec)
+    {
+        max_retry = maxRetry;
+        interval = intervalSec;
+    }
+    bool isEnabled() const { return max_retry > 0; }
+    // Returns false when the retry limit was reached.
+    bool resume(size_t offset)
+    {
+        if (retry >= max_retry)
+            return false;
+        retry++;
+        // The server may have ignored the previous range request, keep the written data offset.
+        if (offset > this->offset)
+            this->offset = offset;
+        timer.feed(interval);
+        resuming = true;
+        return true;
+    }
+    // The range request is waiting to be sent.
+    bool isResuming() const { return resuming; }
+    bool ready() { return !resuming || timer.ready(); }
+    void setSent() { resuming = false; }
+    size_t getOffset() const { return offset; }
+    uint8_t retryCount() const { return retry; }
+    // The number of bytes to skip at the position of payload when the server sent the whole content.
+    size_t skipLength(size_t pos, size_t len) const
+    {
+        if (pos >= offset)
+            return 0;
+        return offset - pos < len ? offset - pos : len;
+    }
+    // Set the Range header, the request header ends with the empty line.
+    void setHeader(String &header)
+    {
+        int p = header.indexOf("Range: bytes=");
+        if (p > -1)
+            header.remove(p, header.indexOf("\r\n", p) + 2 - p);
+        if (header.endsWith("\r\n\r\n"))
+        {
+            header.remove(header.length() - 2);
+            sut.printTo(header, 40, "Range: bytes=%d-\r\n\r\n", (int)offset);
+        }
+    }
+    void clear()
+    {
+        max_retry = 0;
+        retry = 0;
+        interval = 0;
+        offset = 0;
+        resuming = false;
+    }
+};
+#endif
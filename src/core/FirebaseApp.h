@@ -11,8 +11,8 @@
 #include "./core/Auth/AuthConfig.h"
 #include "./core/AsyncClient/AsyncClient.h"
 #include "./core/AsyncResult/RTDBResult.h"
-#include "./core/Utils/List.h"
 #include "./core/Utils/JSON.h"
+#include "./core/Utils/JSONTokenizer.h"
 #include "./core/Utils/Timer.h"
 #include "./core/AppBase.h"
 #include "./core/Debug.h"
@@ -33,9 +33,11 @@ namespace firebase_ns
 
     private:
         String extras, subdomain, host, uid;
-        bool deinit = false, processing = false, ul_dl_task_running = false;
+        bool deinit = false, processing = false, ul_dl_task_running = false, presign_started = false;
         uint16_t slot = 0;
-        uint32_t ref_result_addr = 0, expire = FIREBASE_DEFAULT_TOKEN_TTL, aclient_addr = 0, app_addr = 0, ref_ts = 0, await_ms = 0;
+        uint32_t expire = FIREBASE_DEFAULT_TOKEN_TTL, ref_ts = 0, await_ms = 0;
+        firebase_handle_t ref_result_handle = 0, aclient_handle = 0;
+        ObjectHandle app_handle;
 
 #if defined(ENABLE_JWT)
         JWTClass *jwtClass = nullptr;
@@ -50,10 +52,10 @@ namespace firebase_ns
         AsyncResultCallback resultCb = NULL;
 
         auth_data_t auth_data;
-        std::vector<uint32_t> aVec;                         // FirebaseApp vector
-        std::vector<uint32_t> cVec;                         // AsyncClient vector
+        std::vector<firebase_handle_t> cVec;                // AsyncClient handle vector
         std::vector<cvec_address_info_t> cvec_address_list; // The Firebase services async client list
         uint16_t app_loop_count = 0;
+        app_loop_stats_t loop_stats;
 
         Timer req_timer, auth_timer, err_timer, app_ready_timer;
         JSONUtil json;
@@ -78,11 +80,21 @@ namespace firebase_ns
                     firebase_bebug_callback(this->resultCb, *getRefResult(), __func__, __LINE__, __FILE__);
             }
 
+            // The async client that is shared by services is processed once.
+            uint32_t tick = beginLoop();
+            unsigned long us = micros();
+            size_t clients = 0;
             for (uint32_t i = 0; i < cvec_address_list.size(); i++)
             {
                 cvec_address_info_t cvec_address_info = cvec_address_list[i];
-                staticLoop(cvec_address_info.app_token, cvec_address_info.cvec_addr);
+                clients += staticLoop(cvec_address_info.app_token, cvec_address_info.service_handle, tick);
             }
+
+            loop_stats.last_us = micros() - us;
+            if (loop_stats.last_us > loop_stats.max_us)
+                loop_stats.max_us = loop_stats.last_us;
+            loop_stats.count++;
+            loop_stats.clients = clients;
         }
 
         void await(unsigned long timeoutMs = 0)
@@ -101,88 +113,65 @@ namespace firebase_ns
 
         void setLastError(AsyncResult *aResult, int code, const String &message) { setLastErrorBase(aResult, code, message); }
 
-        bool parseItem(StringUtil &sut, const String &src, String &dest, const String &name, const String &delim, int &p1, int &p2)
-        {
-            sut.parse(src, name, delim, p1, p2);
-            if (p1 > -1 && p2 > -1)
-            {
-                if (src[p1] == '"')
-                    p1++;
-                if (src[p2] == '"')
-                    p2--;
-                dest = src.substring(p1, p2);
-                p1 = p2;
-                return true;
-            }
-            p1 = 0;
-            p2 = 0;
-            return false;
-        }
-
         bool parseToken(const String &payload)
         {
-            int p1 = 0, p2 = 0;
             auth_data.app_token.clear();
-            String token, refresh, str;
+            String token, refresh, expire, uid, type, code, message, desc;
 
-            if (payload.indexOf("\"error\"") > -1)
+            // The members of the auth responses and error responses, those are read in one pass.
+            enum
             {
-                if (parseItem(sut, payload, str, "\"error\"", auth_data.user_auth.auth_type == auth_user_id_token || auth_data.user_auth.auth_type == auth_sa_custom_token ? "}" : ",", p1, p2))
-                {
-                    int code = 0;
-                    p1 = 0;
-                    p2 = 0;
-                    if (parseItem(sut, payload, str, "\"code\"", ",", p1, p2))
-                        code = atoi(str.c_str());
-                    str = "";
-                    parseItem(sut, payload, str, "\"message\"", ",", p1, p2);
-                    parseItem(sut, payload, str, "\"error_description\"", "}", p1, p2);
-                    if (str[str.length() - 1] == '"')
-                        str[str.length() - 1] = '\0';
-                    setLastError(sData ? &sData->aResult : nullptr, code, str);
-                }
-            }
-            else if (payload.indexOf("\"idToken\"") > -1)
+                f_error,
+                f_code,
+                f_message,
+                f_error_description,
+                f_id_token_v1,
+                f_refresh_token_v1,
+                f_expires_in_v1,
+                f_local_id,
+                f_id_token,
+                f_refresh_token,
+                f_expires_in,
+                f_user_id,
+                f_access_token,
+                f_token_type,
+                f_max
+            };
+
+            json_field_t fields[f_max] = {
+                json_field_t("error", 1),
+                json_field_t("code", 2, &code),
+                json_field_t("message", 2, &message),
+                json_field_t("error_description", 1, &desc),
+                json_field_t("idToken", 1, &token),
+                json_field_t("refreshToken", 1, &refresh),
+                json_field_t("expiresIn", 1, &expire),
+                json_field_t("localId", 1, &uid),
+                json_field_t("id_token", 1, &token),
+                json_field_t("refresh_token", 1, &refresh),
+                json_field_t("expires_in", 1, &expire),
+                json_field_t("user_id", 1, &uid),
+                json_field_t("access_token", 1, &token),
+                json_field_t("token_type", 1, &type)};
+
+            JSONTokenizer jt;
+            jt.begin(fields, f_max);
+            jt.feed(payload);
+
+            if (fields[f_error].found)
             {
-                parseItem(sut, payload, auth_data.app_token.val[app_tk_ns::uid], "\"localId\"", ",", p1, p2);
-                p1 = 0;
-                p2 = 0;
-                sut.trim(auth_data.app_token.val[app_tk_ns::uid]);
-                if (parseItem(sut, payload, token, "\"idToken\"", ",", p1, p2))
-                {
-                    sut.trim(token);
-                    parseItem(sut, payload, refresh, "\"refreshToken\"", ",", p1, p2);
-                    sut.trim(refresh);
-                    if (parseItem(sut, payload, str, "\"expiresIn\"", "}", p1, p2))
-                        auth_data.app_token.expire = atoi(str.c_str());
-                }
+                setLastError(sData ? &sData->aResult : nullptr, atoi(code.c_str()), fields[f_error_description].found ? desc : message);
+                token.remove(0, token.length());
+                refresh.remove(0, refresh.length());
             }
-            else if (payload.indexOf("\"id_token\"") > -1)
+            else if (fields[f_id_token_v1].found || fields[f_id_token].found || fields[f_access_token].found)
             {
-                if (parseItem(sut, payload, str, "\"expires_in\"", ",", p1, p2))
-                    auth_data.app_token.expire = atoi(str.c_str());
-                parseItem(sut, payload, refresh, "\"refresh_token\"", ",", p1, p2);
-                parseItem(sut, payload, token, "\"id_token\"", ",", p1, p2);
-                parseItem(sut, payload, auth_data.app_token.val[app_tk_ns::uid], "\"user_id\"", ",", p1, p2);
-                sut.trim(refresh);
-                sut.trim(token);
-                sut.trim(auth_data.app_token.val[app_tk_ns::uid]);
+                if (expire.length())
+                    auth_data.app_token.expire = atoi(expire.c_str());
+                auth_data.app_token.val[app_tk_ns::uid] = uid;
+                if (fields[f_access_token].found)
+                    auth_data.app_token.val[app_tk_ns::type] = type;
             }
-            else if (payload.indexOf("\"access_token\"") > -1)
-            {
-                if (parseItem(sut, payload, token, "\"access_token\"", ",", p1, p2))
-                {
-                    if (parseItem(sut, payload, str, "\"expires_in\"", ",", p1, p2))
-                        auth_data.app_token.expire = atoi(str.c_str());
-                    parseItem(sut, payload, auth_data.app_token.val[app_tk_ns::type], "\"token_type\"", "}", p1, p2);
-                }
-            }
-
-            if (token.length() > 0 && token[token.length() - 1] == '"')
-                token.remove(token.length() - 1, 1);
-
-            if (refresh.length() > 0 && refresh[refresh.length() - 1] == '"')
-                refresh.remove(refresh.length() - 1, 1);
 
             auth_data.app_token.val[app_tk_ns::token] = token;
             auth_data.app_token.val[app_tk_ns::refresh] = refresh;
@@ -194,8 +183,7 @@ namespace firebase_ns
 
         AsyncClientClass *getClient()
         {
-            List v;
-            return v.existed(cVec, aclient_addr) ? aClient : nullptr;
+            return aClient && handleRegistry().isValid(aclient_handle, handle_type_client) ? aClient : nullptr;
         }
 
         void setEvent(firebase_auth_event_type event, const String &reason = "")
@@ -272,21 +260,13 @@ namespace firebase_ns
 
         AsyncResult *getRefResult()
         {
-            List v;
-            return aClient && v.existed(getRVec(aClient), ref_result_addr) ? refResult : nullptr;
+            return aClient && handleRegistry().isValid(ref_result_handle, handle_type_result) ? refResult : nullptr;
         }
 
-        void setRefResult(AsyncResult *refResult, uint32_t rvec_addr)
+        void setRefResult(AsyncResult *refResult)
         {
             this->refResult = refResult;
-            ref_result_addr = reinterpret_cast<uint32_t>(refResult);
-            setRVec(this->refResult, rvec_addr);
-            if (rvec_addr > 0)
-            {
-                std::vector<uint32_t> *rVec = reinterpret_cast<std::vector<uint32_t> *>(rvec_addr);
-                List v;
-                v.addRemoveList(*rVec, ref_result_addr, true);
-            }
+            ref_result_handle = refResult ? resultHandleBase(refResult) : 0;
         }
 
         void newRequest(AsyncClientClass *aClient, slot_options_t &soption, const String &subdomain, const String &extras, AsyncResultCallback resultCb, const String &uid = "", const String &etag = "")
@@ -366,6 +346,10 @@ namespace firebase_ns
 
             process(aClient);
 
+#if defined(ENABLE_JWT)
+            preSign();
+#endif
+
             if (!isExpired() || (isExpired() && auth_data.app_token.val[app_tk_ns::token].length() && !auth_data.auto_renew && !auth_data.force_refresh))
                 return true;
 
@@ -444,6 +428,12 @@ namespace firebase_ns
 
                         jwtProcessor()->begin(&auth_data);
                     }
+                    else if (auth_data.user_auth.sa.step == jwt_step_ready && !auth_data.user_auth.jwt_signing &&
+                             millis() - jwtProcessor()->jwt_data.ms > FIREBASE_JWT_PRESIGN_MAX_AGE_SEC * 1000UL)
+                    {
+                        // The pre-signed JWT is too old, sign the new one.
+                        jwtProcessor()->clear();
+                    }
                     else if (auth_data.user_auth.sa.step == jwt_step_sign || auth_data.user_auth.sa.step == jwt_step_ready)
                     {
                         if (jwtProcessor()->ready())
@@ -677,29 +667,57 @@ namespace firebase_ns
         {
             auth_data.app_token.clear();
             auth_data.user_auth.clear();
+#if defined(ENABLE_JWT)
+            jwtProcessor()->releaseKey();
+#endif
             setEvent(auth_event_deinitialized);
             setEvent(auth_event_uninitialized);
         }
 
 #if defined(ENABLE_JWT)
         JWTClass *jwtProcessor() { return jwtClass ? jwtClass : &jwtInstance; }
+
+        // Sign the next JWT before the token was expired.
+        // The signing steps are run by the JWT processor in appLoop, one step in each loop,
+        // and the signed JWT is used for the token request when the token was expired.
+        void preSign()
+        {
+            bool jwt_auth = auth_data.user_auth.auth_type == auth_sa_access_token ||
+                            (auth_data.user_auth.auth_type == auth_sa_custom_token && auth_data.app_token.val[app_tk_ns::refresh].length() == 0);
+
+            if (!auth_data.jwt_presign || !jwt_auth || auth_data.user_auth.status._event != auth_event_ready || isExpired())
+                return;
+
+            if (ttl() > FIREBASE_JWT_PRESIGN_SEC)
+            {
+                presign_started = false;
+                return;
+            }
+
+            if (!presign_started && auth_data.user_auth.sa.step == jwt_step_begin)
+            {
+                presign_started = true;
+                auth_data.user_auth.jwt_signing = true;
+                jwtProcessor()->begin(&auth_data, true);
+            }
+            else if (auth_data.user_auth.jwt_signing && (jwtProcessor()->ready() || auth_data.user_auth.sa.step == jwt_step_error))
+            {
+                // The failed JWT will be signed again when the token was expired.
+                if (auth_data.user_auth.sa.step == jwt_step_error)
+                    jwtProcessor()->clear();
+                auth_data.user_auth.jwt_signing = false;
+            }
+        }
 #endif
 
     public:
-        FirebaseApp()
-        {
-            app_addr = reinterpret_cast<uint32_t>(this);
-            List v;
-            v.addRemoveList(aVec, app_addr, true);
-        };
+        FirebaseApp() { app_handle.get(this, handle_type_app); };
 
         ~FirebaseApp()
         {
             if (sData)
                 delete sData;
             sData = nullptr;
-            List v;
-            v.addRemoveList(aVec, app_addr, false);
         };
 
         /**
@@ -743,6 +761,17 @@ namespace firebase_ns
          */
         bool ready() { return processAuth() && auth_data.app_token.authenticated; }
 
+        /**
+         * Get the async clients loop cost.
+         *
+         * @return app_loop_stats_t The time spent in processing the async clients of the Firebase services that were applied
+         * with getApp, in the last loop and the longest loop in microseconds, the number of loops and the number of async clients
+         * that were processed in the last loop.
+         *
+         * The async client that is used by many Firebase services is processed once in each loop.
+         */
+        app_loop_stats_t loopStats() const { return loop_stats; }
+
         /**
          * Appy the authentication/authorization credentials to the Firebase services app.
          *
@@ -755,10 +784,10 @@ namespace firebase_ns
 
             cvec_address_info_t cvec_address_info;
             cvec_address_info.app_token = &auth_data.app_token;
-            cvec_address_info.app_addr = app_addr;
-            cvec_address_info.cvec_addr = cVecAddr(app);
+            cvec_address_info.app_handle = app_handle.get(this, handle_type_app);
+            cvec_address_info.service_handle = serviceHandle(app);
             cvec_address_list.push_back(cvec_address_info);
-            setAppBase(app, app_addr, &auth_data, reinterpret_cast<uint32_t>(&aVec), reinterpret_cast<uint32_t>(&ul_dl_task_running), reinterpret_cast<uint32_t>(&cvec_address_list), reinterpret_cast<uint32_t>(&app_loop_count));
+            setAppBase(app, cvec_address_info.app_handle, &auth_data, &ul_dl_task_running, &cvec_address_list, &app_loop_count);
         }
 
         /**
@@ -888,6 +917,19 @@ namespace firebase_ns
          */
         void autoAuthenticate(bool enable) { auth_data.auto_renew = enable; }
 
+#if defined(ENABLE_JWT)
+        /**
+         * Set the option to enable/disable the JWT pre-signing.
+         *
+         * @param enable Set to true to enable or false to disable.
+         *
+         * When enabled, the next JWT is signed in the idle loops within FIREBASE_JWT_PRESIGN_SEC seconds before the token expires,
+         * and the token request is sent without signing when the token was expired.
+         * This applies to ServiceAuth and CustomAuth only.
+         */
+        void preSignJWT(bool enable) { auth_data.jwt_presign = enable; }
+#endif
+
         /**
          * Force library to re-authenticate (refresh the auth token).
          */
@@ -42,6 +42,7 @@ namespace firebase_ns
 
     inline JWTClass::~JWTClass()
     {
+        releaseKey();
 #if defined(USE_EMBED_SSL_ENGINE)
         stack_thunk_del_ref();
 #endif
@@ -54,6 +55,7 @@ namespace firebase_ns
         sut.clear(jwt_data.token);
         sut.clear(jwt_data.pk);
         sut.clear(payload);
+        key_parsed = false;
         if (this->auth_data)
         {
             this->auth_data->user_auth.sa.step = jwt_step_begin;
@@ -63,6 +65,114 @@ namespace firebase_ns
         processing = false;
     }
 
+    // The SHA-256 digest of the private key, to check whether the cached key was changed.
+    inline void JWTClass::keyDigest(const String &key, uint8_t *out)
+    {
+#if defined(ESP32)
+        mbedtls_md(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), (const unsigned char *)key.c_str(), key.length(), out);
+#else
+        br_sha256_context mc;
+        br_sha256_init(&mc);
+        br_sha256_update(&mc, key.c_str(), key.length());
+        br_sha256_out(&mc, out);
+#endif
+    }
+
+    inline bool JWTClass::loadKey(const String &key)
+    {
+        uint8_t digest[32];
+        keyDigest(key, digest);
+        if (key_loaded && memcmp(key_digest, digest, sizeof(digest)) == 0)
+        {
+            sign_stats.key_us = 0;
+            sign_stats.reused++;
+            return true;
+        }
+
+        releaseKey();
+        if (key.length() == 0)
+            return false;
+
+        unsigned long us = micros();
+#if defined(ESP32)
+        int ret = 0;
+        pk_ctx = new mbedtls_pk_context();
+        mbedtls_pk_init(pk_ctx);
+#if defined(ESP32_CORE_V3_UP)
+        ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)key.c_str(), key.length() + 1, 0, 0, 0, 0);
+#else
+        ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)key.c_str(), key.length() + 1, NULL, 0);
+#endif
+        if (ret == 0)
+        {
+            entropy_ctx = new mbedtls_entropy_context();
+            ctr_drbg_ctx = new mbedtls_ctr_drbg_context();
+            mbedtls_entropy_init(entropy_ctx);
+            mbedtls_ctr_drbg_init(ctr_drbg_ctx);
+            ret = mbedtls_ctr_drbg_seed(ctr_drbg_ctx, mbedtls_entropy_func, entropy_ctx, NULL, 0);
+        }
+        if (ret != 0)
+        {
+            releaseKey();
+            return false;
+        }
+#else
+        pk = new PrivateKey(key.c_str());
+        if (!pk->isRSA())
+        {
+            releaseKey();
+            return false;
+        }
+#endif
+        memcpy(key_digest, digest, sizeof(digest));
+        key_loaded = true;
+        sign_stats.key_us = micros() - us;
+        return true;
+    }
+
+    // Free and wipe the cached private key.
+    // The mbedTLS contexts are zeroized by their free functions, the BearSSL key components are zeroized here before they are freed.
+    inline void JWTClass::releaseKey()
+    {
+#if defined(ESP32)
+        if (pk_ctx)
+        {
+            mbedtls_pk_free(pk_ctx);
+            delete pk_ctx;
+            pk_ctx = nullptr;
+        }
+        if (ctr_drbg_ctx)
+        {
+            mbedtls_ctr_drbg_free(ctr_drbg_ctx);
+            delete ctr_drbg_ctx;
+            ctr_drbg_ctx = nullptr;
+        }
+        if (entropy_ctx)
+        {
+            mbedtls_entropy_free(entropy_ctx);
+            delete entropy_ctx;
+            entropy_ctx = nullptr;
+        }
+#else
+        if (pk)
+        {
+            const br_rsa_private_key *rsa = pk->isRSA() ? pk->getRSA() : nullptr;
+            if (rsa)
+            {
+                memset(rsa->p, 0, rsa->plen);
+                memset(rsa->q, 0, rsa->qlen);
+                memset(rsa->dp, 0, rsa->dplen);
+                memset(rsa->dq, 0, rsa->dqlen);
+                memset(rsa->iq, 0, rsa->iqlen);
+            }
+            delete pk;
+            pk = nullptr;
+        }
+#endif
+        memset(key_digest, 0, sizeof(key_digest));
+        key_loaded = false;
+    }
+
     inline bool JWTClass::ready() { return this->auth_data && this->auth_data->user_auth.sa.step == jwt_step_ready; }
 
     inline bool JWTClass::loop(auth_data_t *auth_data)
@@ -119,7 +229,8 @@ namespace firebase_ns
 
     inline void JWTClass::setAppDebug(app_log_t *debug_log) { this->debug_log = debug_log; }
 
-    inline bool JWTClass::begin(auth_data_t *auth_data)
+    // The current auth token is kept when the next token is signed before it was expired.
+    inline bool JWTClass::begin(auth_data_t *auth_data, bool keep_token)
     {
         if (processing || !auth_data)
             return false;
@@ -128,7 +239,8 @@ namespace firebase_ns
         {
             processing = true;
             this->auth_data = auth_data;
-            this->auth_data->app_token.clear();
+            if (!keep_token)
+                this->auth_data->app_token.clear();
             this->auth_data->user_auth.jwt_ts = millis();
             this->auth_data->user_auth.sa.step = jwt_step_create_jwt;
             processing = false;
@@ -177,6 +289,7 @@ namespace firebase_ns
 
             size_t len = 0;
             jwt_data.token = "eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9"; // base64 encoded string of JWT header
+            jwt_data.ms = millis();
 
             // payload
             // {"iss":"<email>","sub":"<email>","aud":"<audience>","iat":<timstamp>,"exp":<expire>,"scope":"<scope>"}
@@ -246,41 +359,39 @@ namespace firebase_ns
         else if (auth_data->user_auth.sa.step == jwt_step_sign)
         {
             int ret = 0;
-#if defined(ESP32)
 
-            mbedtls_pk_context *pk_ctx = new mbedtls_pk_context();
-            mbedtls_pk_init(pk_ctx);
+            // The key parsing and the RSA signing are run in separate loops to shorten the time that each loop was blocked.
+            // The RSA signing itself is one blocking call of mbedTLS or BearSSL.
+            if (!key_parsed)
+            {
+                const String &key = jwt_data.pk.length() > 0 ? jwt_data.pk : auth_data->user_auth.sa.val[sa_ns::pk];
 
-// parse priv key
-#if defined(ESP32_CORE_V3_UP)
-            if (jwt_data.pk.length() > 0)
-                ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)jwt_data.pk.c_str(), jwt_data.pk.length() + 1, 0, 0, 0, 0);
-            else if (auth_data->user_auth.sa.val[sa_ns::pk].length() > 0)
-                ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)auth_data->user_auth.sa.val[sa_ns::pk].c_str(), auth_data->user_auth.sa.val[sa_ns::pk].length() + 1, 0, 0, 0, 0);
-#else
-            if (jwt_data.pk.length() > 0)
-                ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)jwt_data.pk.c_str(), jwt_data.pk.length() + 1, NULL, 0);
-            else if (auth_data->user_auth.sa.val[sa_ns::pk].length() > 0)
-                ret = mbedtls_pk_parse_key(pk_ctx, (const unsigned char *)auth_data->user_auth.sa.val[sa_ns::pk].c_str(), auth_data->user_auth.sa.val[sa_ns::pk].length() + 1, NULL, 0);
+                sys_idle();
+                bool loaded = loadKey(key);
+                sut.clear(jwt_data.pk);
 
-#endif
-            if (ret != 0)
-            {
-                jwt_data.err_code = FIREBASE_ERROR_TOKEN_PARSE_PK;
-                jwt_data.msg = "JWT, private key parsing failed";
-                auth_data->user_auth.sa.step = jwt_step_error;
-                return exit(false);
+                if (!loaded)
+                {
+                    jwt_data.err_code = FIREBASE_ERROR_TOKEN_PARSE_PK;
+                    jwt_data.msg = "JWT, private key parsing failed";
+                    auth_data->user_auth.sa.step = jwt_step_error;
+                    return exit(false);
+                }
+
+                if (sign_stats.key_us > 0)
+                {
+                    key_parsed = true;
+                    return exit(true);
+                }
             }
+            key_parsed = false;
+            unsigned long us = micros();
 
             // generate RSA signature from private key and message digest
             if (!jwt_data.signature)
                 jwt_data.signature = reinterpret_cast<unsigned char *>(mem.alloc(256));
+#if defined(ESP32)
             size_t sigLen = 0;
-            mbedtls_entropy_context *entropy_ctx = new mbedtls_entropy_context();
-            mbedtls_ctr_drbg_context *ctr_drbg_ctx = new mbedtls_ctr_drbg_context();
-            mbedtls_entropy_init(entropy_ctx);
-            mbedtls_ctr_drbg_init(ctr_drbg_ctx);
-            mbedtls_ctr_drbg_seed(ctr_drbg_ctx, mbedtls_entropy_func, entropy_ctx, NULL, 0);
 #if defined(ESP32_CORE_V3_UP)
             ret = mbedtls_pk_sign(pk_ctx, MBEDTLS_MD_SHA256, (const unsigned char *)jwt_data.hash, 32, jwt_data.signature, 256, &sigLen, mbedtls_ctr_drbg_random, ctr_drbg_ctx);
 #else
@@ -295,58 +406,15 @@ namespace firebase_ns
             }
 
             ret = 1;
-            mbedtls_pk_free(pk_ctx);
-            mbedtls_entropy_free(entropy_ctx);
-            mbedtls_ctr_drbg_free(ctr_drbg_ctx);
-            delete pk_ctx;
-            delete entropy_ctx;
-            delete ctr_drbg_ctx;
-
 #else
-            // RSA private key
-            PrivateKey *pk = nullptr;
-            sys_idle();
-
-            // parse priv key
-            if (jwt_data.pk.length() > 0)
-                pk = new PrivateKey(jwt_data.pk.c_str());
-            else if (auth_data->user_auth.sa.val[sa_ns::pk].length() > 0)
-                pk = new PrivateKey(auth_data->user_auth.sa.val[sa_ns::pk].c_str());
-
-            sut.clear(jwt_data.pk);
-
-            if (!pk)
-            {
-                jwt_data.err_code = FIREBASE_ERROR_TOKEN_PARSE_PK;
-                jwt_data.msg = "JWT, private key parsing failed";
-                auth_data->user_auth.sa.step = jwt_step_error;
-                return exit(false);
-            }
-
-            if (!pk->isRSA())
-            {
-                delete pk;
-                pk = nullptr;
-                jwt_data.err_code = FIREBASE_ERROR_TOKEN_PARSE_PK;
-                jwt_data.msg = "JWT, invalid RSA private key";
-                auth_data->user_auth.sa.step = jwt_step_error;
-                return exit(false);
-            }
-
-            const br_rsa_private_key *br_rsa_key = pk->getRSA();
-
-            // generate RSA signature from private key and message digest
             sys_idle();
-            if (!jwt_data.signature)
-                jwt_data.signature = reinterpret_cast<unsigned char *>(mem.alloc(256));
-            ret = br_rsa_i15_pkcs1_sign(BR_HASH_OID_SHA256, reinterpret_cast<const unsigned char *>(jwt_data.hash), br_sha256_SIZE, br_rsa_key, jwt_data.signature);
+            ret = br_rsa_i15_pkcs1_sign(BR_HASH_OID_SHA256, reinterpret_cast<const unsigned char *>(jwt_data.hash), br_sha256_SIZE, pk->getRSA(), jwt_data.signature);
             sys_idle();
-
-            delete pk;
-            pk = nullptr;
-
 #endif
 
+            sign_stats.last_us = micros() - us;
+            sign_stats.count++;
+
             if (jwt_data.hash)
                 mem.release(&jwt_data.hash);
 
@@ -34,10 +34,20 @@ namespace firebase_ns
     {
         String token, msg, pk;
         int err_code = 0;
+        uint32_t ms = 0;                    // The time in milliseconds that the token was created.
         char *hash = nullptr;               // SHA256 size (256 bits or 32 bytes)
         unsigned char *signature = nullptr; // 256 bytes
     };
 
+    // The JWT signing cost.
+    struct jwt_sign_stats_t
+    {
+        uint32_t last_us = 0; // The time spent in the last signing in microseconds.
+        uint32_t key_us = 0;  // The time spent in parsing the private key (and seeding the random generator) in the last signing, 0 when the cached key was used.
+        uint32_t count = 0;   // The number of signings.
+        uint32_t reused = 0;  // The number of signings that used the cached key.
+    };
+
     class JWTClass
     {
         friend class FirebaseApp;
@@ -55,6 +65,20 @@ namespace firebase_ns
         auth_data_t *auth_data = nullptr;
         app_log_t *debug_log = nullptr;
         bool processing = false;
+        jwt_sign_stats_t sign_stats;
+
+        // The parsed private key that is kept for the next signings until the key was changed or the app was deinitialized.
+        // The key is identified by its SHA-256 digest.
+        uint8_t key_digest[32];
+        bool key_loaded = false;
+        bool key_parsed = false; // The key was parsed in this signing step, the RSA signing is done in the next loop.
+#if defined(ESP32)
+        mbedtls_pk_context *pk_ctx = nullptr;
+        mbedtls_entropy_context *entropy_ctx = nullptr;
+        mbedtls_ctr_drbg_context *ctr_drbg_ctx = nullptr;
+#else
+        PrivateKey *pk = nullptr;
+#endif
 
         bool exit(bool ret)
         {
@@ -66,7 +90,7 @@ namespace firebase_ns
             return ret;
         }
 
-        bool begin(auth_data_t *auth_data);
+        bool begin(auth_data_t *auth_data, bool keep_token = false);
         bool create();
         void sendErrCB(AsyncResultCallback cb, AsyncResult *aResult = nullptr);
         void sendErrResult(AsyncResult *refResult);
@@ -74,6 +98,9 @@ namespace firebase_ns
         const char *token();
         bool ready();
         void clear();
+        void keyDigest(const String &key, uint8_t *out);
+        bool loadKey(const String &key);
+        void releaseKey();
 
     public:
         JWTClass();
@@ -85,6 +112,16 @@ namespace firebase_ns
          * @return boolean of JWT processor result.
          */
         bool loop(auth_data_t *auth_data);
+
+        /**
+         * Get the JWT signing cost.
+         *
+         * @return jwt_sign_stats_t The time spent in the last signing and in parsing the private key in microseconds,
+         * the number of signings and the number of signings that used the cached private key.
+         *
+         * The private key is parsed at the first signing and kept until the key was changed or the app was deinitialized.
+         */
+        jwt_sign_stats_t signStats() const { return sign_stats; }
     };
 }
 #endif
@@ -196,4 +196,15 @@
 // too long delay in time status callback.
 #define FIREBASE_JWT_TIMEOUT_MS 60 * 1000
 
+// The time in seconds before the token expires, that the next JWT is signed in the idle loops
+// when the JWT pre-signing was enabled with FirebaseApp::preSignJWT.
+#if !defined(FIREBASE_JWT_PRESIGN_SEC)
+#define FIREBASE_JWT_PRESIGN_SEC 90
+#endif
+
+// The maximum age in seconds of the pre-signed JWT that can be used for the token request.
+#if !defined(FIREBASE_JWT_PRESIGN_MAX_AGE_SEC)
+#define FIREBASE_JWT_PRESIGN_MAX_AGE_SEC 3000
+#endif
+
 #endif
\ No newline at end of file
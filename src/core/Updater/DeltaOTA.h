@@ -0,0 +1,477 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UPDATER_DELTA_OTA_H
+#define CORE_UPDATER_DELTA_OTA_H
+
+#include <Arduino.h>
+#include "./core/Updater/OTAUpdater.h"
+#include "./core/Utils/Memory.h"
+#include "./core/Utils/Gzip.h"
+
+#if defined(ENABLE_DELTA_OTA) && defined(OTA_UPDATE_ENABLED) && defined(FIREBASE_OTA_UPDATER)
+
+#define FIREBASE_DELTA_OTA
+
+#if defined(ESP32)
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#endif
+
+// The size in bytes of the running image read buffer and the patched image write buffer.
+#if !defined(FIREBASE_DELTA_OTA_BUFFER_SIZE)
+#define FIREBASE_DELTA_OTA_BUFFER_SIZE 512
+#endif
+
+static const char firebase_delta_ota_magic[] PROGMEM = "ENDSLEY/BSDIFF43";
+// The original bsdiff 4.0 patch which its control, diff and extra blocks are bzip2 compressed separately.
+static const char firebase_delta_ota_bsdiff40_magic[] PROGMEM = "BSDIFF40";
+
+// The callback that reads the image that the patch is applied to.
+typedef bool (*OTASourceReader)(uint32_t offset, uint8_t *buf, size_t len);
+
+// The delta OTA update.
+// The downloaded firmware can be the full image or the binary patch of the running image.
+// The patch is applied while it is downloaded, the running image is read and the patched image is written
+// through the OTA updater in blocks of FIREBASE_DELTA_OTA_BUFFER_SIZE bytes.
+//
+// The patch format is the ENDSLEY/BSDIFF43 header (16 bytes magic and 8 bytes patched image size) followed by
+// the uncompressed bsdiff control, diff and extra data interleaved, the whole patch can be gzip compressed when
+// ENABLE_GZIP is defined.
+// The bsdiff tool writes this data as bzip2 stream which needs too much RAM to decompress on device,
+// use extras/host/tools/delta_ota_patch.py to convert the bsdiff patch to this format.
+// The bzip2 compressed patch and the original BSDIFF40 patch are rejected (isUnsupportedPatch()).
+class DeltaOTAClass
+{
+private:
+    enum state_t
+    {
+        st_idle,
+        st_detect,  // Reading the magic.
+        st_header,  // Reading the patched image size.
+        st_ctrl,    // Reading the control data.
+        st_diff,    // Reading the diff data that is added to the running image.
+        st_extra,   // Reading the extra data that is copied as it is.
+        st_done,
+        st_passthrough, // The full image.
+        st_error
+    };
+
+    Memory mem;
+    state_t state = st_idle;
+    bool gzip = false, unsupported = false;
+    int command = 0;
+    size_t size = 0;
+    uint8_t head[24];
+    uint8_t head_len = 0;
+    int64_t new_size = 0, new_pos = 0, old_pos = 0, remaining = 0, seek = 0, extra_len = 0;
+    size_t patch_len = 0, image_len = 0;
+
+    uint8_t *old_buf = nullptr, *out_buf = nullptr;
+    uint32_t old_base = 0, old_len = 0, source_size = 0;
+    size_t out_len = 0;
+    OTASourceReader reader = nullptr;
+
+#if defined(ENABLE_GZIP)
+    GzipDecoder *gz = nullptr;
+    uint8_t *gz_buf = nullptr;
+#endif
+
+    // The bsdiff offset, the sign-magnitude 64-bit little endian integer.
+    static int64_t offtin(const uint8_t *p)
+    {
+        int64_t v = p[7] & 0x7f;
+        for (int i = 6; i >= 0; i--)
+            v = v * 256 + p[i];
+        return p[7] & 0x80 ? -v : v;
+    }
+
+    static bool readRunningImage(uint32_t offset, uint8_t *buf, size_t len)
+    {
+#if defined(ESP32)
+        const esp_partition_t *part = esp_ota_get_running_partition();
+        return part && esp_partition_read(part, offset, buf, len) == ESP_OK;
+#elif defined(ESP8266)
+        // The offset and length are 4-byte aligned.
+        return ESP.flashRead(offset, reinterpret_cast<uint32_t *>(buf), len);
+#elif defined(CORE_ARDUINO_PICO)
+        memcpy(buf, reinterpret_cast<const uint8_t *>(XIP_BASE) + offset, len);
+        return true;
+#else
+        (void)offset;
+        (void)buf;
+        (void)len;
+        return false;
+#endif
+    }
+
+    static uint32_t runningImageSize()
+    {
+#if defined(ESP32)
+        const esp_partition_t *part = esp_ota_get_running_partition();
+        return part ? part->size : 0;
+#elif defined(ESP8266)
+        return (ESP.getSketchSize() + 3) & ~3UL;
+#elif defined(CORE_ARDUINO_PICO)
+        return 0xffffffff;
+#else
+        return 0;
+#endif
+    }
+
+    // The running image byte, 0 when the position is out of the image as bspatch does.
+    bool oldByte(int64_t pos, uint8_t &b)
+    {
+        b = 0;
+        if (pos < 0 || pos >= source_size)
+            return true;
+
+        if (pos < old_base || pos >= old_base + old_len)
+        {
+            old_base = pos & ~3UL;
+            old_len = source_size - old_base < FIREBASE_DELTA_OTA_BUFFER_SIZE ? source_size - old_base : FIREBASE_DELTA_OTA_BUFFER_SIZE;
+            if (!(reader ? reader : readRunningImage)(old_base, old_buf, old_len))
+            {
+                old_len = 0;
+                return false;
+            }
+        }
+        b = old_buf[pos - old_base];
+        return true;
+    }
+
+    bool flush()
+    {
+        if (out_len && FIREBASE_OTA_UPDATER.write(out_buf, out_len) != out_len)
+            return false;
+        image_len += out_len;
+        out_len = 0;
+        return true;
+    }
+
+    bool put(uint8_t b)
+    {
+        out_buf[out_len++] = b;
+        return out_len < FIREBASE_DELTA_OTA_BUFFER_SIZE || flush();
+    }
+
+    // Check whether the data is the beginning of the magic.
+    static bool isMagic(const uint8_t *data, size_t len, const char *magic)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            if (data[i] != (uint8_t)pgm_read_byte(magic + i))
+                return false;
+        }
+        return true;
+    }
+
+    bool beginUpdate(size_t len) { return FIREBASE_OTA_UPDATER.begin(len, command); }
+
+    // The magic was not matched, write the full image.
+    bool passthrough()
+    {
+        state = st_passthrough;
+        if (!beginUpdate(size) || FIREBASE_OTA_UPDATER.write(head, head_len) != head_len)
+            return false;
+        image_len += head_len;
+        return true;
+    }
+
+    bool nextCtrl()
+    {
+        if (new_pos == new_size)
+        {
+            state = st_done;
+            return flush();
+        }
+        state = st_ctrl;
+        head_len = 0;
+        return true;
+    }
+
+    bool nextExtra()
+    {
+        state = st_extra;
+        remaining = extra_len;
+        if (remaining)
+            return true;
+        old_pos += seek;
+        return nextCtrl();
+    }
+
+    // Parse the patch (or the full image) data.
+    bool parse(const uint8_t *data, size_t len)
+    {
+        size_t i = 0;
+        while (i < len && state != st_error)
+        {
+            switch (state)
+            {
+            case st_detect:
+            {
+                uint8_t b = data[i++];
+                head[head_len++] = b;
+#if defined(ENABLE_GZIP)
+                if (!gzip && head_len == 1 && b == 0x1f)
+                    break;
+                if (!gzip && head_len == 2 && head[0] == 0x1f && b == 0x8b)
+                {
+                    // The compressed patch, the gzip magic and the remaining data are decompressed.
+                    static const uint8_t magic[2] = {0x1f, 0x8b};
+                    head_len = 0;
+                    gzip = true;
+                    return beginGzip() && inflate(magic, 2) && inflate(data + i, len - i);
+                }
+#endif
+                bool bsdiff40 = head_len <= 8 && isMagic(head, head_len, firebase_delta_ota_bsdiff40_magic);
+                if (bsdiff40 && head_len == 8)
+                {
+                    unsupported = true;
+                    return false;
+                }
+                if (!bsdiff40 && !isMagic(head, head_len, firebase_delta_ota_magic))
+                {
+                    // The compressed data should be the patch.
+                    if (gzip || !passthrough())
+                        return false;
+                    // The remaining data is written as it is.
+                    if (i < len && FIREBASE_OTA_UPDATER.write(const_cast<uint8_t *>(data + i), len - i) != len - i)
+                        return false;
+                    image_len += len - i;
+                    return true;
+                }
+                if (head_len == 16 && !bsdiff40)
+                    state = st_header;
+                break;
+            }
+
+            case st_header:
+                head[head_len++] = data[i++];
+                if (head_len == 24)
+                {
+                    new_size = offtin(head + 16);
+                    if (new_size < 0 || !beginUpdate(new_size))
+                        return false;
+                    if (!nextCtrl())
+                        return false;
+                }
+                break;
+
+            case st_ctrl:
+                head[head_len++] = data[i++];
+                if (head_len == 24)
+                {
+                    // The bzip2 stream of the bsdiff tool output that was not converted.
+                    if (new_pos == 0 && memcmp(head, "BZh", 3) == 0)
+                    {
+                        unsupported = true;
+                        return false;
+                    }
+                    remaining = offtin(head);
+                    extra_len = offtin(head + 8);
+                    seek = offtin(head + 16);
+                    if (remaining < 0 || extra_len < 0 || new_pos + remaining + extra_len > new_size)
+                        return false;
+                    state = st_diff;
+                    if (!remaining && !nextExtra())
+                        return false;
+                }
+                break;
+
+            case st_diff:
+            {
+                uint8_t b = 0;
+                if (!oldByte(old_pos, b) || !put(data[i++] + b))
+                    return false;
+                old_pos++;
+                new_pos++;
+                if (--remaining == 0 && !nextExtra())
+                    return false;
+                break;
+            }
+
+            case st_extra:
+                if (!put(data[i++]))
+                    return false;
+                new_pos++;
+                if (--remaining == 0)
+                {
+                    old_pos += seek;
+                    if (!nextCtrl())
+                        return false;
+                }
+                break;
+
+            case st_passthrough:
+                if (FIREBASE_OTA_UPDATER.write(const_cast<uint8_t *>(data + i), len - i) != len - i)
+                    return false;
+                image_len += len - i;
+                return true;
+
+            default:
+                // The data after the patch e.g. the Base64 padding bytes are ignored.
+                return true;
+            }
+        }
+        return state != st_error;
+    }
+
+#if defined(ENABLE_GZIP)
+    bool beginGzip()
+    {
+        if (!gz)
+            gz = new GzipDecoder();
+        if (!gz_buf)
+            gz_buf = reinterpret_cast<uint8_t *>(mem.alloc(FIREBASE_DELTA_OTA_BUFFER_SIZE, false));
+        return gz_buf && gz->begin();
+    }
+
+    bool inflate(const uint8_t *data, size_t len)
+    {
+        while (!gz->isDone())
+        {
+            size_t consumed = 0, produced = 0;
+            if (gz->decode(data, len, consumed, gz_buf, FIREBASE_DELTA_OTA_BUFFER_SIZE, produced) == GzipDecoder::gzip_status_error)
+                return false;
+            if (produced && !parse(gz_buf, produced))
+                return false;
+            data += consumed;
+            len -= consumed;
+            // The output buffer is full, the decoder may have more data without the input.
+            if (produced < FIREBASE_DELTA_OTA_BUFFER_SIZE && (len == 0 || consumed == 0))
+                break;
+        }
+        return true;
+    }
+#endif
+
+    void release()
+    {
+        mem.release(&old_buf);
+        mem.release(&out_buf);
+#if defined(ENABLE_GZIP)
+        mem.release(&gz_buf);
+        if (gz)
+            delete gz;
+        gz = nullptr;
+#endif
+    }
+
+public:
+    DeltaOTAClass() {}
+
+    ~DeltaOTAClass() { release(); }
+
+    /**
+     * Start the update.
+     *
+     * @param size The full image size that is used when the downloaded data is not the patch.
+     * @param command The OTA updater command.
+     * @return bool Return false when the buffers can't be allocated.
+     *
+     * The OTA updater begins when the first data was received.
+     */
+    bool begin(size_t size, int command = 0)
+    {
+        release();
+        this->size = size;
+        this->command = command;
+        state = st_detect;
+        gzip = false;
+        unsupported = false;
+        head_len = 0;
+        new_size = 0;
+        new_pos = 0;
+        old_pos = 0;
+        remaining = 0;
+        patch_len = 0;
+        image_len = 0;
+        out_len = 0;
+        old_base = 0;
+        old_len = 0;
+        if (!reader)
+            source_size = runningImageSize();
+        old_buf = reinterpret_cast<uint8_t *>(mem.alloc(FIREBASE_DELTA_OTA_BUFFER_SIZE, false));
+        out_buf = reinterpret_cast<uint8_t *>(mem.alloc(FIREBASE_DELTA_OTA_BUFFER_SIZE, false));
+        if (!old_buf || !out_buf)
+        {
+            release();
+            state = st_idle;
+        }
+        return state == st_detect;
+    }
+
+    bool write(const uint8_t *data, size_t len)
+    {
+        if (state == st_idle || state == st_error)
+            return false;
+
+        patch_len += len;
+        bool ret = true;
+#if defined(ENABLE_GZIP)
+        if (gzip)
+            ret = inflate(data, len);
+        else
+#endif
+            ret = parse(data, len);
+
+        if (!ret)
+            state = st_error;
+        return ret;
+    }
+
+    /**
+     * Finish the update.
+     *
+     * @return bool Return true when the full image was written or the patch was applied completely.
+     * The OTA updater should be ended after this.
+     */
+    bool end()
+    {
+        bool ret = state == st_passthrough || (state == st_done && flush());
+        release();
+        state = st_idle;
+        return ret;
+    }
+
+    bool isActive() const { return state != st_idle; }
+
+    /**
+     * Check whether the patch was rejected because of its format.
+     *
+     * @return bool Return true when the patch is the bzip2 compressed bsdiff patch or the BSDIFF40 patch
+     * that should be converted with extras/host/tools/delta_ota_patch.py.
+     */
+    bool isUnsupportedPatch() const { return unsupported; }
+
+    /**
+     * Set the callback that reads the image that the patch is applied to.
+     *
+     * @param reader The reader callback, or nullptr to read the running image (ESP32, ESP8266 and RP2040).
+     * @param size The image size in bytes.
+     */
+    void setSourceReader(OTASourceReader reader, uint32_t size)
+    {
+        this->reader = reader;
+        source_size = reader ? size : runningImageSize();
+    }
+
+    // The number of downloaded bytes (the patch or the full image).
+    size_t downloadSize() const { return patch_len; }
+
+    // The number of bytes written to the OTA updater.
+    size_t imageSize() const { return image_len; }
+};
+
+inline DeltaOTAClass &getDeltaOTA()
+{
+    static DeltaOTAClass instance;
+    return instance;
+}
+
+#endif
+#endif
@@ -32,13 +32,9 @@ inline bool OTAUpdaterClass::end()
     return true;
 }
 
-inline void OTAUpdaterClass::setOTAStorage(uint32_t addr)
-{
-    this->addr = addr;
-    storage = reinterpret_cast<OTAStorage *>(addr);
-}
+inline void OTAUpdaterClass::setOTAStorage(uintptr_t addr) { storage = reinterpret_cast<OTAStorage *>(addr); }
 
-inline bool OTAUpdaterClass::isInit() { return addr > 0; }
+inline bool OTAUpdaterClass::isInit() { return storage != nullptr; }
 
 inline size_t OTAUpdaterClass::write(uint8_t *data, size_t len)
 {
@@ -29,12 +29,11 @@ public:
     bool begin(int size, int command = 0);
     bool end();
     size_t write(uint8_t *data, size_t len);
-    void setOTAStorage(uint32_t addr);
+    void setOTAStorage(uintptr_t addr);
     bool isInit();
 
 private:
     OTAStorage *storage = nullptr;
-    uint32_t addr = 0;
     size_t write(uint8_t b);
     void close();
     void apply();
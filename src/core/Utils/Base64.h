@@ -9,16 +9,222 @@
 
 #include <Arduino.h>
 #include <Client.h>
-#if __has_include(<vector>)
-#include <vector>
-#endif
 #include "./core/Updater/OTAUpdater.h"
 #include "./core/Updater/OTAUpdater.cpp"
+#include "./core/Updater/DeltaOTA.h"
 #include "./core/File/BlobWriter.h"
 #include "./core/Utils/Memory.h"
 
 static const char firebase_boundary_table[] PROGMEM = "=_abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 static const unsigned char firebase_base64_table[65] PROGMEM = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const unsigned char firebase_base64_url_table[65] PROGMEM = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// The Base64 decoding table of standard and URL-safe alphabets.
+// 0x40 is the padding character and 0x80 is the character that is not in the alphabets (skipped).
+static const unsigned char firebase_base64_dec_table[256] PROGMEM = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x3e, 0x80, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x40, 0x80, 0x80,
+    0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x3f,
+    0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+};
+
+// The streaming Base64 encoder.
+// The input can be given in chunks of any size, the bytes that are not a complete 3-byte group
+// are kept for the next chunk. The output is written to the caller buffer.
+struct base64_encoder
+{
+private:
+    const unsigned char *table = firebase_base64_table;
+    uint8_t carry[3];
+    uint8_t carry_len = 0;
+    bool padding = true;
+
+    char enc(uint32_t v) const { return pgm_read_byte(table + (v & 0x3f)); }
+
+    char *put(char *p, uint32_t v) const
+    {
+        p[0] = enc(v >> 18);
+        p[1] = enc(v >> 12);
+        p[2] = enc(v >> 6);
+        p[3] = enc(v);
+        return p + 4;
+    }
+
+public:
+    base64_encoder() {}
+
+    void begin(bool url = false, bool padding = true)
+    {
+        table = url ? firebase_base64_url_table : firebase_base64_table;
+        this->padding = padding;
+        carry_len = 0;
+    }
+
+    // The output buffer size that is required for update and finish of len bytes input.
+    static size_t outputLength(size_t len) { return (len + 2) / 3 * 4 + 4; }
+
+    // Encode the input chunk and returns the number of characters written.
+    size_t update(const uint8_t *in, size_t len, char *out)
+    {
+        char *p = out;
+
+        // Complete the group from previous chunk.
+        while (carry_len > 0 && carry_len < 3 && len > 0)
+        {
+            carry[carry_len++] = *in++;
+            len--;
+        }
+
+        if (carry_len == 3)
+        {
+            p = put(p, (uint32_t)carry[0] << 16 | (uint32_t)carry[1] << 8 | carry[2]);
+            carry_len = 0;
+        }
+
+        // The 3-byte groups are packed into a word and written as 4 characters.
+        const uint8_t *end = in + len - len % 3;
+        while (in < end)
+        {
+            p = put(p, (uint32_t)in[0] << 16 | (uint32_t)in[1] << 8 | in[2]);
+            in += 3;
+        }
+
+        len %= 3;
+        while (len--)
+            carry[carry_len++] = *in++;
+
+        return p - out;
+    }
+
+    // Encode the remaining bytes and returns the number of characters written.
+    size_t finish(char *out)
+    {
+        size_t n = 0;
+        if (carry_len > 0)
+        {
+            uint32_t v = (uint32_t)carry[0] << 16 | (carry_len > 1 ? (uint32_t)carry[1] << 8 : 0);
+            out[n++] = enc(v >> 18);
+            out[n++] = enc(v >> 12);
+            if (carry_len > 1)
+                out[n++] = enc(v >> 6);
+            while (padding && n < 4)
+                out[n++] = '=';
+        }
+        carry_len = 0;
+        return n;
+    }
+};
+
+// The streaming Base64 decoder.
+// The standard and URL-safe alphabets are accepted and the other characters e.g. quotes and line breaks are skipped.
+// The input can be given in chunks of any size, the characters that are not a complete 4-character group
+// are kept for the next chunk. The decoding is ended at the padding character.
+struct base64_decoder
+{
+private:
+    uint32_t bits = 0;
+    uint8_t count = 0;
+    bool ended = false;
+
+    static uint8_t dec(uint8_t c) { return pgm_read_byte(firebase_base64_dec_table + c); }
+
+    size_t flush(uint8_t *out)
+    {
+        size_t n = 0;
+        if (count == 2)
+            out[n++] = bits >> 4;
+        else if (count == 3)
+        {
+            out[n++] = bits >> 10;
+            out[n++] = bits >> 2;
+        }
+        bits = 0;
+        count = 0;
+        return n;
+    }
+
+public:
+    base64_decoder() {}
+
+    void begin()
+    {
+        bits = 0;
+        count = 0;
+        ended = false;
+    }
+
+    // The output buffer size that is required for update and finish of len characters input.
+    static size_t outputLength(size_t len) { return (len + 3) / 4 * 3 + 3; }
+
+    // Decode the input chunk and returns the number of bytes written.
+    size_t update(const char *in, size_t len, uint8_t *out)
+    {
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(in), *end = s + len;
+        uint8_t *p = out;
+
+        while (!ended && s < end)
+        {
+            // The complete groups of alphabet characters are decoded at once.
+            while (count == 0 && end - s >= 4)
+            {
+                uint8_t a = dec(s[0]), b = dec(s[1]), c = dec(s[2]), d = dec(s[3]);
+                if ((a | b | c | d) & 0xc0)
+                    break;
+                uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6 | d;
+                p[0] = v >> 16;
+                p[1] = v >> 8;
+                p[2] = v;
+                p += 3;
+                s += 4;
+            }
+
+            if (s == end)
+                break;
+
+            uint8_t v = dec(*s++);
+            if (v == 0x80)
+                continue;
+
+            if (v == 0x40)
+            {
+                p += flush(p);
+                ended = true;
+                break;
+            }
+
+            bits = bits << 6 | v;
+            if (++count == 4)
+            {
+                p[0] = bits >> 16;
+                p[1] = bits >> 8;
+                p[2] = bits;
+                p += 3;
+                bits = 0;
+                count = 0;
+            }
+        }
+        return p - out;
+    }
+
+    // Decode the remaining characters of the input that is not padded and returns the number of bytes written.
+    size_t finish(uint8_t *out)
+    {
+        ended = true;
+        return flush(out);
+    }
+};
 
 template <typename T>
 struct firebase_base64_io_t
@@ -33,8 +239,6 @@ struct firebase_base64_io_t
 #endif
     // for T array
     T *outT = nullptr;
-    // for T vector
-    std::vector<T> *outL = nullptr;
     // for client
     Client *outC = nullptr;
     // for blob
@@ -46,18 +250,9 @@ struct firebase_base64_io_t
 class Base64Util
 {
 public:
-    int getBase64Len(int n)
-    {
-        int len = (4 * ceil(n / 3.0));
-        return len;
-    }
+    int getBase64Len(int n) { return (n + 2) / 3 * 4; }
 
-    int getBase64Padding(int n)
-    {
-        int pLen = getBase64Len(n);
-        int uLen = ceil(4.0 * n / 3.0);
-        return pLen - uLen;
-    }
+    int getBase64Padding(int n) { return (3 - n % 3) % 3; }
 
     size_t encodedLength(size_t len) const { return ((len + 2) / 3 * 4) + 1; }
 
@@ -73,22 +268,14 @@ public:
         return (3 * (len / 4)) - pad;
     }
 
-    unsigned char *creatBase64EncBuffer(Memory &mem, bool isURL)
-    {
-        unsigned char *base64EncBuf = reinterpret_cast<unsigned char *>(mem.alloc(65));
-        strcpy_P(reinterpret_cast<char *>(base64EncBuf), reinterpret_cast<const char *>(firebase_base64_table));
-        if (isURL)
-        {
-            base64EncBuf[62] = '-';
-            base64EncBuf[63] = '_';
-        }
-        return base64EncBuf;
-    }
-
     bool updateWrite(uint8_t *data, size_t len)
     {
 #if defined(OTA_UPDATE_ENABLED) && defined(FIREBASE_OTA_UPDATER) && (defined(ENABLE_DATABASE) || defined(ENABLE_STORAGE) || defined(ENABLE_CLOUD_STORAGE))
+#if defined(FIREBASE_DELTA_OTA)
+        return getDeltaOTA().write(data, len);
+#else
         return FIREBASE_OTA_UPDATER.write(data, len) == len;
+#endif
 #else
         (void)data;
         (void)len;
@@ -96,16 +283,6 @@ public:
         return false;
     }
 
-    unsigned char *creatBase64DecBuffer(Memory &mem)
-    {
-        unsigned char *base64DecBuf = reinterpret_cast<unsigned char *>(mem.alloc(256, false));
-        memset(base64DecBuf, 0x80, 256);
-        for (size_t i = 0; i < sizeof(firebase_base64_table) - 1; i++)
-            base64DecBuf[firebase_base64_table[i]] = (unsigned char)i;
-        base64DecBuf['='] = 0;
-        return base64DecBuf;
-    }
-
     template <typename T = uint8_t>
     bool writeOutput(firebase_base64_io_t<T> &out)
     {
@@ -134,167 +311,44 @@ public:
         return false;
     }
 
-    template <typename T = uint8_t>
-    bool setOutput(uint8_t val, firebase_base64_io_t<T> &out, T **pos)
-    {
-        if (out.outT)
-        {
-#if defined(ENABLE_FS)
-            if (out.ota || out.outC || out.file || out.outB)
-#else
-            if (out.ota || out.outC || out.outB)
-#endif
-            {
-                out.outT[out.bufWrite++] = val;
-                if (out.bufWrite == (int)out.bufLen && !writeOutput(out))
-                    return false;
-            }
-            else
-                *(*pos)++ = (T)(val);
-        }
-        else if (out.outL)
-            out.outL->push_back(val);
-
-        return true;
-    }
-
+    // Decode the Base64 string to the output buffer and write it to the output in blocks of output buffer size.
     template <typename T>
-    bool decode(Memory &mem, const unsigned char *base64DecBuf, const char *src, size_t len, firebase_base64_io_t<T> &out)
+    bool decode(const char *src, size_t len, firebase_base64_io_t<T> &out)
     {
-        // the maximum chunk size that writes to output is limited by out.bufLen, the minimum is depending on the source length
-        bool ret = false;
-        unsigned char *block = reinterpret_cast<unsigned char *>(mem.alloc(4, false));
-        unsigned char temp;
-        size_t i, count;
-        int pad = 0;
-        size_t extra_pad;
-        T *pos = out.outT ? reinterpret_cast<T *>(&out.outT[0]) : nullptr;
+        if (!out.outT || out.bufLen < base64_decoder::outputLength(4))
+            return false;
+
         if (len == 0)
             len = strlen(src);
 
-        count = 0;
-
-        for (i = 0; i < len; i++)
-        {
-            if (base64DecBuf[(int)src[i]] != 0x80)
-                count++;
-        }
-
-        if (count == 0)
-            goto skip;
-
-        extra_pad = (4 - count % 4) % 4;
-        count = 0;
-        for (i = 0; i < len + extra_pad; i++)
-        {
-            unsigned char val;
-
-            if (i >= len)
-                val = '=';
-            else
-                val = src[i];
-
-            temp = base64DecBuf[val];
-
-            if (temp == 0x80)
-                continue;
-
-            if (val == '=')
-                pad++;
-
-            block[count] = temp;
-            count++;
-            if (count == 4)
-            {
-                setOutput((block[0] << 2) | (block[1] >> 4), out, &pos);
-                count = 0;
-                if (pad)
-                {
-                    if (pad == 1)
-                        setOutput((block[1] << 4) | (block[2] >> 2), out, &pos);
-                    else if (pad > 2)
-                        goto skip;
-
-                    break;
-                }
-                else
-                {
-                    setOutput((block[1] << 4) | (block[2] >> 2), out, &pos);
-                    setOutput((block[2] << 6) | block[3], out, &pos);
-                }
-            }
-        }
-
-        // write the remaining bytes
-        if (out.bufWrite > 0 && !writeOutput(out))
-            goto skip;
-
-        ret = true;
-
-    skip:
-        mem.release(&block);
-        return ret;
-    }
-
-    template <typename T>
-    bool encodeLast(const unsigned char *base64EncBuf, const unsigned char *in, size_t len, firebase_base64_io_t<T> &out, T **pos)
-    {
-        if (len > 2)
-            return false;
+        base64_decoder decoder;
+        decoder.begin();
 
-        if (!setOutput(base64EncBuf[in[0] >> 2], out, pos))
-            return false;
+        // The input block that its decoded bytes fit the output buffer.
+        size_t block = (out.bufLen - 3) / 3 * 4;
+        uint8_t *buf = reinterpret_cast<uint8_t *>(out.outT);
 
-        if (len == 1)
+        for (size_t i = 0; i < len; i += block)
         {
-            if (!setOutput(base64EncBuf[(in[0] & 0x03) << 4], out, pos))
-                return false;
-            if (!setOutput('=', out, pos))
-                return false;
-        }
-        else
-        {
-            if (!setOutput(base64EncBuf[((in[0] & 0x03) << 4) | (in[1] >> 4)], out, pos))
-                return false;
-            if (!setOutput(base64EncBuf[(in[1] & 0x0f) << 2], out, pos))
+            out.bufWrite = decoder.update(src + i, len - i < block ? len - i : block, buf);
+            if (!writeOutput(out))
                 return false;
         }
 
-        if (!setOutput('=', out, pos))
-            return false;
-
-        return true;
+        out.bufWrite = decoder.finish(buf);
+        return writeOutput(out);
     }
 
-    template <typename T>
-    bool encode(const unsigned char *base64EncBuf, uint8_t *src, size_t len, firebase_base64_io_t<T> &out, bool writeAllRemaining = true)
+    // Encode the input to the output buffer and returns the length of encoded string.
+    // The output buffer size should be at least encodedLength(len) and it is null terminated.
+    size_t encode(const uint8_t *src, size_t len, char *out, bool url = false, bool padding = true)
     {
-        const unsigned char *end, *in;
-
-        T *pos = out.outT ? reinterpret_cast<T *>(&out.outT[0]) : nullptr;
-        in = src;
-        end = src + len;
-
-        while (end - in >= 3)
-        {
-            if (!setOutput(base64EncBuf[in[0] >> 2], out, &pos))
-                return false;
-            if (!setOutput(base64EncBuf[((in[0] & 0x03) << 4) | (in[1] >> 4)], out, &pos))
-                return false;
-            if (!setOutput(base64EncBuf[((in[1] & 0x0f) << 2) | (in[2] >> 6)], out, &pos))
-                return false;
-            if (!setOutput(base64EncBuf[in[2] & 0x3f], out, &pos))
-                return false;
-            in += 3;
-        }
-
-        if (end - in && !encodeLast(base64EncBuf, in, end - in, out, &pos))
-            return false;
-
-        if (writeAllRemaining && out.bufWrite > 0 && !writeOutput(out))
-            return false;
-
-        return true;
+        base64_encoder encoder;
+        encoder.begin(url, padding);
+        size_t n = encoder.update(src, len, out);
+        n += encoder.finish(out + n);
+        out[n] = '\0';
+        return n;
     }
 
 #if defined(ENABLE_FS)
@@ -304,10 +358,8 @@ public:
         out.file = file;
         uint8_t *buf = reinterpret_cast<uint8_t *>(mem.alloc(out.bufLen));
         out.outT = buf;
-        unsigned char *base64DecBuf = creatBase64DecBuffer(mem);
-        bool ret = decode<uint8_t>(mem, base64DecBuf, src, strlen(src), out);
+        bool ret = decode<uint8_t>(src, strlen(src), out);
         mem.release(&buf);
-        mem.release(&base64DecBuf);
         return ret;
     }
 #endif
@@ -317,52 +369,34 @@ public:
         out.outB = bWriter;
         uint8_t *buf = reinterpret_cast<uint8_t *>(mem.alloc(out.bufLen));
         out.outT = buf;
-        unsigned char *base64DecBuf = creatBase64DecBuffer(mem);
-        bool ret = decode<uint8_t>(mem, base64DecBuf, src, strlen(src), out);
+        bool ret = decode<uint8_t>(src, strlen(src), out);
         mem.release(&buf);
-        mem.release(&base64DecBuf);
         return ret;
     }
 
-    void encodeUrl(Memory &mem, char *encoded, const unsigned char *string, size_t len)
+    bool decodeToOTA(Memory &mem, const char *src)
     {
-        size_t i;
-        char *p = encoded;
-        unsigned char *base64EncBuf = creatBase64EncBuffer(mem, true);
-
-        for (i = 0; i < len - 2; i += 3)
-        {
-            *p++ = base64EncBuf[(string[i] >> 2) & 0x3F];
-            *p++ = base64EncBuf[((string[i] & 0x3) << 4) | ((int)(string[i + 1] & 0xF0) >> 4)];
-            *p++ = base64EncBuf[((string[i + 1] & 0xF) << 2) | ((int)(string[i + 2] & 0xC0) >> 6)];
-            *p++ = base64EncBuf[string[i + 2] & 0x3F];
-        }
-
-        if (i < len)
-        {
-            *p++ = base64EncBuf[(string[i] >> 2) & 0x3F];
-            if (i == (len - 1))
-                *p++ = base64EncBuf[((string[i] & 0x3) << 4)];
-            else
-            {
-                *p++ = base64EncBuf[((string[i] & 0x3) << 4) | ((int)(string[i + 1] & 0xF0) >> 4)];
-                *p++ = base64EncBuf[((string[i + 1] & 0xF) << 2)];
-            }
-        }
+        firebase_base64_io_t<uint8_t> out;
+        out.ota = true;
+        uint8_t *buf = reinterpret_cast<uint8_t *>(mem.alloc(out.bufLen));
+        out.outT = buf;
+        bool ret = decode<uint8_t>(src, strlen(src), out);
+        mem.release(&buf);
+        return ret;
+    }
 
-        *p++ = '\0';
-        mem.release(&base64EncBuf);
+    // The URL-safe encoding without padding, the encoded buffer size should be at least encodedLength(len).
+    void encodeUrl(Memory &mem, char *encoded, const unsigned char *string, size_t len)
+    {
+        (void)mem;
+        encode(string, len, encoded, true, false);
     }
 
     char *encodeToChars(Memory &mem, uint8_t *src, size_t len)
     {
-        char *encoded = reinterpret_cast<char *>(mem.alloc(encodedLength(len) + 1));
-        firebase_base64_io_t<char> out;
-        out.outT = encoded;
-        unsigned char *base64EncBuf = creatBase64EncBuffer(mem, false);
-        encode<char>(base64EncBuf, src, len, out);
-        mem.release(&base64EncBuf);
+        char *encoded = reinterpret_cast<char *>(mem.alloc(encodedLength(len)));
+        encode(src, len, encoded);
         return encoded;
     }
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_CRC_H
+#define CORE_UTILS_CRC_H
+
+#include <Arduino.h>
+
+// The CRC32C (Castagnoli) table of 4-bit index.
+static const uint32_t firebase_crc32c_table[16] PROGMEM = {
+    0x00000000, 0x105ec76f, 0x20bd8ede, 0x30e349b1, 0x417b1dbc, 0x5125dad3, 0x61c69362, 0x7198540d,
+    0x82f63b78, 0x92a8fc17, 0xa24bb5a6, 0xb21572c9, 0xc38d26c4, 0xd3d3e1ab, 0xe330a81a, 0xf36e6f75};
+
+// The CRC32 (ISO-HDLC, the gzip trailer CRC) table of 4-bit index.
+static const uint32_t firebase_crc32_table[16] PROGMEM = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
+
+// Update the reflected CRC (without the final XOR) with the data using the 4-bit index table.
+static inline uint32_t firebase_crc_update(const uint32_t *table, uint32_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ pgm_read_dword(table + (crc & 0x0f));
+        crc = (crc >> 4) ^ pgm_read_dword(table + (crc & 0x0f));
+    }
+    return crc;
+}
+
+#endif
@@ -0,0 +1,604 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_GZIP_H
+#define CORE_UTILS_GZIP_H
+
+#include <Arduino.h>
+#include "./core/Utils/Memory.h"
+#include "./core/Utils/CRC.h"
+
+#if defined(ENABLE_GZIP)
+
+// The size of history window (bytes) that keeps the decoded data for back references.
+// The data compressed with the default zlib/gzip settings requires 32768 bytes window.
+// The smaller window can be set to save memory when the server data was compressed with
+// the smaller window, the back reference that exceeds the window will stop the decoding with error.
+#if !defined(FIREBASE_GZIP_WINDOW_SIZE)
+#define FIREBASE_GZIP_WINDOW_SIZE 32768
+#endif
+
+// The streaming gzip (RFC 1952) decoder for the compressed HTTP response payload.
+// The compressed data can be fed in any size of chunk, the decoding state is kept
+// between calls and the memory usage is fixed (the history window and the Huffman tables).
+class GzipDecoder
+{
+public:
+    enum gzip_status_t
+    {
+        gzip_status_error = -1,
+        gzip_status_ok = 0, // More input data is required or the output buffer is full.
+        gzip_status_done = 1
+    };
+
+    GzipDecoder() {}
+
+    ~GzipDecoder() { mem.release(&window); }
+
+    bool begin(size_t windowSize = FIREBASE_GZIP_WINDOW_SIZE)
+    {
+        if (!window || wsize != windowSize)
+        {
+            mem.release(&window);
+            window = reinterpret_cast<uint8_t *>(mem.alloc(windowSize, false));
+        }
+        wsize = window ? windowSize : 0;
+        wpos = 0;
+        total = 0;
+        crc = 0xffffffff;
+        bits = 0;
+        nbits = 0;
+        last = false;
+        state = window ? st_magic : st_error;
+        return window != nullptr;
+    }
+
+    bool isDone() const { return state == st_done; }
+
+    bool isError() const { return state == st_error; }
+
+    // Total decoded bytes.
+    size_t size() const { return total; }
+
+    /**
+     * Decode the compressed data.
+     * @param in The compressed data.
+     * @param inLen The length of compressed data.
+     * @param consumed (out) The number of compressed bytes that were consumed.
+     * @param out The output buffer.
+     * @param outSize The size of output buffer.
+     * @param produced (out) The number of decoded bytes that were written to the output buffer.
+     * @return gzip_status_t The decoding status.
+     * When the status is gzip_status_ok and the output buffer is full, call again with the remaining input.
+     */
+    gzip_status_t decode(const uint8_t *in, size_t inLen, size_t &consumed, uint8_t *out, size_t outSize, size_t &produced)
+    {
+        this->in = in;
+        this->inLen = inLen;
+        inPos = 0;
+        this->out = out;
+        this->outSize = outSize;
+        outPos = 0;
+        crcPos = 0;
+
+        gzip_status_t ret = process();
+        updateCrc();
+
+        consumed = inPos;
+        produced = outPos;
+        return ret;
+    }
+
+private:
+    // Canonical Huffman code, count of codes of each length and symbols ordered by code.
+    struct huffman_t
+    {
+        uint16_t counts[16];
+        uint16_t symbols[288];
+    };
+
+    enum decode_state_t
+    {
+        st_magic,
+        st_skip,
+        st_extra,
+        st_name,
+        st_comment,
+        st_hcrc,
+        st_block_header,
+        st_stored_len,
+        st_stored_copy,
+        st_table_sizes,
+        st_code_lengths,
+        st_lit_lengths,
+        st_codes,
+        st_distance,
+        st_match_copy,
+        st_trailer_crc,
+        st_trailer_size,
+        st_done,
+        st_error
+    };
+
+    Memory mem;
+    uint8_t *window = nullptr;
+    size_t wsize = 0, wpos = 0, total = 0;
+
+    // The CRC32 of the decoded data, the output of the current decode call is added from crcPos.
+    uint32_t crc = 0xffffffff;
+    size_t crcPos = 0;
+
+    // The bit buffer, the unconsumed input bits (LSB first).
+    uint64_t bits = 0;
+    uint8_t nbits = 0;
+
+    decode_state_t state = st_error, next = st_error;
+    bool last = false;
+    uint8_t flg = 0;
+    uint16_t hlit = 0, hdist = 0, hclen = 0, idx = 0;
+    uint32_t remain = 0, matchLen = 0, matchDist = 0;
+    uint8_t lengths[320];
+    huffman_t lit, dist;
+
+    const uint8_t *in = nullptr;
+    uint8_t *out = nullptr;
+    size_t inLen = 0, inPos = 0, outSize = 0, outPos = 0;
+
+    // Move the input bytes into the bit buffer.
+    void refill()
+    {
+        while (nbits <= 56 && inPos < inLen)
+        {
+            bits |= (uint64_t)in[inPos++] << nbits;
+            nbits += 8;
+        }
+    }
+
+    bool need(uint8_t n)
+    {
+        if (nbits < n)
+            refill();
+        return nbits >= n;
+    }
+
+    uint32_t peekBits(uint8_t n) const { return (uint32_t)(bits & ((1ULL << n) - 1)); }
+
+    void dropBits(uint8_t n)
+    {
+        bits >>= n;
+        nbits -= n;
+    }
+
+    uint32_t getBits(uint8_t n)
+    {
+        uint32_t v = peekBits(n);
+        dropBits(n);
+        return v;
+    }
+
+    // Decode a symbol without consuming its bits, the code length is set to len.
+    // Returns -2 when more input bits are required or -1 for the invalid code.
+    int decodeSymbol(const huffman_t &h, uint8_t &len)
+    {
+        refill();
+        int code = 0, first = 0, index = 0;
+        for (len = 1; len < 16; len++)
+        {
+            if (len > nbits)
+                return -2;
+            code |= (bits >> (len - 1)) & 1;
+            int count = h.counts[len];
+            if (code - count < first)
+                return h.symbols[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    // Build the canonical Huffman code from the code lengths.
+    // Returns 0 for the complete code, > 0 for the incomplete code and < 0 for the over-subscribed code.
+    int construct(huffman_t &h, const uint8_t *len, int n)
+    {
+        uint16_t offs[16];
+        memset(h.counts, 0, sizeof(h.counts));
+        for (int i = 0; i < n; i++)
+            h.counts[len[i]]++;
+
+        if (h.counts[0] == n)
+            return 0;
+
+        int left = 1;
+        for (int i = 1; i < 16; i++)
+        {
+            left <<= 1;
+            left -= h.counts[i];
+            if (left < 0)
+                return left;
+        }
+
+        offs[1] = 0;
+        for (int i = 1; i < 15; i++)
+            offs[i + 1] = offs[i] + h.counts[i];
+
+        for (int i = 0; i < n; i++)
+        {
+            if (len[i] != 0)
+                h.symbols[offs[len[i]]++] = i;
+        }
+
+        return left;
+    }
+
+    void fixedTables()
+    {
+        int i = 0;
+        for (; i < 144; i++)
+            lengths[i] = 8;
+        for (; i < 256; i++)
+            lengths[i] = 9;
+        for (; i < 280; i++)
+            lengths[i] = 7;
+        for (; i < 288; i++)
+            lengths[i] = 8;
+        construct(lit, lengths, 288);
+
+        for (i = 0; i < 30; i++)
+            lengths[i] = 5;
+        construct(dist, lengths, 30);
+    }
+
+    void put(uint8_t c)
+    {
+        out[outPos++] = c;
+        window[wpos] = c;
+        if (++wpos == wsize)
+            wpos = 0;
+        total++;
+    }
+
+    void updateCrc()
+    {
+        crc = firebase_crc_update(firebase_crc32_table, crc, out + crcPos, outPos - crcPos);
+        crcPos = outPos;
+    }
+
+    gzip_status_t error()
+    {
+        state = st_error;
+        return gzip_status_error;
+    }
+
+    gzip_status_t process()
+    {
+        static const uint16_t lbase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const uint8_t lext[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const uint16_t dbase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        static const uint8_t dext[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+        static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        for (;;)
+        {
+            switch (state)
+            {
+            case st_magic:
+            {
+                // ID1, ID2, CM and FLG, the MTIME, XFL and OS (6 bytes) are skipped.
+                if (!need(32))
+                    return gzip_status_ok;
+                uint32_t v = getBits(32);
+                if ((v & 0xffff) != 0x8b1f || ((v >> 16) & 0xff) != 8)
+                    return error();
+                flg = v >> 24;
+                remain = 6;
+                next = st_extra;
+                state = st_skip;
+                break;
+            }
+
+            case st_skip:
+                while (remain > 0)
+                {
+                    if (!need(8))
+                        return gzip_status_ok;
+                    dropBits(8);
+                    remain--;
+                }
+                state = next;
+                break;
+
+            case st_extra:
+                if (flg & 0x04) // FEXTRA
+                {
+                    if (!need(16))
+                        return gzip_status_ok;
+                    remain = getBits(16);
+                    next = st_name;
+                    state = st_skip;
+                }
+                else
+                    state = st_name;
+                break;
+
+            case st_name:
+            case st_comment:
+                if (flg & (state == st_name ? 0x08 : 0x10)) // FNAME, FCOMMENT (zero terminated)
+                {
+                    for (;;)
+                    {
+                        if (!need(8))
+                            return gzip_status_ok;
+                        if (getBits(8) == 0)
+                            break;
+                    }
+                }
+                state = state == st_name ? st_comment : st_hcrc;
+                break;
+
+            case st_hcrc:
+                remain = flg & 0x02 ? 2 : 0; // FHCRC
+                next = st_block_header;
+                state = st_skip;
+                break;
+
+            case st_block_header:
+            {
+                if (!need(3))
+                    return gzip_status_ok;
+                uint32_t v = getBits(3);
+                last = v & 1;
+                v >>= 1;
+                if (v == 0)
+                {
+                    dropBits(nbits & 7); // Stored block starts at byte boundary.
+                    state = st_stored_len;
+                }
+                else if (v == 1)
+                {
+                    fixedTables();
+                    state = st_codes;
+                }
+                else if (v == 2)
+                    state = st_table_sizes;
+                else
+                    return error();
+                break;
+            }
+
+            case st_stored_len:
+            {
+                if (!need(32))
+                    return gzip_status_ok;
+                uint32_t v = getBits(32);
+                if ((v & 0xffff) != (~v >> 16))
+                    return error();
+                remain = v & 0xffff;
+                state = st_stored_copy;
+                break;
+            }
+
+            case st_stored_copy:
+                while (remain > 0)
+                {
+                    if (outPos == outSize)
+                        return gzip_status_ok;
+
+                    if (nbits >= 8)
+                    {
+                        put(getBits(8));
+                        remain--;
+                    }
+                    else if (inPos < inLen)
+                    {
+                        // Copy the stored data directly from input.
+                        size_t n = inLen - inPos;
+                        if (n > remain)
+                            n = remain;
+                        if (n > outSize - outPos)
+                            n = outSize - outPos;
+                        for (size_t i = 0; i < n; i++)
+                            put(in[inPos + i]);
+                        inPos += n;
+                        remain -= n;
+                    }
+                    else
+                        return gzip_status_ok;
+                }
+                state = last ? st_trailer_crc : st_block_header;
+                break;
+
+            case st_table_sizes:
+            {
+                if (!need(14))
+                    return gzip_status_ok;
+                hlit = getBits(5) + 257;
+                hdist = getBits(5) + 1;
+                hclen = getBits(4) + 4;
+                if (hlit > 286 || hdist > 30)
+                    return error();
+                memset(lengths, 0, 19);
+                idx = 0;
+                state = st_code_lengths;
+                break;
+            }
+
+            case st_code_lengths:
+                while (idx < hclen)
+                {
+                    if (!need(3))
+                        return gzip_status_ok;
+                    lengths[order[idx++]] = getBits(3);
+                }
+                // The code lengths code is kept in the distance code table until the literal/length and distance codes were read.
+                if (construct(dist, lengths, 19) != 0)
+                    return error();
+                idx = 0;
+                state = st_lit_lengths;
+                break;
+
+            case st_lit_lengths:
+                while (idx < hlit + hdist)
+                {
+                    // The symbol and its extra bits are consumed at once or none.
+                    uint8_t clen = 0;
+                    int sym = decodeSymbol(dist, clen);
+                    if (sym == -2)
+                        return gzip_status_ok;
+                    if (sym < 0)
+                        return error();
+
+                    if (sym < 16)
+                    {
+                        dropBits(clen);
+                        lengths[idx++] = sym;
+                    }
+                    else
+                    {
+                        uint8_t len = 0, eb = sym == 16 ? 2 : (sym == 17 ? 3 : 7);
+                        if (!need(clen + eb))
+                            return gzip_status_ok;
+
+                        dropBits(clen);
+                        uint32_t rep = getBits(eb) + (sym == 16 ? 3 : (sym == 17 ? 3 : 11));
+                        if (sym == 16)
+                        {
+                            if (idx == 0)
+                                return error();
+                            len = lengths[idx - 1];
+                        }
+
+                        if (idx + rep > (uint32_t)(hlit + hdist))
+                            return error();
+
+                        while (rep--)
+                            lengths[idx++] = len;
+                    }
+                }
+
+                if (lengths[256] == 0)
+                    return error();
+
+                {
+                    int err = construct(lit, lengths, hlit);
+                    if (err < 0 || (err > 0 && hlit - lit.counts[0] != 1))
+                        return error();
+
+                    err = construct(dist, lengths + hlit, hdist);
+                    if (err < 0 || (err > 0 && hdist - dist.counts[0] != 1))
+                        return error();
+                }
+                state = st_codes;
+                break;
+
+            case st_codes:
+                for (;;)
+                {
+                    if (outPos == outSize)
+                        return gzip_status_ok;
+
+                    uint8_t clen = 0;
+                    int sym = decodeSymbol(lit, clen);
+                    if (sym == -2)
+                        return gzip_status_ok;
+                    if (sym < 0)
+                        return error();
+
+                    if (sym < 256)
+                    {
+                        dropBits(clen);
+                        put(sym);
+                    }
+                    else if (sym == 256)
+                    {
+                        dropBits(clen);
+                        state = last ? st_trailer_crc : st_block_header;
+                        break;
+                    }
+                    else
+                    {
+                        sym -= 257;
+                        if (sym >= 29)
+                            return error();
+
+                        if (!need(clen + lext[sym]))
+                            return gzip_status_ok;
+
+                        dropBits(clen);
+                        matchLen = lbase[sym] + getBits(lext[sym]);
+                        state = st_distance;
+                        break;
+                    }
+                }
+                break;
+
+            case st_distance:
+            {
+                uint8_t clen = 0;
+                int sym = decodeSymbol(dist, clen);
+                if (sym == -2)
+                    return gzip_status_ok;
+                if (sym < 0 || sym >= 30)
+                    return error();
+
+                if (!need(clen + dext[sym]))
+                    return gzip_status_ok;
+
+                dropBits(clen);
+                matchDist = dbase[sym] + getBits(dext[sym]);
+
+                // The back reference beyond the decoded data or the window size.
+                if (matchDist > total || matchDist > wsize)
+                    return error();
+
+                state = st_match_copy;
+                break;
+            }
+
+            case st_match_copy:
+                while (matchLen > 0)
+                {
+                    if (outPos == outSize)
+                        return gzip_status_ok;
+                    put(window[wpos >= matchDist ? wpos - matchDist : wsize + wpos - matchDist]);
+                    matchLen--;
+                }
+                state = st_codes;
+                break;
+
+            case st_trailer_crc:
+                // The trailer starts at byte boundary, the CRC32 of the decoded data.
+                dropBits(nbits & 7);
+                if (!need(32))
+                    return gzip_status_ok;
+                updateCrc();
+                if (getBits(32) != ~crc)
+                    return error();
+                state = st_trailer_size;
+                break;
+
+            case st_trailer_size:
+                if (!need(32))
+                    return gzip_status_ok;
+                if (getBits(32) != (uint32_t)total) // ISIZE, the decoded size modulo 2^32.
+                    return error();
+                state = st_done;
+                break;
+
+            case st_done:
+                return gzip_status_done;
+
+            default:
+                return gzip_status_error;
+            }
+        }
+    }
+};
+
+#endif
+
+#endif
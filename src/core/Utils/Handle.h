@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_HANDLE_H
+#define CORE_UTILS_HANDLE_H
+
+#include <Arduino.h>
+#include <vector>
+
+namespace firebase_ns
+{
+    // The handle of the object in the handle registry.
+    // The lower 16 bits are the index (plus one) of registry entry and the upper 16 bits are the generation of entry.
+    // The handle 0 is invalid.
+    typedef uint32_t firebase_handle_t;
+
+    enum handle_type_t
+    {
+        handle_type_undefined,
+        handle_type_app,
+        handle_type_service,
+        handle_type_client,
+        handle_type_result,
+        handle_type_cache,
+        handle_type_stream_mux
+    };
+
+    // The generational handle registry.
+    // The objects that can be referred by other objects (apps, Firebase services, async clients, async results, the RTDB local caches and the Stream multiplexers) are
+    // registered here, the referrer keeps the handle instead of the object address and looks up the object in constant time.
+    // When the object was removed, its entry generation changes and the old handles are no longer valid.
+    class HandleRegistry
+    {
+    private:
+        struct entry_t
+        {
+            void *ptr = nullptr;
+            uint16_t gen = 1;
+            uint8_t type = handle_type_undefined;
+        };
+
+        std::vector<entry_t> entries;
+        std::vector<uint16_t> free_list;
+
+    public:
+        HandleRegistry() {}
+
+        firebase_handle_t add(void *ptr, handle_type_t type)
+        {
+            uint16_t index = 0;
+            if (free_list.size())
+            {
+                index = free_list.back();
+                free_list.pop_back();
+            }
+            else
+            {
+                if (entries.size() >= 0xffff)
+                    return 0;
+                entries.push_back(entry_t());
+                index = entries.size() - 1;
+            }
+
+            entries[index].ptr = ptr;
+            entries[index].type = type;
+            return (static_cast<firebase_handle_t>(entries[index].gen) << 16) | (index + 1);
+        }
+
+        void remove(firebase_handle_t handle)
+        {
+            if (!get(handle, handle_type_undefined))
+                return;
+
+            uint16_t index = (handle & 0xffff) - 1;
+            entries[index].ptr = nullptr;
+            entries[index].type = handle_type_undefined;
+            // Generation 0 is skipped, the handle 0 is always invalid.
+            if (++entries[index].gen == 0)
+                entries[index].gen = 1;
+            free_list.push_back(index);
+        }
+
+        // Get the object of the handle, or nullptr when the handle is invalid or the type is not matched.
+        // The handle_type_undefined matches any type.
+        void *get(firebase_handle_t handle, handle_type_t type) const
+        {
+            uint16_t index = handle & 0xffff;
+            if (index == 0 || index > entries.size())
+                return nullptr;
+
+            const entry_t &entry = entries[index - 1];
+            if (entry.gen != (handle >> 16) || !entry.ptr || (type != handle_type_undefined && entry.type != type))
+                return nullptr;
+            return entry.ptr;
+        }
+
+        template <typename T>
+        T *get(firebase_handle_t handle, handle_type_t type) const { return reinterpret_cast<T *>(get(handle, type)); }
+
+        bool isValid(firebase_handle_t handle, handle_type_t type) const { return get(handle, type) != nullptr; }
+    };
+
+    // The registry is never destroyed, the objects that are destroyed at program exit can be removed safely.
+    inline HandleRegistry &handleRegistry()
+    {
+        static HandleRegistry *registry = new HandleRegistry();
+        return *registry;
+    }
+
+    // The handle of its owner object.
+    // The owner is registered at the first use and removed when the owner was destroyed.
+    // The handle is not copied with the owner object, the copy gets its own handle.
+    class ObjectHandle
+    {
+    private:
+        firebase_handle_t handle = 0;
+
+    public:
+        ObjectHandle() {}
+        ObjectHandle(const ObjectHandle &) {}
+        ObjectHandle &operator=(const ObjectHandle &) { return *this; }
+        ~ObjectHandle() { release(); }
+
+        firebase_handle_t get(void *owner, handle_type_t type)
+        {
+            if (!handle)
+                handle = handleRegistry().add(owner, type);
+            return handle;
+        }
+
+        void release()
+        {
+            if (handle)
+                handleRegistry().remove(handle);
+            handle = 0;
+        }
+    };
+}
+#endif
@@ -0,0 +1,422 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_HASH_H
+#define CORE_UTILS_HASH_H
+
+#include <Arduino.h>
+#include "./core/Utils/Base64.h"
+#include "./core/Utils/CRC.h"
+
+#if defined(ESP32)
+#include <mbedtls/version.h>
+#include <mbedtls/sha256.h>
+#elif !defined(FIREBASE_HOST_BUILD)
+#include <ESP_SSLClient.h>
+#endif
+
+enum firebase_hash_type
+{
+    hash_none,
+    hash_md5,    // The md5Hash of object metadata.
+    hash_sha256, // The SHA-256 digest.
+    hash_crc32c  // The crc32c of object metadata.
+};
+
+static const uint32_t firebase_md5_k[64] PROGMEM = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+static const uint8_t firebase_md5_r[16] PROGMEM = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+#if defined(FIREBASE_HOST_BUILD)
+static const uint32_t firebase_sha256_k[64] PROGMEM = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+#endif
+
+// The incremental SHA-256 of the platform crypto library, mbedTLS on ESP32 and BearSSL of ESP_SSLClient on other devices.
+// The portable implementation is only used by the host build that has no crypto library.
+struct sha256_digest
+{
+private:
+#if defined(ESP32)
+    mbedtls_sha256_context ctx;
+#elif defined(FIREBASE_HOST_BUILD)
+    uint32_t h[8];
+    uint64_t total = 0;
+    uint8_t block[64];
+    uint8_t block_len = 0;
+
+    static uint32_t ror(uint32_t x, uint8_t n) { return (x >> n) | (x << (32 - n)); }
+
+    void processBlock(const uint8_t *p)
+    {
+        uint32_t w[64];
+        for (uint8_t i = 0; i < 16; i++)
+            w[i] = (uint32_t)p[i * 4] << 24 | (uint32_t)p[i * 4 + 1] << 16 | (uint32_t)p[i * 4 + 2] << 8 | p[i * 4 + 3];
+        for (uint8_t i = 16; i < 64; i++)
+        {
+            uint32_t s0 = ror(w[i - 15], 7) ^ ror(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = ror(w[i - 2], 17) ^ ror(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t v[8];
+        memcpy(v, h, sizeof(v));
+        for (uint8_t i = 0; i < 64; i++)
+        {
+            uint32_t s1 = ror(v[4], 6) ^ ror(v[4], 11) ^ ror(v[4], 25);
+            uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+            uint32_t t1 = v[7] + s1 + ch + pgm_read_dword(firebase_sha256_k + i) + w[i];
+            uint32_t s0 = ror(v[0], 2) ^ ror(v[0], 13) ^ ror(v[0], 22);
+            uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+            memmove(v + 1, v, 7 * sizeof(uint32_t));
+            v[4] += t1;
+            v[0] = t1 + s0 + maj;
+        }
+        for (uint8_t i = 0; i < 8; i++)
+            h[i] += v[i];
+    }
+#else
+    br_sha256_context ctx;
+#endif
+    bool started = false;
+
+public:
+    sha256_digest() {}
+    ~sha256_digest() { clear(); }
+
+    void begin()
+    {
+        clear();
+#if defined(ESP32)
+        mbedtls_sha256_init(&ctx);
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+        mbedtls_sha256_starts(&ctx, 0 /* SHA-256 */);
+#else
+        mbedtls_sha256_starts_ret(&ctx, 0 /* SHA-256 */);
+#endif
+#elif defined(FIREBASE_HOST_BUILD)
+        static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        memcpy(h, iv, sizeof(iv));
+        total = 0;
+        block_len = 0;
+#else
+        br_sha256_init(&ctx);
+#endif
+        started = true;
+    }
+
+    void update(const uint8_t *data, size_t len)
+    {
+        if (!started)
+            return;
+#if defined(ESP32)
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+        mbedtls_sha256_update(&ctx, data, len);
+#else
+        mbedtls_sha256_update_ret(&ctx, data, len);
+#endif
+#elif defined(FIREBASE_HOST_BUILD)
+        total += len;
+        if (block_len)
+        {
+            size_t n = 64 - block_len < len ? 64 - block_len : len;
+            memcpy(block + block_len, data, n);
+            block_len += n;
+            data += n;
+            len -= n;
+            if (block_len < 64)
+                return;
+            processBlock(block);
+            block_len = 0;
+        }
+
+        while (len >= 64)
+        {
+            processBlock(data);
+            data += 64;
+            len -= 64;
+        }
+
+        memcpy(block, data, len);
+        block_len = len;
+#else
+        br_sha256_update(&ctx, data, len);
+#endif
+    }
+
+    // Finish the digest calculation, the 32 bytes digest is written to out.
+    void finish(uint8_t *out)
+    {
+        if (!started)
+            return;
+#if defined(ESP32)
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+        mbedtls_sha256_finish(&ctx, out);
+#else
+        mbedtls_sha256_finish_ret(&ctx, out);
+#endif
+#elif defined(FIREBASE_HOST_BUILD)
+        uint64_t bits = total * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (block_len != 56)
+            update(&pad, 1);
+
+        uint8_t l[8];
+        for (uint8_t i = 0; i < 8; i++)
+            l[i] = bits >> (56 - i * 8);
+        update(l, 8);
+
+        for (size_t i = 0; i < 32; i++)
+            out[i] = h[i / 4] >> (24 - (i & 3) * 8);
+#else
+        br_sha256_out(&ctx, out);
+#endif
+        clear();
+    }
+
+    void clear()
+    {
+#if defined(ESP32)
+        if (started)
+            mbedtls_sha256_free(&ctx);
+#endif
+        started = false;
+    }
+};
+
+// The incremental digest of the downloaded data that is compared with the expected digest when the download was finished.
+struct hash_verifier
+{
+private:
+    firebase_hash_type type = hash_none;
+    uint32_t h[4];
+    uint64_t total = 0;
+    uint8_t block[64];
+    uint8_t block_len = 0;
+    uint8_t expected[32];
+    uint8_t expected_len = 0;
+    sha256_digest sha;
+
+    static uint32_t rol(uint32_t x, uint8_t n) { return (x << n) | (x >> (32 - n)); }
+
+    static size_t digestLength(firebase_hash_type type) { return type == hash_md5 ? 16 : type == hash_sha256 ? 32 : type == hash_crc32c ? 4 : 0; }
+
+    void md5Block(const uint8_t *p)
+    {
+        uint32_t m[16];
+        for (uint8_t i = 0; i < 16; i++)
+            m[i] = (uint32_t)p[i * 4] | (uint32_t)p[i * 4 + 1] << 8 | (uint32_t)p[i * 4 + 2] << 16 | (uint32_t)p[i * 4 + 3] << 24;
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+        for (uint8_t i = 0; i < 64; i++)
+        {
+            uint32_t f;
+            uint8_t g;
+            if (i < 16)
+            {
+                f = (b & c) | (~b & d);
+                g = i;
+            }
+            else if (i < 32)
+            {
+                f = (d & b) | (~d & c);
+                g = (5 * i + 1) & 15;
+            }
+            else if (i < 48)
+            {
+                f = b ^ c ^ d;
+                g = (3 * i + 5) & 15;
+            }
+            else
+            {
+                f = c ^ (b | ~d);
+                g = (7 * i) & 15;
+            }
+            f += a + pgm_read_dword(firebase_md5_k + i) + m[g];
+            a = d;
+            d = c;
+            c = b;
+            b += rol(f, pgm_read_byte(firebase_md5_r + (i >> 4) * 4 + (i & 3)));
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+    }
+
+    // Parse the expected digest in hex or Base64.
+    bool setExpected(const String &digest, size_t len)
+    {
+        expected_len = 0;
+        bool hex = digest.length() == len * 2;
+        for (size_t i = 0; hex && i < digest.length(); i++)
+            hex = isxdigit(digest[i]);
+
+        if (hex)
+        {
+            for (size_t i = 0; i < len; i++)
+            {
+                char s[3] = {digest[i * 2], digest[i * 2 + 1], 0};
+                expected[i] = strtoul(s, nullptr, 16);
+            }
+            expected_len = len;
+        }
+        else if (digest.length() <= 48)
+        {
+            uint8_t buf[base64_decoder::outputLength(48)];
+            base64_decoder decoder;
+            decoder.begin();
+            size_t n = decoder.update(digest.c_str(), digest.length(), buf);
+            n += decoder.finish(buf + n);
+            if (n == len)
+            {
+                memcpy(expected, buf, len);
+                expected_len = len;
+            }
+        }
+        return expected_len > 0;
+    }
+
+public:
+    hash_verifier() {}
+
+    /**
+     * Start the digest calculation.
+     *
+     * @param type The hash algorithm.
+     * @param digest The expected digest in hex or Base64 (as the md5Hash and crc32c of object metadata).
+     * @return bool Return false when the digest is not valid for the algorithm, the verification is disabled.
+     */
+    bool begin(firebase_hash_type type, const String &digest)
+    {
+        clear();
+        if (!setExpected(digest, digestLength(type)))
+            return false;
+
+        this->type = type;
+        if (type == hash_md5)
+        {
+            h[0] = 0x67452301;
+            h[1] = 0xefcdab89;
+            h[2] = 0x98badcfe;
+            h[3] = 0x10325476;
+        }
+        else if (type == hash_sha256)
+            sha.begin();
+        else
+            h[0] = 0xffffffff;
+        return true;
+    }
+
+    void clear()
+    {
+        type = hash_none;
+        total = 0;
+        block_len = 0;
+        expected_len = 0;
+        sha.clear();
+    }
+
+    bool isEnabled() const { return type != hash_none; }
+
+    void update(const uint8_t *data, size_t len)
+    {
+        if (type == hash_crc32c)
+        {
+            h[0] = firebase_crc_update(firebase_crc32c_table, h[0], data, len);
+            return;
+        }
+
+        if (type == hash_sha256)
+        {
+            sha.update(data, len);
+            return;
+        }
+
+        if (type == hash_none)
+            return;
+
+        total += len;
+        if (block_len)
+        {
+            size_t n = 64 - block_len < len ? 64 - block_len : len;
+            memcpy(block + block_len, data, n);
+            block_len += n;
+            data += n;
+            len -= n;
+            if (block_len < 64)
+                return;
+            md5Block(block);
+            block_len = 0;
+        }
+
+        while (len >= 64)
+        {
+            md5Block(data);
+            data += 64;
+            len -= 64;
+        }
+
+        memcpy(block, data, len);
+        block_len = len;
+    }
+
+    // Finish the digest calculation and returns true when the digest matches the expected digest.
+    bool verify()
+    {
+        uint8_t out[32];
+        size_t len = digestLength(type);
+
+        if (type == hash_crc32c)
+        {
+            uint32_t crc = ~h[0];
+            for (uint8_t i = 0; i < 4; i++)
+                out[i] = crc >> (24 - i * 8);
+        }
+        else if (type == hash_sha256)
+            sha.finish(out);
+        else if (type == hash_md5)
+        {
+            uint64_t bits = total * 8;
+            uint8_t pad = 0x80;
+            update(&pad, 1);
+            pad = 0;
+            while (block_len != 56)
+                update(&pad, 1);
+
+            uint8_t l[8];
+            for (uint8_t i = 0; i < 8; i++)
+                l[i] = bits >> (i * 8);
+            update(l, 8);
+
+            for (size_t i = 0; i < len; i++)
+                out[i] = h[i / 4] >> ((i & 3) * 8);
+        }
+
+        bool ret = len > 0 && len == expected_len && memcmp(out, expected, len) == 0;
+        clear();
+        return ret;
+    }
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_JSON_PATH_H
+#define CORE_UTILS_JSON_PATH_H
+
+#include <Arduino.h>
+
+// The JSON text scanning and the database path helpers that are shared by the write coalescer, the batch writer,
+// the local cache and the Stream multiplexer.
+// The paths are compared without leading and trailing slashes, the empty path is the root.
+class JSONPathUtil
+{
+public:
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    static void skipSpace(const char *s, size_t &i)
+    {
+        while (isSpace(s[i]))
+            i++;
+    }
+
+    // Skip the string that starts at the quote, i will be the position after the closing quote.
+    static bool skipString(const char *s, size_t &i)
+    {
+        for (i++; s[i]; i++)
+        {
+            if (s[i] == '\\' && s[i + 1])
+                i++;
+            else if (s[i] == '"')
+            {
+                i++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Skip the value that starts at i, i will be the position after the value.
+    static bool skipValue(const char *s, size_t &i)
+    {
+        int depth = 0;
+        while (s[i])
+        {
+            char c = s[i];
+            if (c == '"')
+            {
+                if (!skipString(s, i))
+                    return false;
+                if (depth == 0)
+                    return true;
+                continue;
+            }
+            if (c == '{' || c == '[')
+                depth++;
+            else if (c == '}' || c == ']')
+            {
+                if (depth == 0)
+                    return true;
+                if (--depth == 0)
+                {
+                    i++;
+                    return true;
+                }
+            }
+            else if (depth == 0 && (c == ',' || isSpace(c)))
+                return true;
+            i++;
+        }
+        return depth == 0;
+    }
+
+    // The path without leading and trailing slashes.
+    static String normalize(const String &path)
+    {
+        int p1 = 0, p2 = path.length();
+        while (p1 < p2 && path[p1] == '/')
+            p1++;
+        while (p2 > p1 && path[p2 - 1] == '/')
+            p2--;
+        return path.substring(p1, p2);
+    }
+
+    static String join(const String &path, const String &key) { return path.length() == 0 ? key : (key.length() == 0 ? path : path + "/" + key); }
+
+    // Returns true when the path is the ancestor of (or the same location as) other path, the root is the ancestor of all paths.
+    static bool isAncestor(const String &path, const String &other) { return path.length() == 0 || (other.startsWith(path) && (other.length() == path.length() || other[path.length()] == '/')); }
+
+    // The path of descendant relative to its ancestor.
+    static String relative(const String &ancestor, const String &path) { return path.length() > ancestor.length() ? path.substring(ancestor.length() + (ancestor.length() ? 1 : 0)) : String(); }
+};
+
+#endif
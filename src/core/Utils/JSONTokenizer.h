@@ -0,0 +1,411 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef CORE_UTILS_JSON_TOKENIZER_H
+#define CORE_UTILS_JSON_TOKENIZER_H
+
+#include <Arduino.h>
+
+// The maximum member name length that can be matched by the JSON tokenizer.
+#if !defined(FIREBASE_JSON_KEY_SIZE)
+#define FIREBASE_JSON_KEY_SIZE 32
+#endif
+
+// The JSON member that is pulled by the JSON tokenizer.
+struct json_field_t
+{
+    const char *key = nullptr; // The member name.
+    uint8_t depth = 0;         // The depth of object that contains the member, 1 for the top-level object and 0 for any depth.
+    String *value = nullptr;   // Optional. The member value, the string is unescaped and the other values are the JSON text.
+    int p1 = -1, p2 = -1;      // The value position in the input, the quotes are excluded from the string value.
+    bool found = false;
+
+    json_field_t() {}
+    json_field_t(const char *key, uint8_t depth, String *value = nullptr) : key(key), depth(depth), value(value) {}
+};
+
+// The single pass SAX-style JSON tokenizer.
+// The members of interest are pulled while the input is scanned once, the input can be given in chunks.
+// No memory is allocated by the tokenizer, only the member values are appended to the strings of fields.
+class JSONTokenizer
+{
+private:
+    enum state_t
+    {
+        st_value,  // Expecting the value.
+        st_object, // Expecting the member name or the end of object.
+        st_key,    // In the member name.
+        st_colon,  // Expecting the name separator.
+        st_string, // In the string value.
+        st_literal,
+        st_next, // Expecting the value separator or the end of container.
+        st_end,
+        st_error
+    };
+
+    json_field_t *fields = nullptr;
+    size_t count = 0, remaining = 0, pos = 0;
+    state_t state = st_value;
+    uint32_t stack = 0; // The container types, the bit is set for object.
+    uint8_t depth = 0, cap_depth = 0;
+    char key[FIREBASE_JSON_KEY_SIZE];
+    uint8_t key_len = 0;
+    bool key_over = false, esc = false;
+    int match = -1;                // The field that its name was matched, the value is not started.
+    int scalar = -1, container = -1; // The fields that their values are being read.
+    uint8_t hex_len = 0;
+    uint16_t hex = 0, surrogate = 0;
+
+    bool isObject() const { return depth > 0 && (stack >> (depth - 1)) & 1; }
+
+    void findField()
+    {
+        match = -1;
+        if (key_over)
+            return;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!fields[i].found && (fields[i].depth == 0 || fields[i].depth == depth) &&
+                strlen(fields[i].key) == key_len && memcmp(fields[i].key, key, key_len) == 0)
+            {
+                match = i;
+                return;
+            }
+        }
+    }
+
+    void setFound(int index, size_t end)
+    {
+        fields[index].p2 = end;
+        fields[index].found = true;
+        if (remaining)
+            remaining--;
+    }
+
+    void appendUTF8(String *out, uint32_t cp)
+    {
+        if (cp < 0x80)
+            *out += (char)cp;
+        else if (cp < 0x800)
+        {
+            *out += (char)(0xc0 | (cp >> 6));
+            *out += (char)(0x80 | (cp & 0x3f));
+        }
+        else if (cp < 0x10000)
+        {
+            *out += (char)(0xe0 | (cp >> 12));
+            *out += (char)(0x80 | ((cp >> 6) & 0x3f));
+            *out += (char)(0x80 | (cp & 0x3f));
+        }
+        else
+        {
+            *out += (char)(0xf0 | (cp >> 18));
+            *out += (char)(0x80 | ((cp >> 12) & 0x3f));
+            *out += (char)(0x80 | ((cp >> 6) & 0x3f));
+            *out += (char)(0x80 | (cp & 0x3f));
+        }
+    }
+
+    // Add the unescaped string character to the member name or the member value.
+    void putChar(String *out, uint32_t c)
+    {
+        if (state == st_key)
+        {
+            if (key_len < FIREBASE_JSON_KEY_SIZE && c < 0x80)
+                key[key_len++] = c;
+            else
+                key_over = true;
+        }
+        else if (out)
+            appendUTF8(out, c);
+    }
+
+    // Read the string character, returns false when the string was ended.
+    bool readString(char c)
+    {
+        String *out = state == st_string && scalar > -1 ? fields[scalar].value : nullptr;
+
+        if (hex_len > 0)
+        {
+            int v = c >= '0' && c <= '9' ? c - '0' : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? (c | 0x20) - 'a' + 10 : -1;
+            if (v < 0)
+            {
+                state = st_error;
+                return true;
+            }
+            hex = (hex << 4) | v;
+            if (++hex_len == 5)
+            {
+                hex_len = 0;
+                if (hex >= 0xd800 && hex < 0xdc00)
+                    surrogate = hex;
+                else if (hex >= 0xdc00 && hex < 0xe000 && surrogate)
+                {
+                    putChar(out, 0x10000 + ((uint32_t)(surrogate - 0xd800) << 10) + (hex - 0xdc00));
+                    surrogate = 0;
+                }
+                else
+                    putChar(out, hex);
+            }
+            return true;
+        }
+
+        if (esc)
+        {
+            esc = false;
+            switch (c)
+            {
+            case 'b':
+                c = '\b';
+                break;
+            case 'f':
+                c = '\f';
+                break;
+            case 'n':
+                c = '\n';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'u':
+                hex = 0;
+                hex_len = 1;
+                return true;
+            default:
+                break;
+            }
+            putChar(out, (uint8_t)c);
+            return true;
+        }
+
+        if (c == '\\')
+            esc = true;
+        else if (c == '"')
+            return false;
+        else
+            putChar(out, (uint8_t)c);
+        return true;
+    }
+
+    void beginValue(char c)
+    {
+        if (match > -1)
+        {
+            fields[match].p1 = c == '"' ? pos + 1 : pos;
+            if (c != '{' && c != '[')
+            {
+                scalar = match;
+                if (c != '"' && fields[scalar].value)
+                    *fields[scalar].value += c;
+            }
+            // The nested container value can't be read while reading the container value.
+            else if (container == -1)
+            {
+                container = match;
+                cap_depth = depth;
+                if (fields[container].value)
+                    *fields[container].value += c;
+            }
+        }
+        match = -1;
+    }
+
+    void endValue() { state = depth == 0 ? st_end : st_next; }
+
+    bool push(bool object)
+    {
+        if (depth >= 32)
+            return false;
+        if (object)
+            stack |= (1UL << depth);
+        else
+            stack &= ~(1UL << depth);
+        depth++;
+        return true;
+    }
+
+    bool pop(char c)
+    {
+        if (depth == 0 || isObject() != (c == '}'))
+            return false;
+        depth--;
+        if (container > -1 && depth == cap_depth)
+        {
+            setFound(container, pos + 1);
+            container = -1;
+        }
+        endValue();
+        return true;
+    }
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    void put(char c, bool raw = true)
+    {
+        // The raw text of the container value.
+        if (raw && container > -1 && fields[container].value)
+            *fields[container].value += c;
+
+        switch (state)
+        {
+        case st_value:
+            if (isSpace(c))
+                break;
+            if (c == '{' || c == '[')
+            {
+                state = c == '{' ? st_object : st_value;
+                beginValue(c);
+                if (!push(c == '{'))
+                    state = st_error;
+            }
+            else if (c == ']' && depth > 0 && !isObject())
+            {
+                // The empty array.
+                if (!pop(c))
+                    state = st_error;
+            }
+            else if (c == '"' || c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n')
+            {
+                state = c == '"' ? st_string : st_literal;
+                beginValue(c);
+            }
+            else
+                state = st_error;
+            break;
+
+        case st_object:
+            if (isSpace(c))
+                break;
+            if (c == '"')
+            {
+                state = st_key;
+                key_len = 0;
+                key_over = false;
+            }
+            else if (c != '}' || !pop(c))
+                state = st_error;
+            break;
+
+        case st_key:
+            if (!readString(c))
+            {
+                findField();
+                state = st_colon;
+            }
+            break;
+
+        case st_colon:
+            if (isSpace(c))
+                break;
+            state = c == ':' ? st_value : st_error;
+            break;
+
+        case st_string:
+            if (!readString(c))
+            {
+                if (scalar > -1)
+                    setFound(scalar, pos);
+                scalar = -1;
+                endValue();
+            }
+            break;
+
+        case st_literal:
+            if (isSpace(c) || c == ',' || c == '}' || c == ']')
+            {
+                if (scalar > -1)
+                    setFound(scalar, pos);
+                scalar = -1;
+                // The delimiter is processed in the new state.
+                endValue();
+                put(c, false);
+                return;
+            }
+            if (scalar > -1 && fields[scalar].value)
+                *fields[scalar].value += c;
+            break;
+
+        case st_next:
+            if (isSpace(c))
+                break;
+            if (c == ',')
+                state = isObject() ? st_object : st_value;
+            else if ((c != '}' && c != ']') || !pop(c))
+                state = st_error;
+            break;
+
+        case st_end:
+            if (!isSpace(c))
+                state = st_error;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+public:
+    JSONTokenizer() {}
+
+    /**
+     * Start the new input.
+     *
+     * @param fields The members to pull.
+     * @param count The number of members.
+     */
+    void begin(json_field_t *fields, size_t count)
+    {
+        this->fields = fields;
+        this->count = count;
+        remaining = count;
+        pos = 0;
+        state = st_value;
+        stack = 0;
+        depth = 0;
+        match = -1;
+        scalar = -1;
+        container = -1;
+        esc = false;
+        hex_len = 0;
+        surrogate = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            fields[i].p1 = -1;
+            fields[i].p2 = -1;
+            fields[i].found = false;
+            if (fields[i].value)
+                fields[i].value->remove(0, fields[i].value->length());
+        }
+    }
+
+    /**
+     * Scan the input chunk.
+     *
+     * @param data The input chunk.
+     * @param len The input chunk length.
+     * @return bool Return false when the input is not valid JSON.
+     *
+     * The input is not scanned further when all members were found.
+     */
+    bool feed(const char *data, size_t len)
+    {
+        for (size_t i = 0; i < len && state != st_error && !done(); i++, pos++)
+            put(data[i]);
+        return state != st_error;
+    }
+
+    bool feed(const String &data) { return feed(data.c_str(), data.length()); }
+
+    // All members were found.
+    bool done() const { return remaining == 0; }
+
+    bool error() const { return state == st_error; }
+};
+
+#endif
@@ -41,24 +41,26 @@ public:
 
     bool decodeBase64OTA(Memory &mem, Base64Util *but, const char *src, int16_t &code)
     {
-        bool ret = true;
-        firebase_base64_io_t<uint8_t> out;
-        uint8_t *buf = reinterpret_cast<uint8_t *>(mem.alloc(out.bufLen));
-        out.ota = true;
-        out.outT = buf;
-        unsigned char *base64DecBuf = but->creatBase64DecBuffer(mem);
-        if (!but->decode<uint8_t>(mem, base64DecBuf, src, strlen(src), out))
+        if (!but->decodeToOTA(mem, src))
         {
-            code = FIREBASE_ERROR_FW_UPDATE_WRITE_FAILED;
-            ret = false;
+            code = writeErrorCode();
+            return false;
         }
-        mem.release(&buf);
-        mem.release(&base64DecBuf);
-        return ret;
+        return true;
+    }
+
+    // The error code of the failed firmware write.
+    int16_t writeErrorCode()
+    {
+#if defined(FIREBASE_DELTA_OTA)
+        if (getDeltaOTA().isUnsupportedPatch())
+            return FIREBASE_ERROR_FW_UPDATE_UNSUPPORTED_PATCH;
+#endif
+        return FIREBASE_ERROR_FW_UPDATE_WRITE_FAILED;
     }
 
 #if defined(FIREBASE_OTA_STORAGE)
-    void setOTAStorage(uint32_t addr) { getOTAUpdater().setOTAStorage(addr); }
+    void setOTAStorage(uintptr_t addr) { getOTAUpdater().setOTAStorage(addr); }
 #endif
 
 #if defined(OTA_UPDATE_ENABLED) && defined(FIREBASE_OTA_UPDATER)
@@ -66,7 +68,12 @@ public:
     {
         code = 0;
         int size = base64 ? (3 * (payloadLen - 2) / 4) : payloadLen;
+#if defined(FIREBASE_DELTA_OTA)
+        // The OTA updater begins when the first data shows whether it is the full image or the patch.
+        if (!getDeltaOTA().begin(size, command))
+#else
         if (!FIREBASE_OTA_UPDATER.begin(size, command))
+#endif
             code = FIREBASE_ERROR_FW_UPDATE_TOO_LOW_FREE_SKETCH_SPACE;
 #if defined(FIREBASE_OTA_STORAGE)
         if (!getOTAUpdater().isInit())
@@ -85,13 +92,35 @@ public:
             b64ut.updateWrite(buf, pad);
         }
 
+#if defined(FIREBASE_DELTA_OTA)
+        // The incomplete patch.
+        if (!getDeltaOTA().end() && code == 0)
+            code = FIREBASE_ERROR_FW_UPDATE_END_FAILED;
+#endif
+
         if (code == 0)
         {
             if (!FIREBASE_OTA_UPDATER.end())
                 code = FIREBASE_ERROR_FW_UPDATE_END_FAILED;
         }
+        else
+            abortDownloadOTA();
         return code == 0;
     }
+
+    // Stop the download that was failed, the delta OTA buffers are released and the incomplete image is not applied.
+    void abortDownloadOTA()
+    {
+#if defined(FIREBASE_DELTA_OTA)
+        getDeltaOTA().end();
+#endif
+#if defined(ESP32) && !defined(FIREBASE_OTA_STORAGE)
+        FIREBASE_OTA_UPDATER.abort();
+#else
+        // The updater is not finished, it is reset without applying the image.
+        FIREBASE_OTA_UPDATER.end();
+#endif
+    }
 #endif
 };
 #endif
\ No newline at end of file
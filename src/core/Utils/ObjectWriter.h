@@ -18,34 +18,52 @@ private:
     JSONUtil jut;
     StringUtil sut;
 
+    // Reserve the buffer in power of two size, the appended buffer is reallocated log(n) times.
+    void reserve(String &buf, size_t len)
+    {
+        size_t size = 32;
+        while (size < len + 1)
+            size <<= 1;
+        buf.reserve(size);
+    }
+
+    void append(String &buf, const char *s, size_t len) { buf.concat(s, len); }
+
+    // The position of closing token, the token is usually at the end of buffer.
+    int closingIndex(const String &buf, const String &token)
+    {
+        if (buf.length() >= token.length() && strcmp(buf.c_str() + buf.length() - token.length(), token.c_str()) == 0)
+            return buf.length() - token.length();
+        return buf.lastIndexOf(token);
+    }
+
 public:
     void addMember(String &buf, const String &v, bool isString, const String &token = "}}")
     {
-        int p = buf.lastIndexOf(token);
-        String str = buf.substring(0, p);
-        str += ',';
-        // Add to object
+        // The member is appended in place of the closing token or at the end of buffer when the token was not found.
+        int p = closingIndex(buf, token);
+        if (p > -1)
+            buf.remove(p);
+        reserve(buf, buf.length() + v.length() + token.length() + 3);
+        buf += ',';
+        // Add to object, the enclosing braces of object are removed.
         if (token[0] == '}')
         {
-            String tmp;
             if (isString)
-                tmp += '"';
-            tmp += v;
-            if (isString)
-                tmp += '"';
-            str += tmp.substring(1, tmp.length() - 1);
+                buf += v;
+            else if (v.length() > 1)
+                append(buf, v.c_str() + 1, v.length() - 2);
         }
         // Add to array
         else
         {
             if (isString)
-                str += '"';
-            str += v;
+                buf += '"';
+            buf += v;
             if (isString)
-                str += '"';
+                buf += '"';
         }
-        str += token;
-        buf = str;
+        buf += token;
     }
 
     void addObject(String &buf, const String &object, const String &token, bool clear = false)
@@ -73,16 +91,28 @@ public:
             }
             else
                 addMember(buf[index], memberValue, isString, "]}");
-
-            getBuf(buf, size);
         }
     }
 
+    // Build the object in buf[0] from the members in the other buffers.
     void getBuf(String *buf, size_t size)
     {
+        size_t len = 2;
+        for (size_t i = 1; i < size; i++)
+            len += buf[i].length() + 1;
+
         clear(buf[0]);
+        buf[0].reserve(len);
         for (size_t i = 1; i < size; i++)
-            addObject(buf[0], buf[i], "}", i == 0);
+        {
+            // The enclosing braces of member object are removed.
+            if (buf[i].length() < 2)
+                continue;
+            buf[0] += buf[0].length() ? ',' : '{';
+            append(buf[0], buf[i].c_str() + 1, buf[i].length() - 2);
+        }
+        if (buf[0].length())
+            buf[0] += '}';
     }
 
     void setObject(String *buf, size_t size, uint8_t index, const String &key, const String &value, bool isString, bool last)
@@ -94,7 +124,6 @@ public:
                 clear(buf[index]);
                 jut.addObject(buf[index], key, value, isString, last);
             }
-            getBuf(buf, size);
         }
     }
 
@@ -155,6 +184,7 @@ private:
     ObjectWriter owriter;
     JSONUtil jut;
     StringUtil sut;
+    bool changed = false; // The object members were changed and the object was not built.
 
     template <typename T>
     struct v_number
@@ -173,6 +203,13 @@ private:
     void setObject(String *buf, size_t bufSize, uint8_t index, const String &key, const String &value, bool isString, bool last)
     {
         owriter.setObject(buf, bufSize, index, key, value, isString, last);
+        changed = true;
+    }
+
+    void addMapArrayMember(String *buf, size_t bufSize, uint8_t index, const String &key, const String &memberValue, bool isString)
+    {
+        owriter.addMapArrayMember(buf, bufSize, index, key, memberValue, isString);
+        changed = true;
     }
 
 public:
@@ -240,32 +277,45 @@ public:
     template <typename T1, typename T2>
     T1 append(T1 ret, bool value, String *buf, size_t bufSize, uint8_t index, const String &name)
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, owriter.getBoolStr(value), false);
+        addMapArrayMember(buf, bufSize, index, name, owriter.getBoolStr(value), false);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<v_number<T2>::value, T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, sut.numString(value), false);
+        addMapArrayMember(buf, bufSize, index, name, sut.numString(value), false);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<v_sring<T2>::value, T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, value, true);
+        addMapArrayMember(buf, bufSize, index, name, value, true);
         return ret;
     }
 
     template <typename T1, typename T2>
     auto append(T1 ret, const T2 &value, String *buf, size_t bufSize, uint8_t index, const String &name) -> typename std::enable_if<(!v_sring<T2>::value && !v_number<T2>::value && !std::is_same<T2, bool>::value), T1>::type
     {
-        owriter.addMapArrayMember(buf, bufSize, index, name, value.c_str(), false);
+        addMapArrayMember(buf, bufSize, index, name, value.c_str(), false);
         return ret;
     }
     void clear(String &buf) { sut.clear(buf); }
-    void clear(String *buf, size_t bufSize) { owriter.clearBuf(buf, bufSize); }
+    void clear(String *buf, size_t bufSize)
+    {
+        owriter.clearBuf(buf, bufSize);
+        changed = false;
+    }
+
+    // Build the object from its members when it was changed.
+    // The object is built once when it was used instead of every member changes.
+    void build(String *buf, size_t bufSize)
+    {
+        if (changed)
+            owriter.getBuf(buf, bufSize);
+        changed = false;
+    }
 };
 
 class BaseObjects : public Printable
@@ -274,18 +324,37 @@ class BaseObjects : public Printable
 protected:
     size_t bufferSize = 0;
     String *buffers = nullptr;
-    BufWriter wr;
+    mutable BufWriter wr;
+
+    // Copy the built object and its members to the buffers of this object.
+    void copy(const BaseObjects &rhs)
+    {
+        if (this == &rhs)
+            return;
+        rhs.wr.build(rhs.buffers, rhs.bufferSize);
+        for (size_t i = 0; i < bufferSize && i < rhs.bufferSize; i++)
+            buffers[i] = rhs.buffers[i];
+        wr = rhs.wr;
+    }
 
 public:
     BaseObjects() {}
-    ~BaseObjects() { clear(); }
+    // The copy does not share the buffers of other object, its buffers are set and copied by the derived class.
+    BaseObjects(const BaseObjects &rhs) : Printable(rhs), wr(rhs.wr) {}
+    BaseObjects &operator=(const BaseObjects &rhs) { copy(rhs); return *this; }
+    // The buffers are the members of the derived class that were already destroyed, they are not cleared here.
+    ~BaseObjects() {}
     void init(String *buffers, size_t size)
     {
         this->buffers = buffers;
         this->bufferSize = size;
     }
-    const char *c_str() const { return buffers[0].c_str(); }
-    size_t printTo(Print &p) const override { return p.print(buffers[0].c_str()); }
+    const char *c_str() const
+    {
+        wr.build(buffers, bufferSize);
+        return buffers[0].c_str();
+    }
+    size_t printTo(Print &p) const override { return p.print(c_str()); }
     void clear() { wr.clear(buffers, bufferSize); }
     void setContent(const String &content)
     {
@@ -323,6 +392,8 @@ protected:
 
 public:
     BaseO2() { init(buf, bufSize); }
+    BaseO2(const BaseO2 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO2 &operator=(const BaseO2 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO4 : public BaseObjects
@@ -333,6 +404,8 @@ protected:
 
 public:
     BaseO4() { init(buf, bufSize); }
+    BaseO4(const BaseO4 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO4 &operator=(const BaseO4 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO6 : public BaseObjects
@@ -344,6 +417,8 @@ protected:
 
 public:
     BaseO6() { init(buf, bufSize); }
+    BaseO6(const BaseO6 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO6 &operator=(const BaseO6 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO8 : public BaseObjects
@@ -354,6 +429,8 @@ protected:
 
 public:
     BaseO8() { init(buf, bufSize); }
+    BaseO8(const BaseO8 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO8 &operator=(const BaseO8 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO10 : public BaseObjects
@@ -364,6 +441,8 @@ protected:
 
 public:
     BaseO10() { init(buf, bufSize); }
+    BaseO10(const BaseO10 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO10 &operator=(const BaseO10 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO12 : public BaseObjects
@@ -374,6 +453,8 @@ protected:
 
 public:
     BaseO12() { init(buf, bufSize); }
+    BaseO12(const BaseO12 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO12 &operator=(const BaseO12 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO16 : public BaseObjects
@@ -384,6 +465,8 @@ protected:
 
 public:
     BaseO16() { init(buf, bufSize); }
+    BaseO16(const BaseO16 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO16 &operator=(const BaseO16 &rhs) { copy(rhs); return *this; }
 };
 
 class BaseO26 : public BaseObjects
@@ -394,6 +477,8 @@ protected:
 
 public:
     BaseO26() { init(buf, bufSize); }
+    BaseO26(const BaseO26 &rhs) : BaseObjects(rhs) { init(buf, bufSize); copy(rhs); }
+    BaseO26 &operator=(const BaseO26 &rhs) { copy(rhs); return *this; }
 };
 
 namespace firebase_ns
@@ -11,6 +11,7 @@
 #include <Client.h>
 #include "./core/Utils/StringUtil.h"
 #include "./core/Utils/Memory.h"
+#include "./core/Utils/JSONTokenizer.h"
 
 class URLUtil
 {
@@ -149,14 +150,14 @@ public:
 
     void updateDownloadURL(String &url, const String &payload)
     {
-        int p1 = payload.indexOf("\"downloadTokens\": \"");
-        if (p1 > -1)
-        {
-            p1 += 19;
-            int p2 = payload.indexOf("\"", p1);
-            if (p2 > -1)
-                url.replace("a82781ce-a115-442f-bac6-a52f7f63b3e8", payload.substring(p1, p2));
-        }
+        // The object metadata member is found regardless of its formatting.
+        String token;
+        json_field_t field("downloadTokens", 1, &token);
+        JSONTokenizer jt;
+        jt.begin(&field, 1);
+        jt.feed(payload);
+        if (field.found && token.length())
+            url.replace("a82781ce-a115-442f-bac6-a52f7f63b3e8", token);
     }
 
     void addEncUrl(String &buff, const String &prefix, const String &param) { sut.printTo(buff, encode(param).length() + prefix.length(), "%s%s", prefix.c_str(), encode(param).c_str()); }
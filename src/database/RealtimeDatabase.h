@@ -9,6 +9,7 @@
 #include <Arduino.h>
 #include "./core/FirebaseApp.h"
 #include "./database/DataOptions.h"
+#include "./database/WriteCoalescer.h"
 
 using namespace firebase_ns;
 
@@ -39,7 +40,11 @@ public:
      * Set the Firebase database URL
      * @param url The Firebase database URL.
      */
-    void url(const String &url) { this->service_url = uut.getHost(url, nullptr); }
+    void url(const String &url)
+    {
+        this->service_url = uut.getHost(url, nullptr);
+        cache.clear();
+    }
 
     /**
      * Get value at the node path.
@@ -121,6 +126,43 @@ public:
      */
     void get(AsyncClientClass &aClient, const String &path, AsyncResultCallback cb, bool sse = false, const String &uid = "") { sendRequest(&aClient, path, reqns::http_get, slot_options_t(false, sse, true, false, false, false), nullptr, nullptr, nullptr, cb, uid); }
 
+    /**
+     * Start the Stream for the listeners of StreamMultiplexer.
+     *
+     * ### Example
+     * ```cpp
+     * mux.addListener("/devices/1/config/led", ledCb, "put,patch");
+     * mux.addListener("/devices/1/config/interval", intervalCb);
+     * Database.get(aClient, mux, aResult);
+     * ```
+     * @param aClient The async client.
+     * @param mux The StreamMultiplexer that its listeners receive the events of their paths.
+     * @param aResult The async result (AsyncResult) that receives all events and errors of the Stream.
+     *
+     * The Stream is started at the common ancestor path of all listeners, only one Stream per async client is required.
+     *
+     */
+    void get(AsyncClientClass &aClient, StreamMultiplexer &mux, AsyncResult &aResult) { streamRequest(&aClient, mux, &aResult, NULL); }
+
+    /**
+     * Start the Stream for the listeners of StreamMultiplexer.
+     *
+     * ### Example
+     * ```cpp
+     * mux.addListener("/devices/1/config/led", ledCb, "put,patch");
+     * mux.addListener("/devices/1/config/interval", intervalCb);
+     * Database.get(aClient, mux, cb);
+     * ```
+     * @param aClient The async client.
+     * @param mux The StreamMultiplexer that its listeners receive the events of their paths.
+     * @param cb The async result callback (AsyncResultCallback) that receives all events and errors of the Stream.
+     * @param uid The user specified UID of async result (optional).
+     *
+     * The Stream is started at the common ancestor path of all listeners, only one Stream per async client is required.
+     *
+     */
+    void get(AsyncClientClass &aClient, StreamMultiplexer &mux, AsyncResultCallback cb, const String &uid = "") { streamRequest(&aClient, mux, nullptr, cb, uid); }
+
     /**
      * Get value at the node path.
      *
@@ -936,12 +978,58 @@ public:
      */
     void setSSEFilters(const String &filter = "") { this->sse_events_filter = filter; }
 
+    /**
+     * Enable the write coalescing.
+     * @param enable The option to merge the async set and update calls into the multi-location update.
+     * @param windowMs The time in milliseconds that the first write is held to merge the subsequent writes.
+     *
+     * The async set and update calls (with AsyncResult or AsyncResultCallback) that are queued in the same async client
+     * are sent as one PATCH request at their common root, and the response is delivered to every caller's
+     * AsyncResult or AsyncResultCallback. The response payload is the multi-location update data.
+     *
+     * The writes with Etag, the writes of file and the writes to location that is the ancestor or descendant of
+     * the queued write location are not merged.
+     */
+    void setWriteCoalescing(bool enable, uint16_t windowMs = 100)
+    {
+        this->coalesce = enable;
+        this->coalesce_window_ms = windowMs;
+    }
+
+    /**
+     * Get the write coalescing stats.
+     * @return rtdb_coalesce_stats_t The number of multi-location update requests and the number of writes that were sent with them.
+     */
+    rtdb_coalesce_stats_t coalesceStats() const { return coalesce_stats; }
+
+    /**
+     * Enable the local cache.
+     * @param enable The option to keep the data of the Streams in memory.
+     * @param maxSize The maximum memory in bytes that is used by the cache.
+     *
+     * The put and patch events of the Streams that are started after this call are applied to the cache.
+     * The get calls (without DatabaseOptions) of the path under the Stream path are served from the cache
+     * without network request when the whole value at that path is in the cache.
+     * The cached data is removed when the Stream was stopped, timed out or reconnected, and the least recently used
+     * data is removed when the cache size exceeds maxSize.
+     *
+     * The value that was written by set, update or remove is in the cache after its Stream event was received.
+     */
+    void setLocalCache(bool enable, size_t maxSize = FIREBASE_RTDB_CACHE_SIZE) { cache.begin(enable, maxSize); }
+
+    /**
+     * Get the local cache stats.
+     * @return rtdb_cache_stats_t The number of get calls that were served from the cache (hits) and sent to the server (misses),
+     * the number of evicted nodes and the current cache size.
+     */
+    rtdb_cache_stats_t cacheStats() const { return cache.getStats(); }
+
 #if defined(FIREBASE_OTA_STORAGE)
     /**
      * Set Arduino OTA Storage.
      *  @param storage The Arduino OTAStorage class object.
      */
-    void setOTAStorage(OTAStorage &storage) { ota_storage_addr = reinterpret_cast<uint32_t>(&storage); }
+    void setOTAStorage(OTAStorage &storage) { ota_storage_addr = reinterpret_cast<uintptr_t>(&storage); }
 #endif
 
     /**
@@ -951,6 +1039,10 @@ public:
 
 private:
     String sse_events_filter;
+    bool coalesce = false;
+    uint16_t coalesce_window_ms = 0;
+    rtdb_coalesce_stats_t coalesce_stats;
+    rtdb_local_cache cache;
     struct req_data
     {
     public:
@@ -962,6 +1054,7 @@ private:
         file_config_data *file = nullptr;
         AsyncResult *aResult = nullptr;
         AsyncResultCallback cb = NULL;
+        StreamMultiplexer *mux = nullptr;
         bool isSSEFilter = false;
         int command = 0;
         req_data() {}
@@ -1009,6 +1102,13 @@ private:
         return aClient->getResult();
     }
 
+    void streamRequest(AsyncClientClass *aClient, StreamMultiplexer &mux, AsyncResult *aResult, AsyncResultCallback cb, const String &uid = "")
+    {
+        req_data areq(aClient, mux.path(), reqns::http_get, slot_options_t(false, true, true, false, false, false), nullptr, nullptr, aResult, cb, uid);
+        areq.mux = &mux;
+        asyncRequest(areq);
+    }
+
     void asyncRequest(req_data &request, const char *payload = "")
     {
         app_token_t *atoken = appToken();
@@ -1028,6 +1128,9 @@ private:
             return request.aClient->setClientError(request, FIREBASE_ERROR_INVALID_DATABASE_URL);
         }
 
+        if (getCache(request))
+            return;
+
         request.opt.app_token = atoken;
         request.opt.user_auth = user_auth;
         request.opt.auth_param = user_auth->getAuthDataType() != user_auth_data_no_token && user_auth->getAuthTokenType() != auth_access_token && user_auth->getAuthTokenType() != auth_sa_access_token;
@@ -1035,6 +1138,24 @@ private:
         sut.printTo(extras, 100, ".json%s%s", request.opt.auth_param ? "?auth=" : "", request.opt.auth_param ? String(FIREBASE_AUTH_PLACEHOLDER).c_str() : ""); //
         addParams(request.opt.auth_param, extras, request.method, request.options, request.file);
 
+        // The writes are sent as the multi-location update.
+        std::vector<rtdb_write_entry_t> writes;
+        String batch;
+        bool coalescing = coalesce && request.opt.async && (request.aResult || request.cb) && !request.opt.sse && !request.file && !request.opt.ota &&
+                          request.etag.length() == 0 && (request.method == reqns::http_put || request.method == reqns::http_patch) &&
+                          WriteCoalescer::getEntries(request.path, payload, request.method == reqns::http_patch, writes);
+
+        if (coalescing)
+        {
+            if (mergeWrites(request, writes, extras))
+                return;
+
+            request.path = WriteCoalescer::getRoot(writes);
+            request.method = reqns::http_patch;
+            WriteCoalescer::getPayload(writes, request.path, batch);
+            payload = batch.c_str();
+        }
+
         async_data *sData = request.aClient->createSlot(request.opt);
 
         if (!sData)
@@ -1042,6 +1163,24 @@ private:
 
         request.aClient->newRequest(sData, service_url, request.path, extras, request.method, request.opt, request.uid, request.etag);
 
+        if (coalescing)
+        {
+            sData->coalesce = true;
+            sData->coalesce_query = extras;
+            sData->hold_ms = coalesce_window_ms;
+            sData->hold_ts = millis();
+            coalesce_stats.requests++;
+            coalesce_stats.writes++;
+        }
+
+        if (sData->sse)
+        {
+            sData->setCache(&cache);
+            sData->setMux(request.mux);
+            if (request.mux)
+                request.mux->stream_path = request.path;
+        }
+
         if (request.file)
             sData->request.file_data.copy(*request.file);
 
@@ -1052,7 +1191,7 @@ private:
             sData->request.ota = true;
             sData->request.base64 = true;
             sData->aResult.download_data.ota = true;
-            sData->request.ul_dl_task_running_addr = ul_dl_task_running_addr;
+            sData->request.ul_dl_task_running = ulDlTaskRunning();
             sData->request.ota_storage_addr = ota_storage_addr;
             sData->request.command = request.command;
         }
@@ -1077,10 +1216,14 @@ private:
         if (request.cb)
             sData->cb = request.cb;
 
-        request.aClient->addRemoveClientVec(reinterpret_cast<uint32_t>(&(cVec)), true);
+        request.aClient->addRemoveClientVec(&cVec, true);
 
         if (request.aResult)
-            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(request.aClient->getResultList())));
+            sData->setRefResult(request.aResult);
+
+        // The multi-location update response is delivered to all merged writers, it is not passed to the payload sink.
+        if (coalescing)
+            sData->payload_sink = NULL;
 
         if (sData->sse && sse_events_filter.length() && !request.isSSEFilter)
             request.aClient->setSSEFilters(sse_events_filter);
@@ -1089,6 +1232,70 @@ private:
         request.aClient->handleRemove();
     }
 
+    // Serve the get request from the local cache.
+    bool getCache(const req_data &request)
+    {
+        String value;
+        if (request.method != reqns::http_get || request.opt.sse || request.options || request.file || request.opt.ota || !cache.get(request.path, value))
+            return false;
+
+        AsyncResult result;
+        AsyncResult *aResult = request.aResult ? request.aResult : &result;
+        aResult->lastError.reset();
+        aResult->setUID(request.uid);
+        aResult->setPath(request.path);
+        clearSSE(&aResult->rtdbResult);
+        aResult->setPayload(value);
+        if (request.cb)
+            request.cb(*aResult);
+        return true;
+    }
+
+    // Merge the writes to the last queued multi-location update of the async client.
+    bool mergeWrites(const req_data &request, const std::vector<rtdb_write_entry_t> &writes, const String &extras)
+    {
+        async_data *sData = nullptr;
+        for (int i = request.aClient->slotCount() - 1; i >= 0; i--)
+        {
+            sData = request.aClient->sman.getData(i);
+            if (sData && !sData->sse)
+                break;
+            sData = nullptr;
+        }
+
+        // The request is not sent and it is the last task in the queue to keep the writes order.
+        // The writes with different query parameters (DatabaseOptions) are not merged.
+        if (!sData || !sData->coalesce || sData->state != astate_undefined || sData->to_remove || sData->pipelined ||
+            sData->request.val[reqns::url] != service_url || sData->request.app_token != request.opt.app_token || sData->coalesce_query != extras)
+            return false;
+
+        std::vector<rtdb_write_entry_t> entries;
+        if (!WriteCoalescer::split(sData->request.val[reqns::payload], sData->request.val[reqns::path], entries) || !WriteCoalescer::merge(entries, writes))
+            return false;
+
+        String root = WriteCoalescer::getRoot(entries), payload;
+        WriteCoalescer::getPayload(entries, root, payload);
+
+        slot_options_t opt = request.opt;
+        request.aClient->newRequest(sData, service_url, root, sData->coalesce_query, reqns::http_patch, opt, sData->aResult.uid(), "");
+        sData->request.val[reqns::payload] = payload;
+        sData->request.setContentLengthFinal(payload.length());
+
+        async_result_target_t target;
+        target.result = request.aResult;
+        target.result_handle = request.aResult ? resultHandleBase(request.aResult) : 0;
+        target.cb = request.cb;
+        target.uid = request.uid;
+        if (target.uid.length() == 0)
+        {
+            AsyncResult res;
+            target.uid = res.uid();
+        }
+        sData->targets.push_back(target);
+        coalesce_stats.writes++;
+        return true;
+    }
+
     void addParams(bool hasParam, String &extras, reqns::http_request_method method, DatabaseOptions *options, bool isFile)
     {
         String params;
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef DATABASE_WRITE_COALESCER_H
+#define DATABASE_WRITE_COALESCER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "./core/Utils/JSONPath.h"
+
+#if defined(ENABLE_DATABASE)
+
+// The write coalescing stats of RealtimeDatabase.
+struct rtdb_coalesce_stats_t
+{
+    uint32_t requests = 0; // The number of multi-location update requests.
+    uint32_t writes = 0;   // The number of set and update calls that were sent with these requests.
+};
+
+// The location and JSON value of the multi-location update.
+struct rtdb_write_entry_t
+{
+    String path, value;
+};
+
+// Merges the set and update writes into the multi-location update (PATCH) payload at their common root.
+// The payload of the queued request is the source of its writes, no write list is kept.
+class WriteCoalescer
+{
+public:
+    // Split the top-level members of JSON object, the member names are the locations under root.
+    static bool split(const String &json, const String &root, std::vector<rtdb_write_entry_t> &entries)
+    {
+        const char *s = json.c_str();
+        size_t i = 0;
+        JSONPathUtil::skipSpace(s, i);
+        if (s[i++] != '{')
+            return false;
+        while (true)
+        {
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] == '}')
+                return true;
+            if (s[i] != '"')
+                return false;
+            size_t k = i;
+            if (!JSONPathUtil::skipString(s, i))
+                return false;
+            rtdb_write_entry_t entry;
+            entry.path = JSONPathUtil::join(JSONPathUtil::normalize(root), JSONPathUtil::normalize(json.substring(k + 1, i - 1)));
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i++] != ':')
+                return false;
+            JSONPathUtil::skipSpace(s, i);
+            size_t v = i;
+            if (!JSONPathUtil::skipValue(s, i) || i == v)
+                return false;
+            entry.value = json.substring(v, i);
+            entries.push_back(entry);
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] == ',')
+                i++;
+        }
+    }
+
+    // Get the locations and values of set (the value at path) or update (the children of object at path).
+    static bool getEntries(const String &path, const String &payload, bool update, std::vector<rtdb_write_entry_t> &entries)
+    {
+        if (update)
+            return split(payload, path, entries) && entries.size() > 0;
+
+        rtdb_write_entry_t entry;
+        entry.path = JSONPathUtil::normalize(path);
+        entry.value = payload;
+        entry.value.trim();
+        if (entry.path.length() == 0 || entry.value.length() == 0)
+            return false;
+        entries.push_back(entry);
+        return true;
+    }
+
+    // Merge the new writes, the write to the same location replaces the previous value.
+    // Returns false when the location of new write is the ancestor or descendant of previous write
+    // which is not allowed in the multi-location update.
+    static bool merge(std::vector<rtdb_write_entry_t> &entries, const std::vector<rtdb_write_entry_t> &writes)
+    {
+        for (size_t i = 0; i < writes.size(); i++)
+        {
+            for (size_t j = 0; j < entries.size(); j++)
+            {
+                if (entries[j].path != writes[i].path && (JSONPathUtil::isAncestor(entries[j].path, writes[i].path) || JSONPathUtil::isAncestor(writes[i].path, entries[j].path)))
+                    return false;
+            }
+        }
+
+        for (size_t i = 0; i < writes.size(); i++)
+        {
+            size_t j = 0;
+            while (j < entries.size() && entries[j].path != writes[i].path)
+                j++;
+            if (j < entries.size())
+                entries[j].value = writes[i].value;
+            else
+                entries.push_back(writes[i]);
+        }
+        return true;
+    }
+
+    // The deepest location that is the ancestor of all writes.
+    static String getRoot(const std::vector<rtdb_write_entry_t> &entries)
+    {
+        if (entries.size() == 0)
+            return "";
+
+        String root = entries[0].path;
+        for (size_t i = 1; i < entries.size(); i++)
+        {
+            while (root.length() && !JSONPathUtil::isAncestor(root, entries[i].path))
+            {
+                int p = root.lastIndexOf('/');
+                root.remove(p > -1 ? p : 0);
+            }
+        }
+
+        // The member name should not be empty.
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].path == root)
+            {
+                int p = root.lastIndexOf('/');
+                root.remove(p > -1 ? p : 0);
+                break;
+            }
+        }
+        return root;
+    }
+
+    static void getPayload(const std::vector<rtdb_write_entry_t> &entries, const String &root, String &payload)
+    {
+        payload = "{";
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (i > 0)
+                payload += ',';
+            payload += '"';
+            payload += root.length() ? entries[i].path.substring(root.length() + 1) : entries[i].path;
+            payload += "\":";
+            payload += entries[i].value;
+        }
+        payload += '}';
+    }
+};
+
+#endif
+#endif
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Suwatchai K. <suwatchai@outlook.com>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef FIRESTORE_BATCH_WRITER_H
+#define FIRESTORE_BATCH_WRITER_H
+
+#include <Arduino.h>
+#include "./core/Error.h"
+#include "./core/Utils/JSONPath.h"
+#include "./core/Utils/JSONTokenizer.h"
+
+#if defined(ENABLE_FIRESTORE)
+
+// The maximum number of writes in the batch write request.
+#define FIRESTORE_MAX_BATCH_WRITES 500
+
+// Builds the batch write request payload from the document writes and gets the result of each write from its response.
+class BatchWriter
+{
+public:
+    // Get the element at index of writeResults and status arrays of the batch write response.
+    // The status is the empty object when the response has no status of the write.
+    static bool getResult(const String &json, int index, String &writeResult, String &status)
+    {
+        String writeResults, statuses;
+        json_field_t fields[] = {json_field_t("writeResults", 1, &writeResults), json_field_t("status", 1, &statuses)};
+        JSONTokenizer tokenizer;
+        tokenizer.begin(fields, 2);
+        tokenizer.feed(json);
+        if (!fields[0].found || !getElement(writeResults, index, writeResult))
+            return false;
+        if (!fields[1].found || !getElement(statuses, index, status))
+            status = "{}";
+        return true;
+    }
+
+    // Get the google.rpc.Code and message of the write status.
+    static int getStatus(const String &status, String &message)
+    {
+        String code;
+        json_field_t fields[] = {json_field_t("code", 1, &code), json_field_t("message", 1, &message)};
+        JSONTokenizer tokenizer;
+        tokenizer.begin(fields, 2);
+        tokenizer.feed(status);
+        return fields[0].found ? code.toInt() : 0;
+    }
+
+    // Get the element at index of JSON array.
+    static bool getElement(const String &json, int index, String &value)
+    {
+        const char *s = json.c_str();
+        size_t i = 0;
+        JSONPathUtil::skipSpace(s, i);
+        if (index < 0 || s[i++] != '[')
+            return false;
+        for (int n = 0;; n++)
+        {
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] == ']')
+                return false;
+            size_t v = i;
+            if (!JSONPathUtil::skipValue(s, i))
+                return false;
+            if (n == index)
+            {
+                value = json.substring(v, i);
+                return value.length() > 0;
+            }
+            JSONPathUtil::skipSpace(s, i);
+            if (s[i] != ',')
+                return false;
+            i++;
+        }
+    }
+
+    // Add the write to the writes array of the batch write payload.
+    static void add(String &payload, const String &write)
+    {
+        if (payload.length() == 0)
+        {
+            payload = "{\"writes\":[";
+            payload += write;
+            payload += "]}";
+            return;
+        }
+        payload.remove(payload.length() - 2);
+        payload += ',';
+        payload += write;
+        payload += "]}";
+    }
+
+    // The HTTP status code of the google.rpc.Code of the write status.
+    static int toHttpCode(int code)
+    {
+        switch (code)
+        {
+        case 0:
+            return FIREBASE_ERROR_HTTP_CODE_OK;
+        case 1: // CANCELLED
+            return 499;
+        case 3:  // INVALID_ARGUMENT
+        case 9:  // FAILED_PRECONDITION
+        case 11: // OUT_OF_RANGE
+            return FIREBASE_ERROR_HTTP_CODE_BAD_REQUEST;
+        case 4: // DEADLINE_EXCEEDED
+            return FIREBASE_ERROR_HTTP_CODE_GATEWAY_TIMEOUT;
+        case 5: // NOT_FOUND
+            return FIREBASE_ERROR_HTTP_CODE_NOT_FOUND;
+        case 6:  // ALREADY_EXISTS
+        case 10: // ABORTED
+            return FIREBASE_ERROR_HTTP_CODE_CONFLICT;
+        case 7: // PERMISSION_DENIED
+            return FIREBASE_ERROR_HTTP_CODE_FORBIDDEN;
+        case 8: // RESOURCE_EXHAUSTED
+            return FIREBASE_ERROR_HTTP_CODE_TOO_MANY_REQUESTS;
+        case 12: // UNIMPLEMENTED
+            return FIREBASE_ERROR_HTTP_CODE_NOT_IMPLEMENTED;
+        case 14: // UNAVAILABLE
+            return FIREBASE_ERROR_HTTP_CODE_SERVICE_UNAVAILABLE;
+        case 16: // UNAUTHENTICATED
+            return FIREBASE_ERROR_HTTP_CODE_UNAUTHORIZED;
+        default: // UNKNOWN, INTERNAL, DATA_LOSS
+            return FIREBASE_ERROR_HTTP_CODE_INTERNAL_SERVER_ERROR;
+        }
+    }
+};
+
+#endif
+#endif
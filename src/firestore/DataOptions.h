@@ -390,9 +390,14 @@ private:
     ObjectWriter owriter;
     JSONUtil jut;
     StringUtil sut;
+    bool changed = false; // The document was changed and was not built.
 
+    // Build the document once when it was used instead of every field changes.
     Document &getBuf()
     {
+        if (!changed)
+            return *this;
+        changed = false;
         buf[2] = mv.c_str();
         sut.clear(buf[3]);
         if (buf[1].length())
@@ -418,7 +423,7 @@ public:
     explicit Document(const String &name = "")
     {
         buf[1] = name;
-        getBuf();
+        changed = true;
     }
 
     /**
@@ -429,7 +434,7 @@ public:
     explicit Document(const String &key, T value)
     {
         mv.add(key, value);
-        getBuf();
+        changed = true;
     }
 
     /**
@@ -440,7 +445,8 @@ public:
     Document &add(const String &key, T value)
     {
         mv.add(key, value);
-        return getBuf();
+        changed = true;
+        return *this;
     }
 
     /**
@@ -450,14 +456,17 @@ public:
     void setName(const String &name)
     {
         buf[1] = name;
-        getBuf();
+        changed = true;
     }
 
-    const char *c_str() const { return buf[0].c_str(); }
+    const char *c_str() const { return const_cast<Document *>(this)->getBuf().buf[0].c_str(); }
+
+    size_t printTo(Print &p) const override { return p.print(c_str()); }
 
     void clear()
     {
         owriter.clearBuf(buf, bufSize);
+        changed = false;
         mv.clear();
     }
 };
@@ -885,12 +894,21 @@ public:
 
 class PatchDocumentOptions : public BaseO1
 {
+    friend class FirestoreBase;
+
 private:
     URLUtil uut;
+    // The options of the write when the patch is sent with the batch write.
+    DocumentMask update_mask;
+    Precondition current_document;
+    bool read_mask = false;
 
 public:
     explicit PatchDocumentOptions(DocumentMask updateMask, DocumentMask mask, const Precondition &currentDocument)
     {
+        update_mask = updateMask;
+        current_document = currentDocument;
+        read_mask = strlen(mask.c_str()) > 0;
         bool hasParam = false;
         if (strlen(updateMask.c_str()))
             buf = updateMask.getQuery("updateMask", hasParam);
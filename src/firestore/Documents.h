@@ -178,6 +178,31 @@ namespace Firestore
          */
         void batchWrite(AsyncClientClass &aClient, const Parent &parent, Writes &writes, AsyncResultCallback cb, const String &uid = "") { batchWriteDoc(aClient, nullptr, cb, uid, parent, writes, true); }
 
+        /** Enable the automatic batch write.
+         *
+         * @param enable The option to send the async patch, createDocument and deleteDoc calls with the batch write.
+         * @param windowMs The time in milliseconds that the first write is held to collect the subsequent writes.
+         * @param maxWrites The maximum number of writes in a batch write (1 to 500). The batch is sent when it is full.
+         *
+         * The async writes (with AsyncResult or AsyncResultCallback) to the same project and database that are queued
+         * in the same async client are sent as one batch write request, and the result of each write is delivered to
+         * its caller's AsyncResult or AsyncResultCallback. The result payload is the JSON object that contains the
+         * "writeResult" and "status" of that write, and the error of the failed write is set from its status.
+         *
+         * The writes are not applied atomically and can be applied out of order.
+         * The createDocument without documentId and the patch and createDocument with mask (the fields to return) are
+         * sent as usual.
+         *
+         * The batch write requires ServiceAuth authentication.
+         *
+         */
+        void setAutoBatch(bool enable, uint16_t windowMs = 100, uint16_t maxWrites = FIRESTORE_MAX_BATCH_WRITES)
+        {
+            this->batch_writes = enable;
+            this->batch_window_ms = windowMs;
+            this->batch_max_writes = maxWrites == 0 ? 1 : (maxWrites > FIRESTORE_MAX_BATCH_WRITES ? FIRESTORE_MAX_BATCH_WRITES : maxWrites);
+        }
+
         /** Starts a new transaction.
          *
          * @param aClient The async client.
@@ -650,6 +675,51 @@ namespace Firestore
          */
         void list(AsyncClientClass &aClient, const Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, AsyncResultCallback cb, const String &uid = "") { listDocs(aClient, nullptr, cb, uid, parent, collectionId, listDocsOptions, true); }
 
+        /** List the documents in the defined documents collection and pass each document to the document callback as it was read.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param collectionId The relative path of document colection.
+         * @param listDocsOptions The ListDocumentsOptions object that provides the member functions pageSize, pageToken, orderBy, mask and
+         * showMissing for creating the query string options pageSize, pageToken, orderBy, mask and showMissing respectively.
+         * The option pageSize is for setting the maximum number of documents to return in each page.
+         * @param docCb The FirestoreDocumentCallback function that receives the firestore_document_t object of each document.
+         * @param aResult The async result (AsyncResult).
+         *
+         * The documents are not kept in the async result, only one document is kept in memory while the response is read.
+         * The next pages are requested with the nextPageToken until the last page was read.
+         * When completed, the async result payload is the JSON object that contains the documentCount and pageCount.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void list(AsyncClientClass &aClient, const Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, FirestoreDocumentCallback docCb, AsyncResult &aResult) { listDocs(aClient, &aResult, NULL, "", parent, collectionId, listDocsOptions, true, docCb); }
+
+        /** List the documents in the defined documents collection and pass each document to the document callback as it was read.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param collectionId The relative path of document colection.
+         * @param listDocsOptions The ListDocumentsOptions object that provides the member functions pageSize, pageToken, orderBy, mask and
+         * showMissing for creating the query string options pageSize, pageToken, orderBy, mask and showMissing respectively.
+         * The option pageSize is for setting the maximum number of documents to return in each page.
+         * @param docCb The FirestoreDocumentCallback function that receives the firestore_document_t object of each document.
+         * @param cb The async result callback (AsyncResultCallback).
+         * @param uid The user specified UID of async result (optional).
+         *
+         * The documents are not kept in the async result, only one document is kept in memory while the response is read.
+         * The next pages are requested with the nextPageToken until the last page was read.
+         * When completed, the async result payload is the JSON object that contains the documentCount and pageCount.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void list(AsyncClientClass &aClient, const Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, FirestoreDocumentCallback docCb, AsyncResultCallback cb, const String &uid = "") { listDocs(aClient, nullptr, cb, uid, parent, collectionId, listDocsOptions, true, docCb); }
+
         /** List the document collection ids in the defined document path.
          *
          * @param aClient The async client.
@@ -945,6 +1015,47 @@ namespace Firestore
          */
         void runQuery(AsyncClientClass &aClient, const Parent &parent, const String &documentPath, const QueryOptions &queryOptions, AsyncResultCallback cb, const String &uid = "") { runQueryImpl(aClient, nullptr, cb, uid, parent, documentPath, queryOptions, true); }
 
+        /** Runs a query and pass each document of the results to the document callback as it was read.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param documentPath The relative path of document to get.
+         * @param queryOptions The QueryOptions object that provides the function to create the query (StructuredQuery) and consistency mode which included
+         * structuredQuery, transaction, newTransaction and readTime functions.
+         * @param docCb The FirestoreDocumentCallback function that receives the firestore_document_t object of each document.
+         * @param aResult The async result (AsyncResult).
+         *
+         * The documents are not kept in the async result, only one document is kept in memory while the response is read.
+         * When completed, the async result payload is the JSON object that contains the documentCount.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void runQuery(AsyncClientClass &aClient, const Parent &parent, const String &documentPath, const QueryOptions &queryOptions, FirestoreDocumentCallback docCb, AsyncResult &aResult) { runQueryImpl(aClient, &aResult, NULL, "", parent, documentPath, queryOptions, true, docCb); }
+
+        /** Runs a query and pass each document of the results to the document callback as it was read.
+         *
+         * @param aClient The async client.
+         * @param parent The Firestore::Parent object included project Id and database Id in its constructor.
+         * The Firebase project Id should be only the name without the firebaseio.com.
+         * The Firestore database id should be (default) or empty "".
+         * @param documentPath The relative path of document to get.
+         * @param queryOptions The QueryOptions object that provides the function to create the query (StructuredQuery) and consistency mode which included
+         * structuredQuery, transaction, newTransaction and readTime functions.
+         * @param docCb The FirestoreDocumentCallback function that receives the firestore_document_t object of each document.
+         * @param cb The async result callback (AsyncResultCallback).
+         * @param uid The user specified UID of async result (optional).
+         *
+         * The documents are not kept in the async result, only one document is kept in memory while the response is read.
+         * When completed, the async result payload is the JSON object that contains the documentCount.
+         *
+         * This function requires ServiceAuth, CustomAuth, UserAuth, CustomToken or IDToken authentication.
+         *
+         */
+        void runQuery(AsyncClientClass &aClient, const Parent &parent, const String &documentPath, const QueryOptions &queryOptions, FirestoreDocumentCallback docCb, AsyncResultCallback cb, const String &uid = "") { runQueryImpl(aClient, nullptr, cb, uid, parent, documentPath, queryOptions, true, docCb); }
+
 #endif
     };
 }
@@ -10,6 +10,7 @@
 #include <Arduino.h>
 #include "./core/FirebaseApp.h"
 #include "./firestore/DataOptions.h"
+#include "./firestore/BatchWriter.h"
 
 #if defined(ENABLE_FIRESTORE)
 
@@ -47,6 +48,10 @@ public:
     void loop() { loopImpl(); }
 
 protected:
+    bool batch_writes = false;
+    uint16_t batch_window_ms = 0;
+    size_t batch_max_writes = FIRESTORE_MAX_BATCH_WRITES;
+
     struct req_data
     {
     public:
@@ -57,6 +62,10 @@ protected:
         Firestore::DataOptions *options = nullptr;
         AsyncResult *aResult = nullptr;
         AsyncResultCallback cb = NULL;
+        // The document write (JSON) that can be sent with the batch write request.
+        String write;
+        // The callback that receives the documents of runQuery and list response.
+        FirestoreDocumentCallback doc_cb = NULL;
         req_data() {}
         explicit req_data(AsyncClientClass *aClient, reqns::http_request_method method, slot_options_t opt, Firestore::DataOptions *options, AsyncResult *aResult, AsyncResultCallback cb, const String &uid = "")
         {
@@ -90,6 +99,21 @@ protected:
 
         url("firestore.googleapis.com");
 
+        // The document write is sent with the batch write request.
+        bool batching = batch_writes && request.write.length() && request.opt.async && (request.aResult || request.cb);
+
+        if (batching)
+        {
+            request.write.replace(reinterpret_cast<const char *>(RESOURCE_PATH_BASE), request.path.substring(request.path.indexOf("projects/")) + "/documents");
+            if (addBatchWrite(request))
+                return;
+
+            extras = "/documents:batchWrite";
+            request.method = reqns::http_post;
+            sut.clear(request.options->payload);
+            BatchWriter::add(request.options->payload, request.write);
+        }
+
         async_data *sData = createSlotBase(request.aClient, request.opt);
 
         if (!sData)
@@ -97,6 +121,20 @@ protected:
 
         newRequestBase(request.aClient, sData, service_url, request.path, extras, request.method, request.opt, request.uid, "");
 
+        if (batching)
+        {
+            // The writers get their results from the batch write result, the task itself has no result and callback.
+            sData->coalesce = true;
+            sData->hold_ms = batch_window_ms;
+            sData->hold_ts = millis();
+            sData->result_filter = batchWriteResult;
+            // The batch write response is split into the writers' results, it is not passed to the payload sink.
+            sData->payload_sink = NULL;
+            addBatchTarget(sData, request);
+            request.aResult = nullptr;
+            request.cb = NULL;
+        }
+
         if (request.options->payload.length())
         {
             sData->request.val[reqns::payload] = request.options->payload;
@@ -106,15 +144,87 @@ protected:
         if (request.cb)
             sData->cb = request.cb;
 
-        addRemoveClientVecBase(request.aClient, reinterpret_cast<uint32_t>(&(cVec)), true);
+        addRemoveClientVecBase(request.aClient, &cVec, true);
 
         if (request.aResult)
-            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(getRVec(request.aClient))));
+            sData->setRefResult(request.aResult);
+
+        // The documents are read from the payload instead of the payload sink.
+        if (request.doc_cb && request.opt.async)
+        {
+            sData->payload_sink = NULL;
+            sData->doc_stream.begin(request.doc_cb, request.options->requestType == cf_list_doc);
+        }
 
         processBase(request.aClient, sData->async);
         handleRemoveBase(request.aClient);
     }
 
+    // Add the document write to the last queued batch write of the async client.
+    bool addBatchWrite(req_data &request)
+    {
+        async_data *sData = nullptr;
+        for (int i = slotCountBase(request.aClient) - 1; i >= 0; i--)
+        {
+            sData = request.aClient->sman.getData(i);
+            if (sData && !sData->sse)
+                break;
+            sData = nullptr;
+        }
+
+        // The request is not sent and it is the last task in the queue to keep the writes order.
+        if (!sData || !sData->coalesce || sData->result_filter != batchWriteResult || sData->state != astate_undefined || sData->to_remove || sData->pipelined ||
+            sData->targets.size() >= batch_max_writes || sData->request.val[reqns::url] != service_url ||
+            sData->request.val[reqns::path] != request.path || sData->request.app_token != request.opt.app_token)
+            return false;
+
+        slot_options_t opt = request.opt;
+        newRequestBase(request.aClient, sData, service_url, request.path, "/documents:batchWrite", reqns::http_post, opt, sData->aResult.uid(), "");
+        BatchWriter::add(sData->request.val[reqns::payload], request.write);
+        sData->request.setContentLengthFinal(sData->request.val[reqns::payload].length());
+        addBatchTarget(sData, request);
+        return true;
+    }
+
+    void addBatchTarget(async_data *sData, const req_data &request)
+    {
+        async_result_target_t target;
+        target.result = request.aResult;
+        target.result_handle = request.aResult ? resultHandleBase(request.aResult) : 0;
+        target.cb = request.cb;
+        target.uid = request.uid;
+        target.index = sData->targets.size();
+        if (target.uid.length() == 0)
+        {
+            AsyncResult res;
+            target.uid = res.uid();
+        }
+        sData->targets.push_back(target);
+
+        // The batch is full, send it now.
+        if (sData->targets.size() >= batch_max_writes)
+            sData->hold_ms = 0;
+    }
+
+    // The result of the write at index is the element of writeResults and status arrays of the batch write response.
+    static void batchWriteResult(AsyncResult &aResult, int index)
+    {
+        String writeResult, status, message;
+        if (!BatchWriter::getResult(aResult.val[ares_ns::data_payload], index, writeResult, status))
+            return;
+
+        JSONUtil jut;
+        String payload;
+        jut.addObject(payload, "writeResult", writeResult, false);
+        jut.addObject(payload, "status", status, false, true);
+        aResult.val[ares_ns::data_payload] = payload;
+
+        // The write was failed.
+        int code = BatchWriter::getStatus(status, message);
+        if (code != 0)
+            aResult.lastError.setLastError(BatchWriter::toHttpCode(code), message);
+    }
+
     AsyncResult *eximDocs(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Parent &parent, const EximDocumentOptions &eximOptions, bool isImport, bool async)
     {
         Firestore::DataOptions options;
@@ -186,6 +296,17 @@ protected:
         uut.addParam(options.extras, "documentId", options.documentId, hasQueryParams, true);
         options.extras += mask.getQuery("mask", hasQueryParams);
         req_data aReq(&aClient, reqns::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+
+        // The document with the documentId can be created with the batch write when the mask was not set.
+        if (batch_writes && documentId.length() && strlen(mask.c_str()) == 0)
+        {
+            Document<Values::Value> doc = document;
+            doc.setName(collectionId + "/" + documentId);
+            Precondition currentDocument;
+            currentDocument.exists(false);
+            aReq.write = Write(DocumentMask(), doc, currentDocument).c_str();
+        }
+
         asyncRequest(aReq);
         return aClient.getResult();
     }
@@ -199,6 +320,14 @@ protected:
         sut.printTo(options.extras, documentPath.length() + strlen(patchOptions.c_str()), "/documents/%s%s", documentPath.c_str(), patchOptions.c_str());
 
         req_data aReq(&aClient, reqns::http_patch, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+
+        if (batch_writes && !patchOptions.read_mask)
+        {
+            Document<Values::Value> doc = document;
+            doc.setName(documentPath);
+            aReq.write = Write(patchOptions.update_mask, doc, patchOptions.current_document).c_str();
+        }
+
         asyncRequest(aReq);
         return aClient.getResult();
     }
@@ -286,7 +415,7 @@ protected:
     }
 
 #if defined(ENABLE_FIRESTORE_QUERY)
-    AsyncResult *runQueryImpl(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Parent &parent, const String &documentPath, const QueryOptions &queryOptions, bool async)
+    AsyncResult *runQueryImpl(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Parent &parent, const String &documentPath, const QueryOptions &queryOptions, bool async, FirestoreDocumentCallback docCb = NULL)
     {
         Firestore::DataOptions options;
         options.requestType = cf_run_query;
@@ -296,6 +425,7 @@ protected:
         sut.printTo(options.extras, documentPath.length(), "/documents/%s:runQuery", documentPath.c_str());
 
         req_data aReq(&aClient, reqns::http_post, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+        aReq.doc_cb = docCb;
         asyncRequest(aReq);
         return aClient.getResult();
     }
@@ -311,11 +441,15 @@ protected:
         sut.printTo(options.extras, strlen(qr) + documentPath.length(), "/documents/%s%s", documentPath.c_str(), qr);
 
         req_data aReq(&aClient, reqns::http_delete, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+
+        if (batch_writes)
+            aReq.write = Write(documentPath, currentDocument).c_str();
+
         asyncRequest(aReq);
         return aClient.getResult();
     }
 
-    AsyncResult *listDocs(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, bool async)
+    AsyncResult *listDocs(AsyncClientClass &aClient, AsyncResult *result, AsyncResultCallback cb, const String &uid, const Parent &parent, const String &collectionId, const ListDocumentsOptions &listDocsOptions, bool async, FirestoreDocumentCallback docCb = NULL)
     {
         Firestore::DataOptions options;
         options.requestType = cf_list_doc;
@@ -323,6 +457,7 @@ protected:
         sut.printTo(options.extras, collectionId.length() + strlen(listDocsOptions.c_str()), "/documents/%s%s", collectionId.c_str(), listDocsOptions.c_str());
 
         req_data aReq(&aClient, reqns::http_get, slot_options_t(false, false, async, false, false, false), &options, result, cb, uid);
+        aReq.doc_cb = docCb;
         asyncRequest(aReq);
         return aClient.getResult();
     }
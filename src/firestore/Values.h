@@ -50,6 +50,14 @@ const struct firebase_firestore_const_key_t firestore_const_key[firestore_const_
  */
 namespace Values
 {
+    // Print the {"key":value} object without building its string.
+    inline size_t printVal(Print &p, const String &value, const char *key)
+    {
+        if (value.length() == 0)
+            return 0;
+        return p.print("{\"") + p.print(key) + p.print("\":") + p.print(value.c_str()) + p.print('}');
+    }
+
     class NullValue : public Printable
     {
     private:
@@ -329,7 +337,6 @@ namespace Values
         {
             memset(flags, 0, 11);
             set(value);
-            getVal();
         }
 
         /**
@@ -343,12 +350,11 @@ namespace Values
                 set(value);
             else
                 owriter.addMember(buf, value.val(), false, "]}");
-            getVal();
             return *this;
         }
         const char *c_str() const { return buf.c_str(); }
         const char *val() { return getVal(); }
-        size_t printTo(Print &p) const override { return p.print(str.c_str()); }
+        size_t printTo(Print &p) const override { return printVal(p, buf, firestore_const_key[firestore_const_key_arrayValue].text); }
         void clear()
         {
             sut.clear(buf);
@@ -392,11 +398,7 @@ namespace Values
          * @param value The value.
          */
         template <typename T>
-        explicit MapValue(const String &key, T value)
-        {
-            set(key, value);
-            getVal();
-        }
+        explicit MapValue(const String &key, T value) { set(key, value); }
         template <typename T>
         MapValue &add(const String &key, T value)
         {
@@ -404,12 +406,11 @@ namespace Values
                 set(key, value);
             else
                 owriter.addMember(buf, MAP(key, value, true).c_str(), false);
-            getVal();
             return *this;
         }
         const char *c_str() const { return buf.c_str(); }
         const char *val() { return getVal(); }
-        size_t printTo(Print &p) const override { return p.print(str.c_str()); }
+        size_t printTo(Print &p) const override { return printVal(p, buf, firestore_const_key[firestore_const_key_mapValue].text); }
         void clear()
         {
             sut.clear(buf);
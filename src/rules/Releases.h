@@ -23,7 +23,6 @@ class Release : public BaseO4
 {
 private:
     ObjectWriter owriter;
-    BufWriter wr;
     JSONUtil jut;
 
 public:
@@ -50,8 +49,6 @@ public:
      * The Ruleset must exist for the Release to be created.
      */
     void rulesetId(const String &rulesetId) { wr.set<Release &, String>(*this, rulesetId.indexOf("projects/") == -1 && rulesetId.indexOf("/rulesets/") == -1 ? "projects/<projectId>/rulesets/" + rulesetId : "projects/<projectId>/rulesets/" + rulesetId.substring(rulesetId.indexOf("/rulesets/") + 10, rulesetId.length()), buf, bufSize, 2, "rulesetName"); }
-    const char *c_str() const { return buf[0].c_str(); }
-    void clear() { owriter.clearBuf(buf, bufSize); }
 };
 
 /**
@@ -123,10 +120,10 @@ private:
         if (request.cb)
             sData->cb = request.cb;
 
-        addRemoveClientVecBase(request.aClient, reinterpret_cast<uint32_t>(&(cVec)), true);
+        addRemoveClientVecBase(request.aClient, &cVec, true);
 
         if (request.aResult)
-            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(getRVec(request.aClient))));
+            sData->setRefResult(request.aResult);
 
         processBase(request.aClient, sData->async);
         handleRemoveBase(request.aClient);
@@ -21,7 +21,6 @@ class Ruleset : public BaseO4
 {
 private:
     ObjectWriter owriter;
-    BufWriter wr;
     JSONUtil jut;
 
 public:
@@ -33,8 +32,6 @@ public:
     }
     void source(const Rules::Source &source) { wr.set<Ruleset &, Rules::Source>(*this, source, buf, bufSize, 1, __func__); }
     void attachmentPoint(const String &attachment_point) { wr.set<Ruleset &, String>(*this, attachment_point, buf, bufSize, 2, "attachment_point"); }
-    const char *c_str() const { return buf[0].c_str(); }
-    void clear() { owriter.clearBuf(buf, bufSize); }
 };
 
 class RuleSets : public AppBase
@@ -102,10 +99,10 @@ private:
         if (request.cb)
             sData->cb = request.cb;
 
-        addRemoveClientVecBase(request.aClient, reinterpret_cast<uint32_t>(&(cVec)), true);
+        addRemoveClientVecBase(request.aClient, &cVec, true);
 
         if (request.aResult)
-            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(getRVec(request.aClient))));
+            sData->setRefResult(request.aResult);
 
         processBase(request.aClient, sData->async);
         handleRemoveBase(request.aClient);
@@ -24,7 +24,13 @@ namespace Rules
         ObjectWriter owriter;
         Base64Util but;
         Memory mem;
-        String toBase64(const String &str) { return but.encodeToChars(mem, (uint8_t *)str.c_str(), str.length()); }
+        String toBase64(const String &str)
+        {
+            char *buf = but.encodeToChars(mem, (uint8_t *)str.c_str(), str.length());
+            String out = buf;
+            mem.release(&buf);
+            return out;
+        }
 
     public:
         File() {}
@@ -50,8 +56,6 @@ namespace Rules
          * Don't provide the base64 encoded fingerprint as it will encode automatically.
         */
         void fingerprint(const String &fingerprint) { wr.set<File &, const char *>(*this, toBase64(fingerprint).c_str(), buf, bufSize, 3, __func__); }
-        const char *c_str() const { return buf[0].c_str(); }
-        void clear() { owriter.clearBuf(buf, bufSize); }
     };
 
     /**
@@ -61,7 +65,6 @@ namespace Rules
     {
     private:
         ObjectWriter owriter;
-        BufWriter wr;
         JSONUtil jut;
 
     public:
@@ -72,8 +75,6 @@ namespace Rules
          * File containing source content.
         */
         void files(const File &file) { wr.append<Source &, File>(*this, file, buf, bufSize, 1, __func__); }
-        const char *c_str() const { return buf[0].c_str(); }
-        void clear() { owriter.clearBuf(buf, bufSize); }
     };
 }
 #endif
@@ -282,7 +282,7 @@ public:
      * Set Arduino OTA Storage.
      *  @param storage The Arduino  OTAStorage class object.
      */
-    void setOTAStorage(OTAStorage &storage) { ota_storage_addr = reinterpret_cast<uint32_t>(&storage); }
+    void setOTAStorage(OTAStorage &storage) { ota_storage_addr = reinterpret_cast<uintptr_t>(&storage); }
 #endif
 
 private:
@@ -345,12 +345,18 @@ private:
 
         setFileStatus(sData, request);
 
+        if (sData->download && request.options->parent.getHashType() != hash_none)
+            sData->request.hash.begin(request.options->parent.getHashType(), request.options->parent.getHash());
+
+        if (sData->download)
+            sData->request.resume.setPolicy(request.options->parent.getResumeRetry(), request.options->parent.getResumeInterval());
+
         if (request.opt.ota)
         {
             sData->request.ota = true;
             sData->request.base64 = false;
             sData->aResult.download_data.ota = true;
-            sData->request.ul_dl_task_running_addr = ul_dl_task_running_addr;
+            sData->request.ul_dl_task_running = ulDlTaskRunning();
             sData->request.ota_storage_addr = ota_storage_addr;
             sData->request.command = request.command;
         }
@@ -378,10 +384,10 @@ private:
         if (request.cb)
             sData->cb = request.cb;
 
-        request.aClient->addRemoveClientVec(reinterpret_cast<uint32_t>(&(cVec)), true);
+        request.aClient->addRemoveClientVec(&cVec, true);
 
         if (request.aResult)
-            sData->setRefResult(request.aResult, reinterpret_cast<uint32_t>(&(request.aClient->getResultList())));
+            sData->setRefResult(request.aResult);
 
         request.aClient->process(sData->async);
         request.aClient->handleRemove();